@@ -1,5 +1,14 @@
 #include <iostream>
 #include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 using namespace std;
 
@@ -8,1245 +17,9520 @@ using namespace std;
 // ============================================
 
 // Convierte todo el texto a min�sculas (m�s seguro para validaciones)
+// Una sola pasada: se detiene en el '\0' sin recalcular la longitud
 void convertirMinusculas(char* texto) {
-    for (int i = 0; i < strlen(texto); i++) {
-        if (texto[i] >= 'A' && texto[i] <= 'Z') {
-            texto[i] = texto[i] + 32;
+    for (; *texto != '\0'; texto++) {
+        if (*texto >= 'A' && *texto <= 'Z') {
+            *texto = *texto + 32;
         }
     }
 }
 
-// Valida si un estado es v�lido (todo en min�sculas)
-bool esEstadoValido(const char* estado) {
-    char temp[20];
-    strncpy(temp, estado, 19);
-    temp[19] = '\0';
-    convertirMinusculas(temp);
-    
-    return (strcmp(temp, "listo") == 0 || 
-            strcmp(temp, "ejecutando") == 0 || 
-            strcmp(temp, "terminado") == 0);
+// Tamaños de memoria en bytes (64 bits)
+const unsigned long long BYTES_KB = 1024ULL;
+const unsigned long long BYTES_MB = 1024ULL * 1024;
+const unsigned long long BYTES_GB = 1024ULL * 1024 * 1024;
+const unsigned long long SIN_DIRECCION = ~0ULL;
+
+// Convierte "512", "64KB", "100b", "2G"... a bytes; sin sufijo se usa
+// unidadPorDefecto. Retorna false si el texto no es un tamaño valido.
+bool leerTamanio(const char* texto, unsigned long long& bytes, unsigned long long unidadPorDefecto) {
+    if (texto == NULL || *texto < '0' || *texto > '9') return false;
+    unsigned long long valor = 0;
+    for (; *texto >= '0' && *texto <= '9'; texto++) {
+        if (valor > (~0ULL - 9) / 10) return false;
+        valor = valor * 10 + (unsigned long long)(*texto - '0');
+    }
+    unsigned long long unidad = unidadPorDefecto;
+    char sufijo = (*texto >= 'a' && *texto <= 'z') ? (char)(*texto - 32) : *texto;
+    if (sufijo != '\0') {
+        if (sufijo == 'B') unidad = 1;
+        else if (sufijo == 'K') unidad = BYTES_KB;
+        else if (sufijo == 'M') unidad = BYTES_MB;
+        else if (sufijo == 'G') unidad = BYTES_GB;
+        else return false;
+        texto++;
+        if (unidad != 1 && (*texto == 'B' || *texto == 'b')) texto++;
+        if (*texto != '\0') return false;
+    }
+    if (valor > ~0ULL / unidad) return false;
+    bytes = valor * unidad;
+    return true;
+}
+
+// Escribe el tamaño con la mayor unidad que lo deja en al menos 1
+// (p. ej. "512 MB", "1.5 KB", "100 B"); retorna el buffer
+const char* formatearTamanio(unsigned long long bytes, char* buffer) {
+    const char* nombres[] = {"B", "KB", "MB", "GB"};
+    unsigned long long unidades[] = {1, BYTES_KB, BYTES_MB, BYTES_GB};
+    int u = 3;
+    while (u > 0 && bytes < unidades[u]) u--;
+    if (bytes % unidades[u] == 0) sprintf(buffer, "%llu %s", bytes / unidades[u], nombres[u]);
+    else sprintf(buffer, "%.1f %s", (double)bytes / unidades[u], nombres[u]);
+    return buffer;
 }
 
 // ============================================
-// ESTRUCTURA: PROCESO
+// MAQUINA DE ESTADOS DE LOS PROCESOS
+// La tabla guarda el estado como un byte; el texto solo se usa
+// al leer la entrada del usuario y al mostrar. Las transiciones
+// permitidas estan en una tabla de bits fija en compilacion:
+//
+//   nuevo -> listo -> ejecutando -> terminado
+//              ^          |
+//              |          v
+//              +------ bloqueado   (ejecutando -> listo: expropiacion)
 // ============================================
-struct Proceso {
-    int id;
-    char nombre[50];
-    int prioridad;
-    char estado[20];
-    Proceso* siguiente;
+enum EstadoProceso {
+    ESTADO_NUEVO = 0,
+    ESTADO_LISTO = 1,
+    ESTADO_EJECUTANDO = 2,
+    ESTADO_BLOQUEADO = 3,
+    ESTADO_TERMINADO = 4,
+    CANTIDAD_ESTADOS = 5,
+    ESTADO_INVALIDO = 0xFF
+};
 
-    Proceso(int _id, const char* _nombre, int _prioridad, const char* _estado) {
-        id = _id;
-        strncpy(nombre, _nombre, 49);
-        nombre[49] = '\0';
-        prioridad = _prioridad;
-        strncpy(estado, _estado, 19);
-        estado[19] = '\0';
-        siguiente = NULL;
-    }
+const char* const NOMBRES_ESTADO[CANTIDAD_ESTADOS] = {
+    "nuevo", "listo", "ejecutando", "bloqueado", "terminado"
+};
+
+// Bit j de TRANSICIONES[i] encendido: se permite pasar del estado i al j
+constexpr unsigned char bitEstado(int e) {
+    return (unsigned char)(1u << e);
+}
+
+constexpr unsigned char TRANSICIONES[CANTIDAD_ESTADOS] = {
+    bitEstado(ESTADO_LISTO),                                    // nuevo
+    bitEstado(ESTADO_EJECUTANDO),                               // listo
+    bitEstado(ESTADO_LISTO) | bitEstado(ESTADO_BLOQUEADO) |
+        bitEstado(ESTADO_TERMINADO),                            // ejecutando
+    bitEstado(ESTADO_LISTO),                                    // bloqueado
+    0                                                           // terminado
 };
 
+// Quedarse en el mismo estado no es una transicion y siempre se acepta.
+// Un codigo fuera de rango (p. ej. ESTADO_INVALIDO) nunca es valido.
+constexpr bool transicionPermitida(unsigned char desde, unsigned char hacia) {
+    return desde < CANTIDAD_ESTADOS && hacia < CANTIDAD_ESTADOS &&
+           (desde == hacia || ((TRANSICIONES[desde] >> hacia) & 1) != 0);
+}
+
+static_assert(!transicionPermitida(ESTADO_TERMINADO, ESTADO_EJECUTANDO),
+              "un proceso terminado no puede volver a ejecutarse");
+static_assert(!transicionPermitida(ESTADO_NUEVO, ESTADO_EJECUTANDO),
+              "un proceso nuevo debe pasar por la cola de listos");
+static_assert(!transicionPermitida(ESTADO_LISTO, ESTADO_INVALIDO),
+              "los codigos fuera de rango se rechazan");
+
+// Convierte el texto de un estado (sin importar mayusculas) en su codigo.
+// Compara en el lugar, sin copiar: los nombres solo tienen letras minusculas.
+unsigned char codificarEstado(const char* estado) {
+    for (int e = 0; e < CANTIDAD_ESTADOS; e++) {
+        const char* a = estado;
+        const char* b = NOMBRES_ESTADO[e];
+        while (*b != '\0' && (*a | 0x20) == *b) {
+            a++;
+            b++;
+        }
+        if (*b == '\0' && *a == '\0') return (unsigned char)e;
+    }
+    return ESTADO_INVALIDO;
+}
+
+// Valida si un estado es v�lido (sin importar may�sculas)
+bool esEstadoValido(const char* estado) {
+    return codificarEstado(estado) != ESTADO_INVALIDO;
+}
+
 // ============================================
-// CLASE: GESTOR DE PROCESOS
+// CLASE: TABLA DE NOMBRES INTERNADOS
+// Cada nombre distinto se guarda una sola vez en un arreglo de
+// caracteres; la tabla de procesos solo guarda su desplazamiento.
+// Los nombres no se liberan: el costo es proporcional a los
+// nombres distintos, no a los procesos creados.
 // ============================================
-class GestorProcesos {
+class TablaNombres {
 private:
-    Proceso* cabeza;
-    int contadorID;
+    static const unsigned int SIN_NOMBRE = 0xFFFFFFFFu;
 
-    // Reorganiza IDs consecutivamente
-    void reorganizarIDs() {
-        int cantidad = contarProcesos();
-        if (cantidad == 0) {
-            contadorID = 1;
-            return;
+    char* caracteres;           // Nombres terminados en '\0', uno tras otro
+    unsigned int usados;
+    unsigned int capacidadCaracteres;
+
+    unsigned int* casillas;     // Hash abierto: desplazamiento de cada nombre
+    unsigned int capacidadCasillas;     // Siempre potencia de 2
+    unsigned int cantidad;
+
+    // Hash FNV-1a del texto
+    static unsigned int hashTexto(const char* texto) {
+        unsigned int h = 2166136261u;
+        for (; *texto != '\0'; texto++) {
+            h = (h ^ (unsigned char)*texto) * 16777619u;
         }
+        return h;
+    }
 
-        Proceso** arreglo = crearArregloProcesos(cantidad);
-        ordenarArregloPorID(arreglo, cantidad);
-        
-        // Asignar IDs consecutivos
-        for (int i = 0; i < cantidad; i++) {
-            arreglo[i]->id = i + 1;
+    void crecerCasillas() {
+        unsigned int* anteriores = casillas;
+        unsigned int capacidadAnterior = capacidadCasillas;
+        capacidadCasillas = (capacidadCasillas == 0) ? 64 : capacidadCasillas * 2;
+        casillas = new unsigned int[capacidadCasillas];
+        for (unsigned int i = 0; i < capacidadCasillas; i++) casillas[i] = SIN_NOMBRE;
+        for (unsigned int i = 0; i < capacidadAnterior; i++) {
+            if (anteriores[i] == SIN_NOMBRE) continue;
+            unsigned int j = hashTexto(caracteres + anteriores[i]) & (capacidadCasillas - 1);
+            while (casillas[j] != SIN_NOMBRE) j = (j + 1) & (capacidadCasillas - 1);
+            casillas[j] = anteriores[i];
         }
-        
-        contadorID = cantidad + 1;
-        delete[] arreglo;
+        delete[] anteriores;
     }
 
-    // Cuenta total de procesos en la lista
-    int contarProcesos() {
-        int cantidad = 0;
-        Proceso* temp = cabeza;
-        while (temp != NULL) {
-            cantidad++;
-            temp = temp->siguiente;
+public:
+    TablaNombres() {
+        caracteres = NULL;
+        usados = 0;
+        capacidadCaracteres = 0;
+        casillas = NULL;
+        capacidadCasillas = 0;
+        cantidad = 0;
+        crecerCasillas();
+    }
+
+    // Retorna el handle del nombre (truncado a 49 caracteres),
+    // agregandolo solo si no se habia visto antes
+    unsigned int internar(const char* nombre) {
+        char texto[50];
+        strncpy(texto, nombre, 49);
+        texto[49] = '\0';
+
+        unsigned int i = hashTexto(texto) & (capacidadCasillas - 1);
+        while (casillas[i] != SIN_NOMBRE) {
+            if (strcmp(caracteres + casillas[i], texto) == 0) return casillas[i];
+            i = (i + 1) & (capacidadCasillas - 1);
+        }
+
+        unsigned int largo = (unsigned int)strlen(texto) + 1;
+        if (usados + largo > capacidadCaracteres) {
+            unsigned int nuevaCapacidad = (capacidadCaracteres == 0) ? 1024 : capacidadCaracteres * 2;
+            char* nuevos = new char[nuevaCapacidad];
+            if (usados > 0) memcpy(nuevos, caracteres, usados);
+            delete[] caracteres;
+            caracteres = nuevos;
+            capacidadCaracteres = nuevaCapacidad;
         }
+        unsigned int desplazamiento = usados;
+        memcpy(caracteres + usados, texto, largo);
+        usados += largo;
+
+        casillas[i] = desplazamiento;
+        cantidad++;
+        // Factor de carga <= 0.5 (crecer rehace todas las posiciones)
+        if (cantidad * 2 > capacidadCasillas) crecerCasillas();
+        return desplazamiento;
+    }
+
+    // Texto de un handle; valido hasta el siguiente internar
+    const char* texto(unsigned int handle) const {
+        return caracteres + handle;
+    }
+
+    unsigned int cantidadNombres() const {
         return cantidad;
     }
 
-    // Crea un arreglo din�mico con todos los procesos
-    Proceso** crearArregloProcesos(int cantidad) {
-        Proceso** arreglo = new Proceso*[cantidad];
-        Proceso* temp = cabeza;
-        for (int i = 0; i < cantidad; i++) {
-            arreglo[i] = temp;
-            temp = temp->siguiente;
-        }
-        return arreglo;
+    unsigned int bytesUsados() const {
+        return usados;
     }
 
-    // Ordena el arreglo por ID usando burbuja
-    void ordenarArregloPorID(Proceso** arreglo, int cantidad) {
-        for (int i = 0; i < cantidad - 1; i++) {
-            for (int j = 0; j < cantidad - i - 1; j++) {
-                if (arreglo[j]->id > arreglo[j + 1]->id) {
-                    Proceso* aux = arreglo[j];
-                    arreglo[j] = arreglo[j + 1];
-                    arreglo[j + 1] = aux;
-                }
-            }
-        }
+    ~TablaNombres() {
+        delete[] caracteres;
+        delete[] casillas;
     }
+};
+
+class TablaProcesos;
+
+// ============================================
+// CLASE: PROCESO (VISTA DE UNA FILA)
+// Los datos de cada proceso viven en columnas separadas de
+// TablaProcesos; un Proceso es solo (tabla, posicion) y lee cada
+// campo de su columna. Solo es valido hasta la siguiente insercion
+// o eliminacion: para guardar una referencia use HandleProceso.
+// ============================================
+class Proceso {
+private:
+    const TablaProcesos* tabla;     // NULL: el proceso no existe
+    unsigned int posicion;
 
 public:
-    GestorProcesos() {
-        cabeza = NULL;
-        contadorID = 1;
+    Proceso() {
+        tabla = NULL;
+        posicion = 0;
     }
 
-    // Inserta proceso con estado inicial "listo"
-    void insertar(const char* nombre, int prioridad) {
-        Proceso* nuevo = new Proceso(contadorID++, nombre, prioridad, "listo");
-        nuevo->siguiente = cabeza;
-        cabeza = nuevo;
-        cout << "Proceso creado con ID: " << nuevo->id << " (estado: listo)" << endl;
+    Proceso(const TablaProcesos* _tabla, unsigned int _posicion) {
+        tabla = _tabla;
+        posicion = _posicion;
     }
 
-    // Muestra procesos ordenados en tabla
-    void mostrar() {
-        if (cabeza == NULL) {
-            cout << "\n*** No hay procesos en el sistema ***\n";
-            return;
-        }
+    bool existe() const {
+        return tabla != NULL;
+    }
 
-        int cantidad = contarProcesos();
-        Proceso** arreglo = crearArregloProcesos(cantidad);
-        ordenarArregloPorID(arreglo, cantidad);
+    inline int id() const;
+    inline const char* nombre() const;
+    inline int prioridad() const;
+    inline unsigned char codigoEstado() const;
 
-        cout << "\n=============== LISTA DE PROCESOS ===============\n";
-        cout << "ID    Nombre                  Prioridad    Estado\n";
-        cout << "=================================================\n";
-        
-        for (int i = 0; i < cantidad; i++) {
-            char buffer[100];
-            sprintf(buffer, "%-6d%-24s%-13d%s", 
-                    arreglo[i]->id, 
-                    arreglo[i]->nombre, 
-                    arreglo[i]->prioridad, 
-                    arreglo[i]->estado);
-            cout << buffer << endl;
-        }
-        cout << "=================================================\n";
+    const char* estado() const {
+        return NOMBRES_ESTADO[codigoEstado()];
+    }
+};
 
-        delete[] arreglo;
+// ============================================
+// ESTRUCTURA: HANDLE DE PROCESO
+// Referencia estable a un proceso: indice de ranura + generacion.
+// Si el proceso se elimina, la generacion de la ranura cambia y
+// todos los handles antiguos quedan detectados como obsoletos.
+// ============================================
+struct HandleProceso {
+    unsigned int indice;
+    unsigned int generacion;    // 0 nunca es una generacion valida
+
+    bool esNulo() const {
+        return generacion == 0;
     }
 
-    // Busca proceso por ID
-    Proceso* buscar(int id) {
-        Proceso* actual = cabeza;
-        while (actual != NULL) {
-            if (actual->id == id) return actual;
-            actual = actual->siguiente;
-        }
-        return NULL;
+    bool operator==(const HandleProceso& otro) const {
+        return indice == otro.indice && generacion == otro.generacion;
     }
 
-    // Muestra ficha detallada del proceso
-    void mostrarFicha(Proceso* proc) {
-        cout << "\n+================================================+\n";
-        cout << "|            INFORMACION DEL PROCESO             |\n";
-        cout << "+================================================+\n";
-        cout << "| ID:              " << proc->id << endl;
-        cout << "| Nombre:          " << proc->nombre << endl;
-        cout << "| Prioridad:       " << proc->prioridad << " (escala 1-10)" << endl;
-        cout << "| Estado:          " << proc->estado << endl;
-        cout << "+================================================+\n";
+    bool operator!=(const HandleProceso& otro) const {
+        return !(*this == otro);
     }
+};
 
-    // Elimina proceso con confirmaci�n
-    void eliminar(int id) {
-        if (cabeza == NULL) {
-            cout << "Error: No hay procesos para eliminar.\n";
-            return;
-        }
+const HandleProceso HANDLE_NULO = {0, 0};
 
-        Proceso* proc = buscar(id);
-        if (proc == NULL) {
-            cout << "Error: No se encontro un proceso con ID " << id << endl;
-            return;
-        }
+// ============================================
+// CLASE: TABLA DE PROCESOS (SLOT MAP COLUMNAR)
+// Los procesos viven en columnas densas paralelas (ID, prioridad,
+// estado de un byte y handle de nombre); cada ranura apunta a su
+// posicion en esas columnas. Buscar por handle es indexar dos
+// arreglos, eliminar mueve el ultimo proceso al hueco (O(1)), y los
+// recorridos que solo miran un campo leen un arreglo contiguo.
+// ============================================
+class TablaProcesos {
+private:
+    struct Ranura {
+        unsigned int generacion;    // Se incrementa cada vez que la ranura se libera
+        unsigned int posicion;      // Ocupada: indice denso. Libre: siguiente ranura libre
+        bool ocupada;
+    };
 
-        cout << "\nProceso a eliminar:\n";
-        cout << "  ID: " << proc->id << " | Nombre: " << proc->nombre 
-             << " | Prioridad: " << proc->prioridad << endl;
+    static const unsigned int SIN_RANURA = 0xFFFFFFFFu;
 
-        char respuesta[10];
-        bool respuestaValida = false;
-        
-        while (!respuestaValida) {
-            cout << "\nEsta seguro que desea eliminar este proceso? (s/n): ";
-            cin.getline(respuesta, 10);
-            convertirMinusculas(respuesta);
-            
-            if (strcmp(respuesta, "s") == 0 || strcmp(respuesta, "si") == 0) {
-                respuestaValida = true;
-                Proceso *actual = cabeza, *anterior = NULL;
-                
-                while (actual != NULL) {
-                    if (actual->id == id) {
-                        if (anterior != NULL)
-                            anterior->siguiente = actual->siguiente;
-                        else
-                            cabeza = actual->siguiente;
-                        
-                        cout << "\nProceso '" << actual->nombre << "' eliminado.\n";
-                        delete actual;
-                        reorganizarIDs();
-                        cout << "Los IDs han sido reorganizados.\n";
-                        return;
-                    }
-                    anterior = actual;
-                    actual = actual->siguiente;
-                }
-            } else if (strcmp(respuesta, "n") == 0 || strcmp(respuesta, "no") == 0) {
-                cout << "\nOperacion cancelada.\n";
-                return;
-            } else {
-                cout << "Respuesta invalida. Ingrese 's' o 'n'.\n";
-            }
-        }
+    Ranura* ranuras;
+    unsigned int cantidadRanuras;
+    unsigned int capacidadRanuras;
+    unsigned int primeraLibre;      // Lista enlazada de ranuras libres
+
+    // Columnas densas de procesos vivos (misma posicion = mismo proceso)
+    int* ids;
+    int* prioridades;
+    unsigned char* estados;         // Codigos de EstadoProceso
+    unsigned int* nombres;          // Handles en la tabla de nombres
+    unsigned int* ranuraDe;         // Ranura asociada a cada posicion densa
+    unsigned int cantidad;
+    unsigned int capacidad;
+
+    unsigned int porEstado[CANTIDAD_ESTADOS];   // Procesos vivos en cada estado
+
+    TablaNombres tablaNombres;
+
+    // Copia una columna a un arreglo nuevo de mayor capacidad
+    template <class T>
+    static void crecerColumna(T*& columna, unsigned int cantidad, unsigned int nuevaCapacidad) {
+        T* nueva = new T[nuevaCapacidad];
+        if (cantidad > 0) memcpy(nueva, columna, cantidad * sizeof(T));
+        delete[] columna;
+        columna = nueva;
     }
 
-    // Modifica prioridad
-    void modificarPrioridad(int id, int nuevaPrioridad) {
-        Proceso* proc = buscar(id);
-        if (proc != NULL) {
-            int prioridadAnterior = proc->prioridad;
-            proc->prioridad = nuevaPrioridad;
-            cout << "Prioridad actualizada de " << prioridadAnterior 
-                 << " a " << nuevaPrioridad << endl;
-        } else {
-            cout << "Error: No se encontro el proceso.\n";
+    void crecerDensos() {
+        unsigned int nuevaCapacidad = (capacidad == 0) ? 16 : capacidad * 2;
+        crecerColumna(ids, cantidad, nuevaCapacidad);
+        crecerColumna(prioridades, cantidad, nuevaCapacidad);
+        crecerColumna(estados, cantidad, nuevaCapacidad);
+        crecerColumna(nombres, cantidad, nuevaCapacidad);
+        crecerColumna(ranuraDe, cantidad, nuevaCapacidad);
+        capacidad = nuevaCapacidad;
+    }
+
+    void crecerRanuras() {
+        unsigned int nuevaCapacidad = (capacidadRanuras == 0) ? 16 : capacidadRanuras * 2;
+        Ranura* nuevas = new Ranura[nuevaCapacidad];
+        for (unsigned int i = 0; i < cantidadRanuras; i++) {
+            nuevas[i] = ranuras[i];
         }
+        delete[] ranuras;
+        ranuras = nuevas;
+        capacidadRanuras = nuevaCapacidad;
     }
 
-    // Cambia estado (todo en min�sculas)
-    void cambiarEstado(int id, const char* nuevoEstado) {
-        Proceso* proc = buscar(id);
-        if (proc != NULL) {
-            char estadoAnterior[20];
-            strcpy(estadoAnterior, proc->estado);
-            
-            char estadoNormalizado[20];
-            strncpy(estadoNormalizado, nuevoEstado, 19);
-            estadoNormalizado[19] = '\0';
-            convertirMinusculas(estadoNormalizado);
-            
-            strncpy(proc->estado, estadoNormalizado, 19);
-            proc->estado[19] = '\0';
-            
-            cout << "Estado actualizado de '" << estadoAnterior 
-                 << "' a '" << estadoNormalizado << "'\n";
+public:
+    TablaProcesos() {
+        ranuras = NULL;
+        cantidadRanuras = 0;
+        capacidadRanuras = 0;
+        primeraLibre = SIN_RANURA;
+        ids = NULL;
+        prioridades = NULL;
+        estados = NULL;
+        nombres = NULL;
+        ranuraDe = NULL;
+        cantidad = 0;
+        capacidad = 0;
+        for (int e = 0; e < CANTIDAD_ESTADOS; e++) porEstado[e] = 0;
+    }
+
+    // Agrega un proceso y retorna su handle
+    HandleProceso insertar(int id, const char* nombre, int prioridad, unsigned char estado) {
+        if (cantidad == capacidad) crecerDensos();
+
+        unsigned int r;
+        if (primeraLibre != SIN_RANURA) {
+            r = primeraLibre;
+            primeraLibre = ranuras[r].posicion;
         } else {
-            cout << "Error: No se encontro el proceso.\n";
+            if (cantidadRanuras == capacidadRanuras) crecerRanuras();
+            r = cantidadRanuras++;
+            ranuras[r].generacion = 1;
         }
+
+        ids[cantidad] = id;
+        prioridades[cantidad] = prioridad;
+        estados[cantidad] = estado;
+        nombres[cantidad] = tablaNombres.internar(nombre);
+        porEstado[estado]++;
+        ranuraDe[cantidad] = r;
+        ranuras[r].posicion = cantidad;
+        ranuras[r].ocupada = true;
+        cantidad++;
+
+        HandleProceso h;
+        h.indice = r;
+        h.generacion = ranuras[r].generacion;
+        return h;
     }
 
-    // Retorna array de procesos ordenado (para uso externo)
-    Proceso** obtenerArregloProcesos(int& cantidad) {
-        cantidad = contarProcesos();
-        if (cantidad == 0) return NULL;
-        
-        Proceso** arreglo = crearArregloProcesos(cantidad);
-        ordenarArregloPorID(arreglo, cantidad);
-        return arreglo;
+    // Verifica que el handle apunte a un proceso vivo
+    bool esValido(HandleProceso h) const {
+        return h.indice < cantidadRanuras &&
+               ranuras[h.indice].ocupada &&
+               ranuras[h.indice].generacion == h.generacion;
     }
 
-    bool estaVacia() {
-        return cabeza == NULL;
+    // Retorna la vista del proceso (inexistente si el handle es obsoleto).
+    // La vista solo es valida hasta la siguiente insercion o eliminacion.
+    Proceso obtener(HandleProceso h) const {
+        if (!esValido(h)) return Proceso();
+        return Proceso(this, ranuras[h.indice].posicion);
     }
 
-    Proceso* obtenerCabeza() {
-        return cabeza;
+    bool fijarPrioridad(HandleProceso h, int prioridad) {
+        if (!esValido(h)) return false;
+        prioridades[ranuras[h.indice].posicion] = prioridad;
+        return true;
     }
 
-    ~GestorProcesos() {
-        Proceso* actual = cabeza;
-        while (actual != NULL) {
-            Proceso* temp = actual;
-            actual = actual->siguiente;
-            delete temp;
+    // Cambia el estado si la maquina de estados lo permite;
+    // false si el handle es obsoleto o la transicion es ilegal
+    bool transicionar(HandleProceso h, unsigned char estado) {
+        if (!esValido(h)) return false;
+        unsigned char& actual = estados[ranuras[h.indice].posicion];
+        if (!transicionPermitida(actual, estado)) return false;
+        porEstado[actual]--;
+        porEstado[estado]++;
+        actual = estado;
+        return true;
+    }
+
+    // Elimina el proceso: el ultimo de cada columna ocupa su lugar
+    bool eliminar(HandleProceso h) {
+        if (!esValido(h)) return false;
+
+        unsigned int r = h.indice;
+        unsigned int pos = ranuras[r].posicion;
+        unsigned int ultima = cantidad - 1;
+        porEstado[estados[pos]]--;
+        if (pos != ultima) {
+            ids[pos] = ids[ultima];
+            prioridades[pos] = prioridades[ultima];
+            estados[pos] = estados[ultima];
+            nombres[pos] = nombres[ultima];
+            ranuraDe[pos] = ranuraDe[ultima];
+            ranuras[ranuraDe[pos]].posicion = pos;
         }
+        cantidad--;
+
+        ranuras[r].ocupada = false;
+        ranuras[r].generacion++;
+        if (ranuras[r].generacion == 0) ranuras[r].generacion = 1;
+        ranuras[r].posicion = primeraLibre;
+        primeraLibre = r;
+        return true;
+    }
+
+    unsigned int tamanio() const {
+        return cantidad;
+    }
+
+    // Contador mantenido en cada transicion (O(1))
+    unsigned int cantidadEnEstado(unsigned char estado) const {
+        return porEstado[estado];
+    }
+
+    // Cantidad de ranuras creadas (cota superior de HandleProceso::indice)
+    unsigned int totalRanuras() const {
+        return cantidadRanuras;
+    }
+
+    // Acceso por posicion densa (para recorridos secuenciales)
+    Proceso enPosicion(unsigned int i) const {
+        return Proceso(this, i);
+    }
+
+    HandleProceso handleEnPosicion(unsigned int i) const {
+        HandleProceso h;
+        h.indice = ranuraDe[i];
+        h.generacion = ranuras[h.indice].generacion;
+        return h;
+    }
+
+    // Columnas completas (tamanio() elementos) para recorridos por campo
+    const int* columnaIDs() const { return ids; }
+    const int* columnaPrioridades() const { return prioridades; }
+    const unsigned char* columnaEstados() const { return estados; }
+
+    int idEn(unsigned int i) const { return ids[i]; }
+    int prioridadEn(unsigned int i) const { return prioridades[i]; }
+    unsigned char estadoEn(unsigned int i) const { return estados[i]; }
+    const char* nombreEn(unsigned int i) const { return tablaNombres.texto(nombres[i]); }
+
+    const TablaNombres& nombresInternados() const {
+        return tablaNombres;
+    }
+
+    ~TablaProcesos() {
+        delete[] ranuras;
+        delete[] ids;
+        delete[] prioridades;
+        delete[] estados;
+        delete[] nombres;
+        delete[] ranuraDe;
     }
 };
+
+// Cada campo de la vista se lee de su columna
+inline int Proceso::id() const { return tabla->idEn(posicion); }
+inline const char* Proceso::nombre() const { return tabla->nombreEn(posicion); }
+inline int Proceso::prioridad() const { return tabla->prioridadEn(posicion); }
+inline unsigned char Proceso::codigoEstado() const { return tabla->estadoEn(posicion); }
+
 // ============================================
-// GESTOR DE MEMORIA: Implementación con estructura de pila (LIFO)
-// Permite asignar y liberar bloques de memoria para procesos
+// ESTRUCTURA: TABLA HASH POR ID
+// Tabla hash con direccionamiento abierto (sondeo lineal) que
+// asocia un ID de proceso con un valor en O(1). La usan el indice
+// de procesos y la contabilidad de memoria por proceso.
 // ============================================
-
-class GestorMemoria {
+template <class Valor>
+class TablaHashPorID {
 private:
-    // ============================================
-    // ESTRUCTURA BLOQUE DE MEMORIA
-    // Representa un bloque de memoria asignado a un proceso
-    // ============================================
-    struct BloqueMemoria {
-        int idProceso;              // ID único del proceso dueño del bloque
-        char nombreProceso[50];     // Nombre descriptivo del proceso
-        int tamanioMB;              // Tamaño del bloque en Megabytes
-        BloqueMemoria* siguiente;   // Puntero al siguiente bloque en la pila
-        
-        // ============================================
-        // CONSTRUCTOR DEL BLOQUE DE MEMORIA
-        // Inicializa un nuevo bloque con los datos del proceso
-        // ============================================
-        BloqueMemoria(int _id, const char* _nombre, int _tamanio) {
-            idProceso = _id;
-            // Copia segura del nombre del proceso
-            strncpy(nombreProceso, _nombre, 49);
-            nombreProceso[49] = '\0';  // Asegura terminación de cadena
-            tamanioMB = _tamanio;
-            siguiente = NULL;  // Inicialmente no apunta a ningún bloque
-        }
+    struct Entrada {
+        int id;             // 0 indica casilla vacia (los IDs empiezan en 1)
+        Valor valor;
     };
-    
-    // ============================================
-    // VARIABLES PRIVADAS DEL GESTOR
-    // ============================================
-    BloqueMemoria* tope;        // Puntero al último bloque asignado (top de la pila)
-    int memoriaTotal;           // Capacidad total del sistema en MB
-    int memoriaUsada;           // Memoria actualmente ocupada
-    
+
+    Entrada* tabla;
+    unsigned int capacidad;     // Siempre potencia de 2
+    unsigned int cantidad;
+
+    // Hash multiplicativo (Fibonacci) reducido a la capacidad
+    unsigned int posicionInicial(int id) const {
+        return ((unsigned int)id * 2654435769u) & (capacidad - 1);
+    }
+
+    // Duplica la tabla y reubica todas las entradas
+    void crecer() {
+        Entrada* anterior = tabla;
+        unsigned int capacidadAnterior = capacidad;
+
+        capacidad *= 2;
+        tabla = new Entrada[capacidad];
+        for (unsigned int i = 0; i < capacidad; i++) {
+            tabla[i].id = 0;
+        }
+        cantidad = 0;
+
+        for (unsigned int i = 0; i < capacidadAnterior; i++) {
+            if (anterior[i].id != 0) {
+                insertar(anterior[i].id, anterior[i].valor);
+            }
+        }
+        delete[] anterior;
+    }
+
 public:
-    // ============================================
-    // CONSTRUCTOR DEL GESTOR DE MEMORIA
-    // Inicializa el sistema con 2048 MB (2GB) de memoria total
-    // ============================================
-    GestorMemoria() {
-        tope = NULL;            // Pila vacía al inicio
-        memoriaTotal = 2048;    // 2 GB de memoria total del sistema
-        memoriaUsada = 0;       // Sin memoria usada inicialmente
-        cout << "[INFO] Gestor de Memoria inicializado (Memoria total: " 
-             << memoriaTotal << " MB)\n";
+    TablaHashPorID() {
+        capacidad = 16;
+        cantidad = 0;
+        tabla = new Entrada[capacidad];
+        for (unsigned int i = 0; i < capacidad; i++) {
+            tabla[i].id = 0;
+        }
     }
-    
-    // ============================================
-    // BUSCAR PROCESO EN LA MEMORIA
-    // Recorre la pila buscando un proceso por su ID
-    // Retorna el bloque si lo encuentra, NULL si no existe
-    // ============================================
-    BloqueMemoria* buscarProceso(int idProceso) {
-        BloqueMemoria* actual = tope;
-        // Recorre toda la pila desde el tope hasta el fondo
-        while (actual != NULL) {
-            if (actual->idProceso == idProceso) {
-                return actual;  // Encontrado
+
+    // Inserta o actualiza la entrada de un ID
+    void insertar(int id, const Valor& valor) {
+        // Mantener factor de carga <= 0.5 para sondeos cortos
+        if ((cantidad + 1) * 2 > capacidad) {
+            crecer();
+        }
+
+        unsigned int i = posicionInicial(id);
+        while (tabla[i].id != 0 && tabla[i].id != id) {
+            i = (i + 1) & (capacidad - 1);
+        }
+        if (tabla[i].id == 0) cantidad++;
+        tabla[i].id = id;
+        tabla[i].valor = valor;
+    }
+
+    // Retorna el valor asociado al ID o NULL si no existe.
+    // El puntero solo es valido hasta la siguiente insercion.
+    Valor* buscar(int id) const {
+        if (id <= 0) return NULL;
+        unsigned int i = posicionInicial(id);
+        while (tabla[i].id != 0) {
+            if (tabla[i].id == id) return &tabla[i].valor;
+            i = (i + 1) & (capacidad - 1);
+        }
+        return NULL;
+    }
+
+    // Elimina un ID usando desplazamiento hacia atras (sin lapidas)
+    void eliminar(int id) {
+        if (id <= 0) return;
+        unsigned int i = posicionInicial(id);
+        while (tabla[i].id != id) {
+            if (tabla[i].id == 0) return;   // No estaba en la tabla
+            i = (i + 1) & (capacidad - 1);
+        }
+
+        unsigned int hueco = i;
+        unsigned int j = i;
+        while (true) {
+            j = (j + 1) & (capacidad - 1);
+            if (tabla[j].id == 0) break;
+            // Mover la entrada j al hueco si su posicion ideal no esta entre hueco y j
+            unsigned int ideal = posicionInicial(tabla[j].id);
+            bool moverAlHueco = (hueco <= j) ? (ideal <= hueco || ideal > j)
+                                             : (ideal <= hueco && ideal > j);
+            if (moverAlHueco) {
+                tabla[hueco] = tabla[j];
+                hueco = j;
             }
-            actual = actual->siguiente;
         }
-        return NULL;  // No encontrado
+        tabla[hueco].id = 0;
+        cantidad--;
     }
-    
-    // ============================================
-    // ASIGNAR MEMORIA A UN PROCESO (OPERACIÓN PUSH)
-    // Agrega un nuevo bloque de memoria al tope de la pila
-    // ============================================
-    void asignarMemoria(int idProceso, const char* nombreProceso, int tamanioMB) {
-        // ============================================
-        // VERIFICAR SI EL PROCESO YA TIENE MEMORIA
-        // ============================================
-        BloqueMemoria* bloqueExistente = buscarProceso(idProceso);
-        
-        if (bloqueExistente != NULL) {
-            // El proceso ya tiene memoria asignada - ofrecer opciones
-            cout << "\n[AVISO] El proceso '" << nombreProceso 
-                 << "' ya tiene " << bloqueExistente->tamanioMB << " MB asignados.\n";
-            cout << "\nOpciones:\n";
-            cout << "1. Reemplazar (liberar " << bloqueExistente->tamanioMB 
-                 << " MB y asignar " << tamanioMB << " MB)\n";
-            cout << "2. Agregar bloque adicional (total: " 
-                 << (bloqueExistente->tamanioMB + tamanioMB) << " MB)\n";
-            cout << "3. Cancelar operacion\n";
-            cout << "Seleccione una opcion: ";
-            
-            int opcion;
-            cin >> opcion;
-            
-            // Validar entrada del usuario
-            if (cin.fail()) {
-                cin.clear();
-                cin.ignore(1000, '\n');
-                cout << "\n[ERROR] Opcion invalida. Operacion cancelada.\n";
-                return;
-            }
-            cin.ignore(1000, '\n');
-            
-            if (opcion == 1) {
-                // REEMPLAZAR: Liberar bloque anterior y asignar nuevo
-                liberarPorID(idProceso);
-                cout << "\n[INFO] Bloque anterior liberado. Asignando nuevo bloque...\n";
-            } else if (opcion == 2) {
-                // AGREGAR: Continuar con asignación normal (permite múltiples bloques)
-                cout << "\n[INFO] Agregando bloque adicional...\n";
-            } else {
-                cout << "\n[INFO] Operacion cancelada.\n";
+
+    unsigned int tamanio() const {
+        return cantidad;
+    }
+
+    ~TablaHashPorID() {
+        delete[] tabla;
+    }
+};
+
+// ============================================
+// ESTRUCTURA: INDICE HASH DE PROCESOS
+// Asocia cada ID con el handle de su proceso en O(1)
+// ============================================
+class IndiceProcesos {
+private:
+    TablaHashPorID<HandleProceso> tabla;
+
+public:
+    void insertar(int id, HandleProceso proc) {
+        tabla.insertar(id, proc);
+    }
+
+    // Retorna el handle asociado al ID o HANDLE_NULO si no existe
+    HandleProceso buscar(int id) const {
+        HandleProceso* h = tabla.buscar(id);
+        return (h == NULL) ? HANDLE_NULO : *h;
+    }
+
+    void eliminar(int id) {
+        tabla.eliminar(id);
+    }
+};
+
+// ============================================
+// INTERFAZ: OBSERVADOR DE PROCESOS
+// Permite que otros modulos (p. ej. el planificador) reaccionen
+// a cambios hechos desde el Gestor de Procesos
+// ============================================
+class ObservadorProcesos {
+public:
+    virtual void prioridadCambiada(HandleProceso h, int nuevaPrioridad) = 0;
+    // Se llama cuando el proceso ya salio de la tabla; h queda obsoleto
+    virtual void procesoEliminado(HandleProceso, int) {}
+    virtual ~ObservadorProcesos() {}
+};
+
+// ============================================
+// INTERFAZ: RESIDENCIA DE PROCESOS
+// El planificador pregunta antes de ejecutar si la memoria del
+// proceso esta cargada. Si no lo esta, quien la implementa inicia
+// la carga sin bloquear y el proceso sigue esperando en la cola.
+// Al terminar cada tick (cada llamada a ejecutarSiguiente) se avisa
+// con finDeTick, para que haga una cantidad acotada de trabajo de
+// fondo (p. ej. la compactacion incremental de la memoria).
+// ============================================
+class ResidenciaProcesos {
+public:
+    virtual bool prepararEjecucion(HandleProceso h) = 0;
+    virtual void finDeTick() {}
+    virtual ~ResidenciaProcesos() {}
+};
+
+// ============================================
+// MODOS DE ASIGNACION DE IDs
+// Los IDs nunca se renumeran: un ID identifica al mismo proceso
+// durante toda su vida (lo usan la memoria y el planificador)
+// ============================================
+enum ModoIDs {
+    IDS_MONOTONOS,      // Cada proceso nuevo recibe un ID nunca usado
+    IDS_RECICLADOS      // Los IDs liberados se reutilizan (pila LIFO)
+};
+
+// ============================================
+// CLASE: GESTOR DE PROCESOS
+// ============================================
+class GestorProcesos {
+private:
+    TablaProcesos tabla;    // Slot map compartido con memoria y planificador
+    int contadorID;
+    IndiceProcesos indice;  // Acceso O(1) por ID
+
+    ModoIDs modoIDs;
+    int* idsLibres;         // Pila de IDs liberados (solo en IDS_RECICLADOS)
+    int cantidadIDsLibres;
+    int capacidadIDsLibres;
+
+    static const int MAX_OBSERVADORES = 4;
+    ObservadorProcesos* observadores[MAX_OBSERVADORES];
+    int cantidadObservadores;
+
+    // Obtiene el ID para un proceso nuevo segun el modo configurado
+    int asignarID() {
+        if (modoIDs == IDS_RECICLADOS && cantidadIDsLibres > 0) {
+            return idsLibres[--cantidadIDsLibres];
+        }
+        return contadorID++;
+    }
+
+    // Devuelve un ID a la pila de libres (solo en IDS_RECICLADOS)
+    void liberarID(int id) {
+        if (modoIDs != IDS_RECICLADOS) return;
+        if (cantidadIDsLibres == capacidadIDsLibres) {
+            capacidadIDsLibres = (capacidadIDsLibres == 0) ? 16 : capacidadIDsLibres * 2;
+            int* nuevo = new int[capacidadIDsLibres];
+            for (int i = 0; i < cantidadIDsLibres; i++) nuevo[i] = idsLibres[i];
+            delete[] idsLibres;
+            idsLibres = nuevo;
+        }
+        idsLibres[cantidadIDsLibres++] = id;
+    }
+
+    // Cuenta total de procesos en la tabla
+    int contarProcesos() {
+        return (int)tabla.tamanio();
+    }
+
+    // Crea un arreglo din�mico con las posiciones de todos los procesos
+    unsigned int* crearArregloProcesos(int cantidad) {
+        unsigned int* arreglo = new unsigned int[cantidad];
+        for (int i = 0; i < cantidad; i++) {
+            arreglo[i] = (unsigned int)i;
+        }
+        return arreglo;
+    }
+
+    // Hunde el elemento i en el monticulo maximo por ID (auxiliar de heapsort)
+    void hundirPorID(unsigned int* arreglo, int cantidad, int i) {
+        const int* ids = tabla.columnaIDs();
+        while (true) {
+            int mayor = i;
+            int izq = 2 * i + 1, der = 2 * i + 2;
+            if (izq < cantidad && ids[arreglo[izq]] > ids[arreglo[mayor]]) mayor = izq;
+            if (der < cantidad && ids[arreglo[der]] > ids[arreglo[mayor]]) mayor = der;
+            if (mayor == i) return;
+            unsigned int aux = arreglo[i];
+            arreglo[i] = arreglo[mayor];
+            arreglo[mayor] = aux;
+            i = mayor;
+        }
+    }
+
+    // Ordena las posiciones por ID usando heapsort (O(n log n), sin memoria extra)
+    void ordenarArregloPorID(unsigned int* arreglo, int cantidad) {
+        for (int i = cantidad / 2 - 1; i >= 0; i--) {
+            hundirPorID(arreglo, cantidad, i);
+        }
+        for (int fin = cantidad - 1; fin > 0; fin--) {
+            unsigned int aux = arreglo[0];
+            arreglo[0] = arreglo[fin];
+            arreglo[fin] = aux;
+            hundirPorID(arreglo, fin, 0);
+        }
+    }
+
+public:
+    GestorProcesos(ModoIDs modo = IDS_MONOTONOS) {
+        contadorID = 1;
+        modoIDs = modo;
+        idsLibres = NULL;
+        cantidadIDsLibres = 0;
+        capacidadIDsLibres = 0;
+        cantidadObservadores = 0;
+    }
+
+    // Registra un modulo que debe enterarse de los cambios de prioridad
+    // y de los procesos eliminados
+    void registrarObservador(ObservadorProcesos* obs) {
+        if (cantidadObservadores < MAX_OBSERVADORES) {
+            observadores[cantidadObservadores++] = obs;
+        }
+    }
+
+    void quitarObservador(ObservadorProcesos* obs) {
+        for (int i = 0; i < cantidadObservadores; i++) {
+            if (observadores[i] == obs) {
+                observadores[i] = observadores[--cantidadObservadores];
                 return;
             }
         }
-        
-        // ============================================
-        // VERIFICAR DISPONIBILIDAD DE MEMORIA
-        // ============================================
-        if (memoriaUsada + tamanioMB > memoriaTotal) {
-            cout << "\n[ERROR] Memoria insuficiente. Disponible: " 
-                 << (memoriaTotal - memoriaUsada) << " MB, Solicitado: " 
-                 << tamanioMB << " MB\n";
-            return;
+    }
+
+    // Crea un proceso "nuevo" sin mensajes (uso interno y pruebas de rendimiento)
+    HandleProceso crear(const char* nombre, int prioridad) {
+        int id = asignarID();
+        HandleProceso h = tabla.insertar(id, nombre, prioridad, ESTADO_NUEVO);
+        indice.insertar(id, h);
+        return h;
+    }
+
+    // Quita un proceso sin confirmacion en O(1); retorna false si no existe.
+    // Los handles que conserven memoria y planificador quedan obsoletos.
+    bool quitar(int id) {
+        HandleProceso h = indice.buscar(id);
+        if (!tabla.eliminar(h)) return false;
+        indice.eliminar(id);
+        liberarID(id);
+        // La memoria libera aqui los bloques del proceso
+        for (int i = 0; i < cantidadObservadores; i++) {
+            observadores[i]->procesoEliminado(h, id);
         }
-        
-        // ============================================
-        // CREAR Y AGREGAR NUEVO BLOQUE (OPERACIÓN PUSH)
-        // ============================================
-        BloqueMemoria* nuevo = new BloqueMemoria(idProceso, nombreProceso, tamanioMB);
-        nuevo->siguiente = tope;    // El nuevo bloque apunta al anterior tope
-        tope = nuevo;               // El nuevo bloque se convierte en el tope
-        memoriaUsada += tamanioMB;  // Actualizar contador de memoria usada
-        
-        // Confirmar asignación exitosa
-        cout << "\n[OK] Memoria asignada correctamente:\n";
-        cout << "     Proceso ID: " << idProceso << " (" << nombreProceso << ")\n";
-        cout << "     Tamanio: " << tamanioMB << " MB\n";
-        cout << "     Memoria disponible: " << (memoriaTotal - memoriaUsada) << " MB\n";
+        return true;
     }
-    
-    // ============================================
-    // LIBERAR BLOQUE POR ID DE PROCESO
-    // Busca y elimina un bloque específico por ID del proceso
-    // ============================================
-    void liberarPorID(int idProceso) {
-        // Verificar si hay bloques en la pila
-        if (tope == NULL) {
-            cout << "\n[INFO] No hay bloques de memoria asignados.\n";
+
+    // Inserta proceso con estado inicial "nuevo" (pasa a "listo" al encolarse)
+    void insertar(const char* nombre, int prioridad) {
+        Proceso nuevo = resolver(crear(nombre, prioridad));
+        cout << "Proceso creado con ID: " << nuevo.id() << " (estado: nuevo)" << endl;
+    }
+
+    // Muestra procesos ordenados en tabla
+    void mostrar() {
+        if (estaVacia()) {
+            cout << "\n*** No hay procesos en el sistema ***\n";
             return;
         }
+
+        int cantidad = contarProcesos();
+        unsigned int* arreglo = crearArregloProcesos(cantidad);
+        ordenarArregloPorID(arreglo, cantidad);
+
+        cout << "\n==================== LISTA DE PROCESOS ====================\n";
+        cout << "#         ID    Nombre                  Prioridad    Estado\n";
+        cout << "===========================================================\n";
         
-        BloqueMemoria* actual = tope;
-        BloqueMemoria* anterior = NULL;
-        
-        // ============================================
-        // BUSCAR EL BLOQUE POR ID EN LA PILA
-        // ============================================
-        while (actual != NULL && actual->idProceso != idProceso) {
-            anterior = actual;
-            actual = actual->siguiente;
+        // El numero de fila (#) se calcula al mostrar; el ID es estable
+        for (int i = 0; i < cantidad; i++) {
+            char buffer[120];
+            Proceso proc = tabla.enPosicion(arreglo[i]);
+            sprintf(buffer, "%-10d%-6d%-24s%-13d%s", 
+                    i + 1,
+                    proc.id(), 
+                    proc.nombre(), 
+                    proc.prioridad(), 
+                    proc.estado());
+            cout << buffer << endl;
         }
-        
-        // Verificar si se encontró el bloque
-        if (actual == NULL) {
-            cout << "\n[ERROR] No se encontro memoria asignada al proceso ID " << idProceso << endl;
-            return;
+        cout << "===========================================================\n";
+
+        // Resumen por estado con los contadores de la tabla (O(1))
+        for (int e = 0; e < CANTIDAD_ESTADOS; e++) {
+            cout << (e > 0 ? " | " : "") << NOMBRES_ESTADO[e] << ": "
+                 << tabla.cantidadEnEstado((unsigned char)e);
         }
-        
-        // Guardar información para el mensaje de confirmación
-        char nombre[50];
-        strcpy(nombre, actual->nombreProceso);
-        int tamanio = actual->tamanioMB;
-        
-        // ============================================
-        // ELIMINAR EL NODO DE LA PILA
-        // ============================================
-        if (anterior == NULL) {
-            // El bloque a eliminar está en el tope
-            tope = actual->siguiente;
-        } else {
-            // El bloque está en medio o al final de la pila
-            anterior->siguiente = actual->siguiente;
+        cout << endl;
+
+        delete[] arreglo;
+    }
+
+    // Busca proceso por ID usando el indice hash.
+    // La vista es temporal: para guardarla use buscarHandle.
+    Proceso buscar(int id) {
+        return tabla.obtener(indice.buscar(id));
+    }
+
+    // Retorna el handle estable del proceso (HANDLE_NULO si no existe)
+    HandleProceso buscarHandle(int id) {
+        return indice.buscar(id);
+    }
+
+    // Convierte un handle en proceso; no existe() si ya fue eliminado
+    Proceso resolver(HandleProceso h) {
+        return tabla.obtener(h);
+    }
+
+    // Cuenta los procesos de cada estado leyendo solo la columna de estados
+    // (verificacion de los contadores que la tabla mantiene en cada transicion)
+    // Usa cuatro histogramas intercalados para que incrementos seguidos del
+    // mismo estado no esperen uno al otro
+    void contarPorEstado(unsigned int porEstado[CANTIDAD_ESTADOS]) const {
+        unsigned int cuenta[4][CANTIDAD_ESTADOS] = {{0}};
+        const unsigned char* estados = tabla.columnaEstados();
+        unsigned int n = tabla.tamanio();
+        unsigned int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            cuenta[0][estados[i]]++;
+            cuenta[1][estados[i + 1]]++;
+            cuenta[2][estados[i + 2]]++;
+            cuenta[3][estados[i + 3]]++;
+        }
+        for (; i < n; i++) cuenta[0][estados[i]]++;
+        for (int k = 0; k < CANTIDAD_ESTADOS; k++) {
+            porEstado[k] = cuenta[0][k] + cuenta[1][k] + cuenta[2][k] + cuenta[3][k];
         }
-        
-        // Actualizar memoria usada y liberar el bloque
-        memoriaUsada -= tamanio;
-        delete actual;
-        
-        cout << "\n[OK] Memoria liberada correctamente:\n";
-        cout << "     Proceso ID: " << idProceso << " (" << nombre << ")\n";
-        cout << "     Tamanio liberado: " << tamanio << " MB\n";
-        cout << "     Memoria disponible: " << (memoriaTotal - memoriaUsada) << " MB\n";
     }
-    
-    // ============================================
-    // LIBERAR ÚLTIMO BLOQUE ASIGNADO (OPERACIÓN POP)
-    // Elimina el bloque del tope de la pila (LIFO)
-    // ============================================
-    void liberarMemoria() {
-        // Verificar si hay bloques en la pila
-        if (tope == NULL) {
-            cout << "\n[INFO] No hay bloques de memoria asignados.\n";
+
+    // Tabla subyacente (para recorridos columnares de solo lectura)
+    const TablaProcesos& tablaProcesos() const {
+        return tabla;
+    }
+
+    // Cantidad de ranuras de la tabla (para indices paralelos por handle)
+    unsigned int totalRanuras() const {
+        return tabla.totalRanuras();
+    }
+
+    // Muestra ficha detallada del proceso
+    void mostrarFicha(Proceso proc) {
+        cout << "\n+================================================+\n";
+        cout << "|            INFORMACION DEL PROCESO             |\n";
+        cout << "+================================================+\n";
+        cout << "| ID:              " << proc.id() << endl;
+        cout << "| Nombre:          " << proc.nombre() << endl;
+        cout << "| Prioridad:       " << proc.prioridad() << " (escala 1-10)" << endl;
+        cout << "| Estado:          " << proc.estado() << endl;
+        cout << "+================================================+\n";
+    }
+
+    // Elimina proceso con confirmaci�n
+    void eliminar(int id) {
+        if (estaVacia()) {
+            cout << "Error: No hay procesos para eliminar.\n";
             return;
         }
-        
-        // Guardar información del bloque a liberar
-        BloqueMemoria* bloqueALiberar = tope;
-        int idProceso = bloqueALiberar->idProceso;
-        char nombre[50];
-        strcpy(nombre, bloqueALiberar->nombreProceso);
-        int tamanio = bloqueALiberar->tamanioMB;
-        
-        // ============================================
-        // REALIZAR OPERACIÓN POP
-        // ============================================
-        tope = tope->siguiente;     // El nuevo tope es el siguiente bloque
-        memoriaUsada -= tamanio;    // Actualizar memoria usada
-        delete bloqueALiberar;      // Liberar memoria del bloque
-        
-        cout << "\n[OK] Memoria liberada correctamente:\n";
-        cout << "     Proceso ID: " << idProceso << " (" << nombre << ")\n";
-        cout << "     Tamanio liberado: " << tamanio << " MB\n";
-        cout << "     Memoria disponible: " << (memoriaTotal - memoriaUsada) << " MB\n";
-    }
-    
-    // ============================================
-    // MOSTRAR ESTADO ACTUAL DE LA MEMORIA
-    // Muestra todos los bloques desde el tope hasta el fondo
-    // ============================================
-    void mostrarEstadoMemoria() {
-        cout << "\n=============== ESTADO DE LA MEMORIA ===============\n";
-        cout << "Memoria Total:      " << memoriaTotal << " MB\n";
-        cout << "Memoria Usada:      " << memoriaUsada << " MB\n";
-        cout << "Memoria Disponible: " << (memoriaTotal - memoriaUsada) << " MB\n";
-        cout << "Porcentaje de uso:  " 
-             << (memoriaUsada * 100 / memoriaTotal) << "%\n";
-        cout << "====================================================\n";
-        
-        // Verificar si hay bloques asignados
-        if (tope == NULL) {
-            cout << "\n*** No hay bloques de memoria asignados ***\n";
-            cout << "====================================================\n";
+
+        Proceso proc = buscar(id);
+        if (!proc.existe()) {
+            cout << "Error: No se encontro un proceso con ID " << id << endl;
             return;
         }
+
+        cout << "\nProceso a eliminar:\n";
+        cout << "  ID: " << proc.id() << " | Nombre: " << proc.nombre() 
+             << " | Prioridad: " << proc.prioridad() << endl;
+
+        char respuesta[10];
+        bool respuestaValida = false;
         
-        // Mostrar lista de bloques asignados
-        cout << "\nBLOQUES ASIGNADOS (del mas reciente al mas antiguo):\n";
-        cout << "----------------------------------------------------\n";
-        cout << "Posicion  ID Proc  Nombre Proceso          Tamanio\n";
-        cout << "----------------------------------------------------\n";
-        
-        BloqueMemoria* actual = tope;
-        int posicion = 1;
-        
-        // Recorrer toda la pila mostrando cada bloque
-        while (actual != NULL) {
-            // Formatear salida para alinear columnas
-            cout << posicion;
-            if (posicion < 10) cout << "         ";
-            else cout << "        ";
-            
-            cout << actual->idProceso;
-            if (actual->idProceso < 10) cout << "        ";
-            else if (actual->idProceso < 100) cout << "       ";
-            else cout << "      ";
-            
-            cout << actual->nombreProceso;
-            int len = strlen(actual->nombreProceso);
-            for (int i = len; i < 24; i++) cout << " ";
-            
-            cout << actual->tamanioMB << " MB\n";
+        while (!respuestaValida) {
+            cout << "\nEsta seguro que desea eliminar este proceso? (s/n): ";
+            cin.getline(respuesta, 10);
+            convertirMinusculas(respuesta);
             
-            actual = actual->siguiente;
-            posicion++;
+            if (strcmp(respuesta, "s") == 0 || strcmp(respuesta, "si") == 0) {
+                respuestaValida = true;
+                char nombre[50];
+                strcpy(nombre, proc.nombre());
+                quitar(id);
+                cout << "\nProceso '" << nombre << "' eliminado.\n";
+                return;
+            } else if (strcmp(respuesta, "n") == 0 || strcmp(respuesta, "no") == 0) {
+                cout << "\nOperacion cancelada.\n";
+                return;
+            } else {
+                cout << "Respuesta invalida. Ingrese 's' o 'n'.\n";
+            }
+        }
+    }
+
+    // Modifica prioridad
+    // Cambia la prioridad sin mensajes; retorna false si no existe
+    bool cambiarPrioridad(int id, int nuevaPrioridad) {
+        HandleProceso h = buscarHandle(id);
+        if (!tabla.fijarPrioridad(h, nuevaPrioridad)) return false;
+        // Avisar al planificador para que reubique el proceso en su cola
+        for (int i = 0; i < cantidadObservadores; i++) {
+            observadores[i]->prioridadCambiada(h, nuevaPrioridad);
+        }
+        return true;
+    }
+
+    void modificarPrioridad(int id, int nuevaPrioridad) {
+        Proceso proc = buscar(id);
+        if (proc.existe()) {
+            int prioridadAnterior = proc.prioridad();
+            cambiarPrioridad(id, nuevaPrioridad);
+            cout << "Prioridad actualizada de " << prioridadAnterior 
+                 << " a " << nuevaPrioridad << endl;
+        } else {
+            cout << "Error: No se encontro el proceso.\n";
+        }
+    }
+
+    // Cambia estado sin mensajes; false si no existe, el estado es invalido
+    // o la maquina de estados no permite la transicion
+    bool fijarEstado(int id, const char* nuevoEstado) {
+        unsigned char codigo = codificarEstado(nuevoEstado);
+        if (codigo == ESTADO_INVALIDO) return false;
+        return tabla.transicionar(buscarHandle(id), codigo);
+    }
+
+    bool fijarEstado(HandleProceso h, unsigned char codigo) {
+        return tabla.transicionar(h, codigo);
+    }
+
+    // Consulta sin cambiar nada si el proceso puede pasar al estado indicado
+    bool puedePasarA(HandleProceso h, unsigned char codigo) {
+        Proceso proc = resolver(h);
+        return proc.existe() && transicionPermitida(proc.codigoEstado(), codigo);
+    }
+
+    unsigned int cantidadEnEstado(unsigned char codigo) const {
+        return tabla.cantidadEnEstado(codigo);
+    }
+
+    // Cambia estado (todo en min�sculas)
+    void cambiarEstado(int id, const char* nuevoEstado) {
+        Proceso proc = buscar(id);
+        unsigned char codigo = codificarEstado(nuevoEstado);
+        if (proc.existe() && codigo == ESTADO_INVALIDO) {
+            cout << "Error: Estado invalido.\n";
+        } else if (proc.existe() && !transicionPermitida(proc.codigoEstado(), codigo)) {
+            cout << "Error: Un proceso no puede pasar de '" << proc.estado()
+                 << "' a '" << NOMBRES_ESTADO[codigo] << "'.\n";
+        } else if (proc.existe()) {
+            const char* estadoAnterior = proc.estado();
+            tabla.transicionar(buscarHandle(id), codigo);
+            
+            cout << "Estado actualizado de '" << estadoAnterior 
+                 << "' a '" << NOMBRES_ESTADO[codigo] << "'\n";
+        } else {
+            cout << "Error: No se encontro el proceso.\n";
         }
+    }
+
+    // Retorna array de handles ordenado por ID (para uso externo)
+    HandleProceso* obtenerArregloProcesos(int& cantidad) {
+        cantidad = contarProcesos();
+        if (cantidad == 0) return NULL;
         
-        cout << "====================================================\n";
+        unsigned int* arreglo = crearArregloProcesos(cantidad);
+        ordenarArregloPorID(arreglo, cantidad);
+        HandleProceso* handles = new HandleProceso[cantidad];
+        for (int i = 0; i < cantidad; i++) handles[i] = tabla.handleEnPosicion(arreglo[i]);
+        delete[] arreglo;
+        return handles;
+    }
+
+    bool estaVacia() {
+        return tabla.tamanio() == 0;
+    }
+
+    // La tabla y el indice liberan todos los procesos en bloque
+    ~GestorProcesos() {
+        delete[] idsLibres;
+    }
+};
+
+// ============================================
+// RECLAMACION POR EPOCAS
+// Los lectores de las estructuras sin cerrojos no avisan que punteros
+// estan usando: solo marcan en que epoca entraron. Lo que un escritor
+// saca de la estructura se retira con la epoca actual y se libera
+// recien dos epocas despues, cuando ningun lector que pudo verlo sigue
+// adentro. La epoca avanza solo si todos los lectores activos entraron
+// en la actual, asi que avanzar es un intento: el escritor nunca espera
+// a los lectores.
+// Cada hilo usa una de MAX_RANURAS ranuras de contadores (por epoca
+// modulo 3); varios hilos pueden compartir una ranura. Cada ranura y la
+// epoca ocupan su propia linea de cache: el objeto va en la pila o como
+// miembro, porque el new de C++11 no respeta alignas(64).
+// ============================================
+class ReclamadorEpocas {
+public:
+    static const int MAX_RANURAS = 64;
+
+private:
+    struct alignas(64) RanuraLectores {
+        atomic<long long> activos[3];   // Lectores adentro por epoca % 3
+    };
+
+    RanuraLectores ranuras[MAX_RANURAS];
+    alignas(64) atomic<unsigned long long> epoca;
+
+    // Ranura del hilo actual (asignada en ronda la primera vez)
+    static int ranuraDelHilo() {
+        static atomic<int> siguiente(0);
+        thread_local int ranura = -1;
+        if (ranura < 0) ranura = siguiente.fetch_add(1, memory_order_relaxed) % MAX_RANURAS;
+        return ranura;
+    }
+
+public:
+    ReclamadorEpocas() {
+        for (int r = 0; r < MAX_RANURAS; r++) {
+            for (int e = 0; e < 3; e++) ranuras[r].activos[e].store(0, memory_order_relaxed);
+        }
+        epoca.store(2, memory_order_relaxed);
+    }
+
+    // Marca la entrada del hilo y retorna la marca para salir. Si la epoca
+    // avanzo entre leerla y anotarse, se anota de nuevo en la nueva (pasa
+    // solo cuando un escritor la movio justo entonces).
+    unsigned long long entrar() {
+        atomic<long long>* activos = ranuras[ranuraDelHilo()].activos;
+        while (true) {
+            unsigned long long e = epoca.load(memory_order_seq_cst);
+            activos[e % 3].fetch_add(1, memory_order_seq_cst);
+            if (epoca.load(memory_order_seq_cst) == e) return e;
+            activos[e % 3].fetch_sub(1, memory_order_release);
+        }
+    }
+
+    void salir(unsigned long long e) {
+        ranuras[ranuraDelHilo()].activos[e % 3].fetch_sub(1, memory_order_release);
+    }
+
+    unsigned long long epocaActual() const {
+        return epoca.load(memory_order_seq_cst);
+    }
+
+    // Avanza la epoca si no queda ningun lector de las anteriores
+    void intentarAvanzar() {
+        unsigned long long e = epoca.load(memory_order_seq_cst);
+        for (int r = 0; r < MAX_RANURAS; r++) {
+            if (ranuras[r].activos[(e + 1) % 3].load(memory_order_seq_cst) != 0) return;
+            if (ranuras[r].activos[(e + 2) % 3].load(memory_order_seq_cst) != 0) return;
+        }
+        epoca.compare_exchange_strong(e, e + 1, memory_order_seq_cst);
+    }
+
+    // Lo retirado en la epoca 'retiro' ya no lo puede ver ningun lector
+    bool sePuedeLiberar(unsigned long long retiro) const {
+        return retiro + 2 <= epoca.load(memory_order_seq_cst);
+    }
+};
+
+// Marca la lectura mientras dura el bloque
+class GuardiaLectura {
+private:
+    ReclamadorEpocas& reclamador;
+    unsigned long long epoca;
+
+public:
+    GuardiaLectura(ReclamadorEpocas& r) : reclamador(r) {
+        epoca = reclamador.entrar();
+    }
+
+    ~GuardiaLectura() {
+        reclamador.salir(epoca);
+    }
+};
+
+// ============================================
+// CLASE: GESTOR DE PROCESOS CONCURRENTE
+// Version del gestor para varios hilos a la vez. Los procesos se
+// reparten por ID en FRAGMENTOS con un cerrojo de escritura cada uno:
+// crear, quitar y cambiar prioridad o estado solo bloquean el fragmento
+// del ID. Cada proceso es un registro inmutable; un cambio publica una
+// copia nueva y retira la anterior (copiar-actualizar, como RCU). Los
+// lectores no toman cerrojos ni esperan a los escritores: marcan la
+// epoca, leen la tabla publicada del fragmento y copian el registro.
+// Las lecturas dan una foto consistente de cada proceso; mostrar y
+// obtenerArregloProcesos, una foto de cada fragmento.
+// A diferencia de GestorProcesos no hay handles ni observadores (el
+// planificador y la memoria siguen usando aquel) y los IDs son siempre
+// monotonos.
+// ============================================
+struct DatosProceso {
+    int id;
+    int prioridad;
+    unsigned char estado;
+    char nombre[50];
+};
+
+class GestorProcesosConcurrente {
+public:
+    static const int FRAGMENTOS = 64;
+
+private:
+    // Tabla hash abierta de un fragmento. Las casillas solo pasan de
+    // vacia a registro, de registro a registro (cambio) o a lapida
+    // (eliminado), asi un lector que sondea nunca saltea un ID vivo.
+    struct TablaFragmento {
+        unsigned int bits;
+        atomic<const DatosProceso*>* casillas;
+
+        unsigned int posicionInicial(int id) const {
+            return ((unsigned int)id * 2246822519u) >> (32 - bits);
+        }
+
+        unsigned int mascara() const {
+            return (1u << bits) - 1;
+        }
+    };
+
+    struct Retirado {
+        const DatosProceso* registro;   // O NULL si se retira una tabla
+        TablaFragmento* tabla;
+        unsigned long long epoca;
+    };
+
+    struct Fragmento {
+        mutex cerrojo;                          // Solo escritores
+        atomic<TablaFragmento*> tabla;
+        unsigned int vivos;
+        unsigned int lapidas;
+        Retirado* retirados;
+        int cantidadRetirados;
+        int capacidadRetirados;
+        atomic<unsigned int> porEstado[CANTIDAD_ESTADOS];
+        char relleno[64];
+    };
+
+    static const DatosProceso LAPIDA;
+    static const int RETIROS_POR_INTENTO = 64;  // Retiros entre intentos de liberar
+
+    Fragmento fragmentos[FRAGMENTOS];
+    ReclamadorEpocas reclamador;
+    atomic<int> contadorID;
+
+    static int fragmentoDe(int id) {
+        return (int)(((unsigned int)id * 2654435769u) >> 26);
+    }
+
+    static TablaFragmento* nuevaTabla(unsigned int bits) {
+        atomic<const DatosProceso*>* casillas = new atomic<const DatosProceso*>[1u << bits];
+        for (unsigned int i = 0; i < (1u << bits); i++) casillas[i].store(NULL, memory_order_relaxed);
+        TablaFragmento* t = new TablaFragmento;
+        t->bits = bits;
+        t->casillas = casillas;
+        return t;
+    }
+
+    static void liberarTabla(TablaFragmento* t) {
+        delete[] t->casillas;
+        delete t;
+    }
+
+    // Casilla del ID en la tabla (o -1); solo con el cerrojo del fragmento
+    static int casillaDe(const TablaFragmento* t, int id) {
+        unsigned int i = t->posicionInicial(id);
+        while (true) {
+            const DatosProceso* r = t->casillas[i].load(memory_order_relaxed);
+            if (r == NULL) return -1;
+            if (r != &LAPIDA && r->id == id) return (int)i;
+            i = (i + 1) & t->mascara();
+        }
+    }
+
+    // Registro del ID (o NULL) dentro de una lectura. Se usa el puntero
+    // que se comparo: releer la casilla podria dar otro registro o una
+    // lapida puesta despues.
+    static const DatosProceso* registroDe(const TablaFragmento* t, int id) {
+        unsigned int i = t->posicionInicial(id);
+        while (true) {
+            const DatosProceso* r = t->casillas[i].load(memory_order_acquire);
+            if (r == NULL) return NULL;
+            if (r != &LAPIDA && r->id == id) return r;
+            i = (i + 1) & t->mascara();
+        }
+    }
+
+    // Con el cerrojo del fragmento: deja lugar para uno mas. Si vivos y
+    // lapidas pasan la mitad, publica una tabla nueva sin lapidas (del
+    // doble si hace falta) y retira la vieja.
+    void prepararLugar(Fragmento& f) {
+        TablaFragmento* t = f.tabla.load(memory_order_relaxed);
+        if ((f.vivos + f.lapidas + 1) * 2 <= (1u << t->bits)) return;
+        unsigned int bits = t->bits;
+        if ((f.vivos + 1) * 4 > (1u << bits)) bits++;
+        TablaFragmento* nueva = nuevaTabla(bits);
+        for (unsigned int i = 0; i < (1u << t->bits); i++) {
+            const DatosProceso* r = t->casillas[i].load(memory_order_relaxed);
+            if (r == NULL || r == &LAPIDA) continue;
+            unsigned int j = nueva->posicionInicial(r->id);
+            while (nueva->casillas[j].load(memory_order_relaxed) != NULL) j = (j + 1) & nueva->mascara();
+            nueva->casillas[j].store(r, memory_order_relaxed);
+        }
+        f.tabla.store(nueva, memory_order_release);
+        f.lapidas = 0;
+        retirar(f, NULL, t);
+    }
+
+    // Con el cerrojo del fragmento
+    void retirar(Fragmento& f, const DatosProceso* registro, TablaFragmento* tabla) {
+        if (f.cantidadRetirados == f.capacidadRetirados) {
+            f.capacidadRetirados = (f.capacidadRetirados == 0) ? 64 : f.capacidadRetirados * 2;
+            Retirado* nuevos = new Retirado[f.capacidadRetirados];
+            for (int i = 0; i < f.cantidadRetirados; i++) nuevos[i] = f.retirados[i];
+            delete[] f.retirados;
+            f.retirados = nuevos;
+        }
+        Retirado& r = f.retirados[f.cantidadRetirados++];
+        r.registro = registro;
+        r.tabla = tabla;
+        r.epoca = reclamador.epocaActual();
+        if (f.cantidadRetirados % RETIROS_POR_INTENTO == 0) liberarRetirados(f);
+    }
+
+    // Con el cerrojo del fragmento: libera lo que ya nadie puede leer
+    void liberarRetirados(Fragmento& f) {
+        reclamador.intentarAvanzar();
+        int quedan = 0;
+        for (int i = 0; i < f.cantidadRetirados; i++) {
+            Retirado& r = f.retirados[i];
+            if (!reclamador.sePuedeLiberar(r.epoca)) {
+                f.retirados[quedan++] = r;
+            } else if (r.registro != NULL) {
+                delete r.registro;
+            } else {
+                liberarTabla(r.tabla);
+            }
+        }
+        f.cantidadRetirados = quedan;
+    }
+
+    // Hunde el elemento i en el monticulo maximo por ID (auxiliar de heapsort)
+    static void hundirPorID(DatosProceso* arreglo, int cantidad, int i) {
+        while (true) {
+            int mayor = i;
+            int izq = 2 * i + 1, der = 2 * i + 2;
+            if (izq < cantidad && arreglo[izq].id > arreglo[mayor].id) mayor = izq;
+            if (der < cantidad && arreglo[der].id > arreglo[mayor].id) mayor = der;
+            if (mayor == i) return;
+            DatosProceso aux = arreglo[i];
+            arreglo[i] = arreglo[mayor];
+            arreglo[mayor] = aux;
+            i = mayor;
+        }
+    }
+
+public:
+    GestorProcesosConcurrente() {
+        contadorID.store(1, memory_order_relaxed);
+        for (int k = 0; k < FRAGMENTOS; k++) {
+            Fragmento& f = fragmentos[k];
+            f.tabla.store(nuevaTabla(4), memory_order_relaxed);
+            f.vivos = 0;
+            f.lapidas = 0;
+            f.retirados = NULL;
+            f.cantidadRetirados = 0;
+            f.capacidadRetirados = 0;
+            for (int e = 0; e < CANTIDAD_ESTADOS; e++) f.porEstado[e].store(0, memory_order_relaxed);
+        }
+    }
+
+    // Crea un proceso "nuevo" sin mensajes y retorna su ID
+    int crear(const char* nombre, int prioridad) {
+        DatosProceso* r = new DatosProceso;
+        r->id = contadorID.fetch_add(1, memory_order_relaxed);
+        r->prioridad = prioridad;
+        r->estado = ESTADO_NUEVO;
+        strncpy(r->nombre, nombre, 49);
+        r->nombre[49] = '\0';
+
+        Fragmento& f = fragmentos[fragmentoDe(r->id)];
+        lock_guard<mutex> guardia(f.cerrojo);
+        prepararLugar(f);
+        TablaFragmento* t = f.tabla.load(memory_order_relaxed);
+        unsigned int i = t->posicionInicial(r->id);
+        while (t->casillas[i].load(memory_order_relaxed) != NULL) i = (i + 1) & t->mascara();
+        t->casillas[i].store(r, memory_order_release);
+        f.vivos++;
+        f.porEstado[ESTADO_NUEVO].fetch_add(1, memory_order_relaxed);
+        return r->id;
+    }
+
+    // Quita un proceso; false si no existe
+    bool quitar(int id) {
+        Fragmento& f = fragmentos[fragmentoDe(id)];
+        lock_guard<mutex> guardia(f.cerrojo);
+        TablaFragmento* t = f.tabla.load(memory_order_relaxed);
+        int i = casillaDe(t, id);
+        if (i < 0) return false;
+        const DatosProceso* r = t->casillas[i].load(memory_order_relaxed);
+        t->casillas[i].store(&LAPIDA, memory_order_release);
+        f.vivos--;
+        f.lapidas++;
+        f.porEstado[r->estado].fetch_sub(1, memory_order_relaxed);
+        retirar(f, r, NULL);
+        return true;
+    }
+
+    // Cambia la prioridad sin mensajes; false si no existe
+    bool cambiarPrioridad(int id, int nuevaPrioridad) {
+        Fragmento& f = fragmentos[fragmentoDe(id)];
+        lock_guard<mutex> guardia(f.cerrojo);
+        TablaFragmento* t = f.tabla.load(memory_order_relaxed);
+        int i = casillaDe(t, id);
+        if (i < 0) return false;
+        const DatosProceso* anterior = t->casillas[i].load(memory_order_relaxed);
+        DatosProceso* r = new DatosProceso(*anterior);
+        r->prioridad = nuevaPrioridad;
+        t->casillas[i].store(r, memory_order_release);
+        retirar(f, anterior, NULL);
+        return true;
+    }
+
+    // Cambia el estado sin mensajes; false si no existe o la maquina de
+    // estados no permite la transicion
+    bool fijarEstado(int id, unsigned char codigo) {
+        if (codigo >= CANTIDAD_ESTADOS) return false;
+        Fragmento& f = fragmentos[fragmentoDe(id)];
+        lock_guard<mutex> guardia(f.cerrojo);
+        TablaFragmento* t = f.tabla.load(memory_order_relaxed);
+        int i = casillaDe(t, id);
+        if (i < 0) return false;
+        const DatosProceso* anterior = t->casillas[i].load(memory_order_relaxed);
+        if (!transicionPermitida(anterior->estado, codigo)) return false;
+        if (anterior->estado == codigo) return true;
+        DatosProceso* r = new DatosProceso(*anterior);
+        r->estado = codigo;
+        t->casillas[i].store(r, memory_order_release);
+        f.porEstado[anterior->estado].fetch_sub(1, memory_order_relaxed);
+        f.porEstado[codigo].fetch_add(1, memory_order_relaxed);
+        retirar(f, anterior, NULL);
+        return true;
+    }
+
+    // Copia el proceso en salida sin tomar cerrojos; false si no existe
+    bool buscar(int id, DatosProceso& salida) {
+        GuardiaLectura guardia(reclamador);
+        const TablaFragmento* t = fragmentos[fragmentoDe(id)].tabla.load(memory_order_acquire);
+        const DatosProceso* r = registroDe(t, id);
+        if (r == NULL) return false;
+        salida = *r;
+        return true;
+    }
+
+    // Foto de todos los procesos ordenada por ID (el llamador la libera);
+    // NULL si no hay procesos
+    DatosProceso* obtenerArregloProcesos(int& cantidad) {
+        int capacidad = 0;
+        DatosProceso* arreglo = NULL;
+        cantidad = 0;
+        for (int k = 0; k < FRAGMENTOS; k++) {
+            GuardiaLectura guardia(reclamador);
+            const TablaFragmento* t = fragmentos[k].tabla.load(memory_order_acquire);
+            for (unsigned int i = 0; i < (1u << t->bits); i++) {
+                const DatosProceso* r = t->casillas[i].load(memory_order_acquire);
+                if (r == NULL || r == &LAPIDA) continue;
+                if (cantidad == capacidad) {
+                    capacidad = (capacidad == 0) ? 64 : capacidad * 2;
+                    DatosProceso* nuevo = new DatosProceso[capacidad];
+                    for (int j = 0; j < cantidad; j++) nuevo[j] = arreglo[j];
+                    delete[] arreglo;
+                    arreglo = nuevo;
+                }
+                arreglo[cantidad++] = *r;
+            }
+        }
+        if (cantidad == 0) {
+            delete[] arreglo;
+            return NULL;
+        }
+        // Heapsort por ID (O(n log n), sin memoria extra)
+        for (int i = cantidad / 2 - 1; i >= 0; i--) hundirPorID(arreglo, cantidad, i);
+        for (int fin = cantidad - 1; fin > 0; fin--) {
+            DatosProceso aux = arreglo[0];
+            arreglo[0] = arreglo[fin];
+            arreglo[fin] = aux;
+            hundirPorID(arreglo, fin, 0);
+        }
+        return arreglo;
+    }
+
+    unsigned int cantidadEnEstado(unsigned char codigo) const {
+        unsigned int total = 0;
+        for (int k = 0; k < FRAGMENTOS; k++) total += fragmentos[k].porEstado[codigo].load(memory_order_relaxed);
+        return total;
+    }
+
+    // Muestra procesos ordenados en tabla (misma salida que GestorProcesos)
+    void mostrar() {
+        int cantidad;
+        DatosProceso* arreglo = obtenerArregloProcesos(cantidad);
+        if (arreglo == NULL) {
+            cout << "\n*** No hay procesos en el sistema ***\n";
+            return;
+        }
+
+        cout << "\n==================== LISTA DE PROCESOS ====================\n";
+        cout << "#         ID    Nombre                  Prioridad    Estado\n";
+        cout << "===========================================================\n";
+        for (int i = 0; i < cantidad; i++) {
+            char buffer[120];
+            sprintf(buffer, "%-10d%-6d%-24s%-13d%s", i + 1, arreglo[i].id, arreglo[i].nombre, arreglo[i].prioridad,
+                    NOMBRES_ESTADO[arreglo[i].estado]);
+            cout << buffer << endl;
+        }
+        cout << "===========================================================\n";
+        for (int e = 0; e < CANTIDAD_ESTADOS; e++) {
+            cout << (e > 0 ? " | " : "") << NOMBRES_ESTADO[e] << ": " << cantidadEnEstado((unsigned char)e);
+        }
+        cout << endl;
+        delete[] arreglo;
+    }
+
+    // Versiones con mensajes (como las de GestorProcesos, sin confirmacion)
+    void insertar(const char* nombre, int prioridad) {
+        cout << "Proceso creado con ID: " << crear(nombre, prioridad) << " (estado: nuevo)" << endl;
+    }
+
+    void eliminar(int id) {
+        if (quitar(id)) cout << "Proceso " << id << " eliminado.\n";
+        else cout << "Error: No se encontro un proceso con ID " << id << endl;
+    }
+
+    void modificarPrioridad(int id, int nuevaPrioridad) {
+        if (cambiarPrioridad(id, nuevaPrioridad)) cout << "Prioridad actualizada a " << nuevaPrioridad << endl;
+        else cout << "Error: No se encontro el proceso.\n";
+    }
+
+    void cambiarEstado(int id, const char* nuevoEstado) {
+        unsigned char codigo = codificarEstado(nuevoEstado);
+        DatosProceso datos;
+        if (!buscar(id, datos)) {
+            cout << "Error: No se encontro el proceso.\n";
+        } else if (codigo == ESTADO_INVALIDO) {
+            cout << "Error: Estado invalido.\n";
+        } else if (!fijarEstado(id, codigo)) {
+            cout << "Error: Un proceso no puede pasar de '" << NOMBRES_ESTADO[datos.estado] << "' a '"
+                 << NOMBRES_ESTADO[codigo] << "'.\n";
+        } else {
+            cout << "Estado actualizado a '" << NOMBRES_ESTADO[codigo] << "'\n";
+        }
+    }
+
+    // Sin lectores ni escritores en curso: se libera todo
+    ~GestorProcesosConcurrente() {
+        for (int k = 0; k < FRAGMENTOS; k++) {
+            Fragmento& f = fragmentos[k];
+            TablaFragmento* t = f.tabla.load(memory_order_relaxed);
+            for (unsigned int i = 0; i < (1u << t->bits); i++) {
+                const DatosProceso* r = t->casillas[i].load(memory_order_relaxed);
+                if (r != NULL && r != &LAPIDA) delete r;
+            }
+            liberarTabla(t);
+            for (int i = 0; i < f.cantidadRetirados; i++) {
+                if (f.retirados[i].registro != NULL) delete f.retirados[i].registro;
+                else liberarTabla(f.retirados[i].tabla);
+            }
+            delete[] f.retirados;
+        }
+    }
+};
+
+const DatosProceso GestorProcesosConcurrente::LAPIDA = {0, 0, 0, ""};
+
+// ============================================
+// POOL DE NODOS
+// Reserva los nodos de un tipo en bloques grandes (arena) y reutiliza
+// los liberados con una lista libre, sin llamar a malloc en cada
+// operacion. Los nodos vecinos quedan contiguos en memoria y al
+// destruir el pool se liberan todos los bloques de una vez.
+// Solo para tipos sin destructor propio (los nodos de las listas).
+// ============================================
+template <class T>
+class PoolNodos {
+private:
+    union Casilla {
+        Casilla* siguienteLibre;
+        alignas(T) char datos[sizeof(T)];
+    };
+
+    struct Bloque {
+        Bloque* siguiente;
+        int cantidad;
+        Casilla* casillas;
+    };
+
+    static const int PRIMER_BLOQUE = 64;
+    static const int BLOQUE_MAXIMO = 65536;
+
+    Bloque* bloques;            // Bloques reservados al sistema
+    Casilla* libres;            // Casillas devueltas, listas para reutilizar
+    int usadasEnBloque;         // Casillas entregadas del bloque actual
+    int tamanioSiguiente;
+    long long enUso;
+
+    void nuevoBloque() {
+        Bloque* b = new Bloque;
+        b->cantidad = tamanioSiguiente;
+        b->casillas = new Casilla[tamanioSiguiente];
+        b->siguiente = bloques;
+        bloques = b;
+        usadasEnBloque = 0;
+        if (tamanioSiguiente < BLOQUE_MAXIMO) tamanioSiguiente *= 2;
+    }
+
+public:
+    PoolNodos() {
+        bloques = NULL;
+        libres = NULL;
+        usadasEnBloque = 0;
+        tamanioSiguiente = PRIMER_BLOQUE;
+        enUso = 0;
+    }
+
+    // Memoria para un nodo; se construye con: new (pool.reservar()) T(...)
+    void* reservar() {
+        enUso++;
+        if (libres != NULL) {
+            Casilla* c = libres;
+            libres = c->siguienteLibre;
+            return c;
+        }
+        if (bloques == NULL || usadasEnBloque == bloques->cantidad) nuevoBloque();
+        return &bloques->casillas[usadasEnBloque++];
+    }
+
+    // Devuelve el nodo al pool (O(1))
+    void liberar(T* nodo) {
+        Casilla* c = (Casilla*)nodo;
+        c->siguienteLibre = libres;
+        libres = c;
+        enUso--;
+    }
+
+    // Libera todos los nodos a la vez, sin recorrerlos
+    void liberarTodo() {
+        while (bloques != NULL) {
+            Bloque* b = bloques;
+            bloques = b->siguiente;
+            delete[] b->casillas;
+            delete b;
+        }
+        libres = NULL;
+        usadasEnBloque = 0;
+        tamanioSiguiente = PRIMER_BLOQUE;
+        enUso = 0;
+    }
+
+    long long nodosEnUso() const {
+        return enUso;
+    }
+
+    ~PoolNodos() {
+        liberarTodo();
+    }
+};
+
+// ============================================
+// ARBOL ROJO-NEGRO GENERICO
+// Arbol binario de busqueda balanceado: insertar, eliminar y buscar
+// en O(log n). Orden::menor(a, b) define el orden; los valores
+// iguales se insertan a la derecha (conservan el orden de llegada),
+// salvo que se pida ponerlo delante de ellos.
+// Guarda en cache el nodo minimo para consultarlo en O(1).
+// Los nodos salen de un PoolNodos propio y se usa un centinela
+// negro en lugar de NULL para simplificar los rebalanceos.
+// ============================================
+template <class T, class Orden>
+class ArbolRojoNegro {
+public:
+    struct Nodo {
+        T valor;
+        Nodo* izquierdo;
+        Nodo* derecho;
+        Nodo* padre;
+        bool rojo;
+    };
+
+private:
+    Nodo nulo;                  // Centinela: hojas y padre de la raiz
+    Nodo* raiz;
+    Nodo* primeroCache;         // Nodo mas a la izquierda (o &nulo si esta vacio)
+    unsigned int cantidad;
+    PoolNodos<Nodo> pool;
+
+    Nodo* minimoDesde(Nodo* x) const {
+        while (x->izquierdo != &nulo) x = x->izquierdo;
+        return x;
+    }
+
+    void rotarIzquierda(Nodo* x) {
+        Nodo* y = x->derecho;
+        x->derecho = y->izquierdo;
+        if (y->izquierdo != &nulo) y->izquierdo->padre = x;
+        y->padre = x->padre;
+        if (x->padre == &nulo) raiz = y;
+        else if (x == x->padre->izquierdo) x->padre->izquierdo = y;
+        else x->padre->derecho = y;
+        y->izquierdo = x;
+        x->padre = y;
+    }
+
+    void rotarDerecha(Nodo* x) {
+        Nodo* y = x->izquierdo;
+        x->izquierdo = y->derecho;
+        if (y->derecho != &nulo) y->derecho->padre = x;
+        y->padre = x->padre;
+        if (x->padre == &nulo) raiz = y;
+        else if (x == x->padre->derecho) x->padre->derecho = y;
+        else x->padre->izquierdo = y;
+        y->derecho = x;
+        x->padre = y;
+    }
+
+    // Reemplaza el subarbol de u por el de v
+    void trasplantar(Nodo* u, Nodo* v) {
+        if (u->padre == &nulo) raiz = v;
+        else if (u == u->padre->izquierdo) u->padre->izquierdo = v;
+        else u->padre->derecho = v;
+        v->padre = u->padre;
+    }
+
+    // Restaura las propiedades tras insertar z (rojo)
+    void arreglarInsercion(Nodo* z) {
+        while (z->padre->rojo) {
+            Nodo* abuelo = z->padre->padre;
+            if (z->padre == abuelo->izquierdo) {
+                Nodo* tio = abuelo->derecho;
+                if (tio->rojo) {
+                    z->padre->rojo = false;
+                    tio->rojo = false;
+                    abuelo->rojo = true;
+                    z = abuelo;
+                } else {
+                    if (z == z->padre->derecho) {
+                        z = z->padre;
+                        rotarIzquierda(z);
+                    }
+                    z->padre->rojo = false;
+                    z->padre->padre->rojo = true;
+                    rotarDerecha(z->padre->padre);
+                }
+            } else {
+                Nodo* tio = abuelo->izquierdo;
+                if (tio->rojo) {
+                    z->padre->rojo = false;
+                    tio->rojo = false;
+                    abuelo->rojo = true;
+                    z = abuelo;
+                } else {
+                    if (z == z->padre->izquierdo) {
+                        z = z->padre;
+                        rotarDerecha(z);
+                    }
+                    z->padre->rojo = false;
+                    z->padre->padre->rojo = true;
+                    rotarIzquierda(z->padre->padre);
+                }
+            }
+        }
+        raiz->rojo = false;
     }
+
+    // Restaura las propiedades cuando se quito un nodo negro sobre x
+    void arreglarEliminacion(Nodo* x) {
+        while (x != raiz && !x->rojo) {
+            if (x == x->padre->izquierdo) {
+                Nodo* w = x->padre->derecho;
+                if (w->rojo) {
+                    w->rojo = false;
+                    x->padre->rojo = true;
+                    rotarIzquierda(x->padre);
+                    w = x->padre->derecho;
+                }
+                if (!w->izquierdo->rojo && !w->derecho->rojo) {
+                    w->rojo = true;
+                    x = x->padre;
+                } else {
+                    if (!w->derecho->rojo) {
+                        w->izquierdo->rojo = false;
+                        w->rojo = true;
+                        rotarDerecha(w);
+                        w = x->padre->derecho;
+                    }
+                    w->rojo = x->padre->rojo;
+                    x->padre->rojo = false;
+                    w->derecho->rojo = false;
+                    rotarIzquierda(x->padre);
+                    x = raiz;
+                }
+            } else {
+                Nodo* w = x->padre->izquierdo;
+                if (w->rojo) {
+                    w->rojo = false;
+                    x->padre->rojo = true;
+                    rotarDerecha(x->padre);
+                    w = x->padre->izquierdo;
+                }
+                if (!w->derecho->rojo && !w->izquierdo->rojo) {
+                    w->rojo = true;
+                    x = x->padre;
+                } else {
+                    if (!w->izquierdo->rojo) {
+                        w->derecho->rojo = false;
+                        w->rojo = true;
+                        rotarIzquierda(w);
+                        w = x->padre->izquierdo;
+                    }
+                    w->rojo = x->padre->rojo;
+                    x->padre->rojo = false;
+                    w->izquierdo->rojo = false;
+                    rotarDerecha(x->padre);
+                    x = raiz;
+                }
+            }
+        }
+        x->rojo = false;
+    }
+
+public:
+    ArbolRojoNegro() {
+        nulo.izquierdo = &nulo;
+        nulo.derecho = &nulo;
+        nulo.padre = &nulo;
+        nulo.rojo = false;
+        raiz = &nulo;
+        primeroCache = &nulo;
+        cantidad = 0;
+    }
+
+    // Inserta el valor y retorna su nodo (sirve para eliminarlo despues).
+    // Con delanteDeIguales queda antes de los valores iguales ya insertados.
+    Nodo* insertar(const T& valor, bool delanteDeIguales = false) {
+        Nodo* nuevo = new (pool.reservar()) Nodo;
+        nuevo->valor = valor;
+        nuevo->izquierdo = &nulo;
+        nuevo->derecho = &nulo;
+        nuevo->rojo = true;
+
+        Nodo* padre = &nulo;
+        Nodo* x = raiz;
+        bool esMinimo = true;
+        bool izquierda = false;
+        while (x != &nulo) {
+            padre = x;
+            izquierda = delanteDeIguales ? !Orden::menor(x->valor, valor) : Orden::menor(valor, x->valor);
+            if (izquierda) {
+                x = x->izquierdo;
+            } else {
+                x = x->derecho;
+                esMinimo = false;
+            }
+        }
+        nuevo->padre = padre;
+        if (padre == &nulo) raiz = nuevo;
+        else if (izquierda) padre->izquierdo = nuevo;
+        else padre->derecho = nuevo;
+
+        if (esMinimo) primeroCache = nuevo;
+        cantidad++;
+        arreglarInsercion(nuevo);
+        return nuevo;
+    }
+
+    // Quita un nodo devuelto por insertar o por una busqueda
+    void eliminar(Nodo* z) {
+        if (z == primeroCache) {
+            Nodo* sig = siguiente(z);
+            primeroCache = (sig != NULL) ? sig : &nulo;
+        }
+
+        Nodo* y = z;
+        bool yEraRojo = y->rojo;
+        Nodo* x;
+        if (z->izquierdo == &nulo) {
+            x = z->derecho;
+            trasplantar(z, z->derecho);
+        } else if (z->derecho == &nulo) {
+            x = z->izquierdo;
+            trasplantar(z, z->izquierdo);
+        } else {
+            // Dos hijos: el sucesor ocupa el lugar de z
+            y = minimoDesde(z->derecho);
+            yEraRojo = y->rojo;
+            x = y->derecho;
+            if (y->padre == z) {
+                x->padre = y;
+            } else {
+                trasplantar(y, y->derecho);
+                y->derecho = z->derecho;
+                y->derecho->padre = y;
+            }
+            trasplantar(z, y);
+            y->izquierdo = z->izquierdo;
+            y->izquierdo->padre = y;
+            y->rojo = z->rojo;
+        }
+        if (!yEraRojo) arreglarEliminacion(x);
+
+        pool.liberar(z);
+        cantidad--;
+    }
+
+    // Nodo minimo en O(1); NULL si el arbol esta vacio
+    Nodo* primero() const {
+        return (primeroCache == &nulo) ? NULL : primeroCache;
+    }
+
+    Nodo* ultimo() const {
+        if (raiz == &nulo) return NULL;
+        Nodo* x = raiz;
+        while (x->derecho != &nulo) x = x->derecho;
+        return x;
+    }
+
+    // Sucesor en orden; NULL si n es el ultimo
+    Nodo* siguiente(Nodo* n) const {
+        if (n->derecho != &nulo) return minimoDesde(n->derecho);
+        Nodo* y = n->padre;
+        while (y != &nulo && n == y->derecho) {
+            n = y;
+            y = y->padre;
+        }
+        return (y == &nulo) ? NULL : y;
+    }
+
+    // Primer nodo que no es menor que valor; NULL si no hay
+    Nodo* limiteInferior(const T& valor) const {
+        Nodo* x = raiz;
+        Nodo* resultado = NULL;
+        while (x != &nulo) {
+            if (Orden::menor(x->valor, valor)) {
+                x = x->derecho;
+            } else {
+                resultado = x;
+                x = x->izquierdo;
+            }
+        }
+        return resultado;
+    }
+
+    // Nodo equivalente a valor (ni menor ni mayor); NULL si no esta
+    Nodo* buscar(const T& valor) const {
+        Nodo* n = limiteInferior(valor);
+        if (n == NULL || Orden::menor(valor, n->valor)) return NULL;
+        return n;
+    }
+
+    unsigned int tamanio() const {
+        return cantidad;
+    }
+
+    bool estaVacio() const {
+        return cantidad == 0;
+    }
+};
+
+// ============================================
+// ASIGNADOR BUDDY
+// Reparte un rango de direcciones [0, capacidad) en bloques de
+// tamaño potencia de 2 alineados a su tamaño. Cada orden k tiene su
+// lista doblemente enlazada de bloques libres de 2^k unidades y un
+// mapa de bits indica que ordenes tienen bloques disponibles.
+// Reservar parte el bloque libre mas chico que alcance: O(log N).
+// Liberar une el bloque con su companero (direccion ^ tamaño)
+// mientras este libre; cada union es O(1) porque el companero se
+// desengancha de su lista sin recorrerla.
+// ============================================
+class AsignadorBuddy {
+public:
+    static const int MAX_ORDEN = 31;
+    static const unsigned int SIN_BLOQUE = 0xFFFFFFFFu;
+
+private:
+    unsigned int capacidad;             // En unidades (la unidad minima de reserva)
+    unsigned char* ordenDe;             // Orden del bloque que empieza en cada direccion
+    bool* libreEn;                      // true si en esa direccion empieza un bloque libre
+    unsigned int* siguienteLibre;       // Enlaces de las listas libres, por direccion
+    unsigned int* anteriorLibre;
+    unsigned int cabeza[MAX_ORDEN + 1]; // Primer bloque libre de cada orden
+    unsigned int libresPorOrden[MAX_ORDEN + 1];
+    unsigned int mapaOrdenes;           // Bit k encendido: hay bloques libres de orden k
+    unsigned int unidadesLibres;
+
+    void agregarLibre(unsigned int dir, int k) {
+        ordenDe[dir] = (unsigned char)k;
+        libreEn[dir] = true;
+        anteriorLibre[dir] = SIN_BLOQUE;
+        siguienteLibre[dir] = cabeza[k];
+        if (cabeza[k] != SIN_BLOQUE) anteriorLibre[cabeza[k]] = dir;
+        cabeza[k] = dir;
+        libresPorOrden[k]++;
+        mapaOrdenes |= 1u << k;
+    }
+
+    void quitarLibre(unsigned int dir, int k) {
+        libreEn[dir] = false;
+        if (anteriorLibre[dir] != SIN_BLOQUE) siguienteLibre[anteriorLibre[dir]] = siguienteLibre[dir];
+        else cabeza[k] = siguienteLibre[dir];
+        if (siguienteLibre[dir] != SIN_BLOQUE) anteriorLibre[siguienteLibre[dir]] = anteriorLibre[dir];
+        libresPorOrden[k]--;
+        if (cabeza[k] == SIN_BLOQUE) mapaOrdenes &= ~(1u << k);
+    }
+
+public:
+    AsignadorBuddy(unsigned int _capacidad) {
+        capacidad = _capacidad;
+        ordenDe = new unsigned char[capacidad];
+        libreEn = new bool[capacidad];
+        siguienteLibre = new unsigned int[capacidad];
+        anteriorLibre = new unsigned int[capacidad];
+        for (unsigned int i = 0; i < capacidad; i++) libreEn[i] = false;
+        for (int k = 0; k <= MAX_ORDEN; k++) {
+            cabeza[k] = SIN_BLOQUE;
+            libresPorOrden[k] = 0;
+        }
+        mapaOrdenes = 0;
+        unidadesLibres = capacidad;
+
+        // Si la capacidad no es potencia de 2 se cubre con bloques
+        // decrecientes; cada uno queda alineado a su propio tamaño
+        unsigned int dir = 0;
+        while (dir < capacidad) {
+            int k = 31 - __builtin_clz(capacidad - dir);
+            agregarLibre(dir, k);
+            dir += 1u << k;
+        }
+    }
+
+    // Menor orden cuyo bloque alcanza para la cantidad de unidades
+    static int ordenPara(unsigned int unidades) {
+        if (unidades <= 1) return 0;
+        return 32 - __builtin_clz(unidades - 1);
+    }
+
+    // Retorna la direccion del bloque o SIN_BLOQUE si ningun bloque libre alcanza
+    unsigned int reservar(unsigned int unidades) {
+        if (unidades == 0 || unidades > capacidad) return SIN_BLOQUE;
+        int k = ordenPara(unidades);
+        unsigned int candidatos = mapaOrdenes & ~((1u << k) - 1);
+        if (candidatos == 0) return SIN_BLOQUE;
+
+        int j = __builtin_ctz(candidatos);     // Orden libre mas chico que alcanza
+        unsigned int dir = cabeza[j];
+        quitarLibre(dir, j);
+        // Partir a la mitad hasta llegar al orden pedido; la mitad alta queda libre
+        while (j > k) {
+            j--;
+            agregarLibre(dir + (1u << j), j);
+        }
+        ordenDe[dir] = (unsigned char)k;
+        unidadesLibres -= 1u << k;
+        return dir;
+    }
+
+    // Devuelve el bloque que empieza en dir y lo une con sus companeros libres
+    bool liberar(unsigned int dir) {
+        if (dir >= capacidad || libreEn[dir]) return false;
+        int k = ordenDe[dir];
+        unidadesLibres += 1u << k;
+        while (k < MAX_ORDEN) {
+            unsigned int companero = dir ^ (1u << k);
+            if (companero >= capacidad || !libreEn[companero] || ordenDe[companero] != k) break;
+            quitarLibre(companero, k);
+            dir &= ~(1u << k);      // El bloque unido empieza en la menor direccion
+            k++;
+        }
+        agregarLibre(dir, k);
+        return true;
+    }
+
+    // Reserva exactamente [dir, dir + 2^orden), que debe estar libre:
+    // parte el bloque libre que lo contiene hasta aislarlo. Lo usa la
+    // compactacion para ubicar un bloque en una posicion elegida
+    bool reservarEn(unsigned int dir, int orden) {
+        if (dir >= capacidad || (dir & ((1u << orden) - 1)) != 0) return false;
+        unsigned int inicio = libreQueContiene(dir);
+        if (inicio == SIN_BLOQUE || ordenDe[inicio] < orden) return false;
+        int k = ordenDe[inicio];
+        quitarLibre(inicio, k);
+        while (k > orden) {
+            k--;
+            unsigned int mitad = inicio + (1u << k);
+            if (dir >= mitad) {
+                agregarLibre(inicio, k);
+                inicio = mitad;
+            } else {
+                agregarLibre(mitad, k);
+            }
+        }
+        ordenDe[dir] = (unsigned char)orden;
+        unidadesLibres -= 1u << orden;
+        return true;
+    }
+
+    // Inicio del bloque libre que contiene dir, o SIN_BLOQUE si dir esta
+    // ocupada: prueba cada alineacion posible (a lo sumo MAX_ORDEN + 1)
+    unsigned int libreQueContiene(unsigned int dir) const {
+        for (int k = 0; k <= MAX_ORDEN; k++) {
+            unsigned int inicio = dir & ~((1u << k) - 1);
+            if (libreEn[inicio] && ordenDe[inicio] == k) return inicio;
+        }
+        return SIN_BLOQUE;
+    }
+
+    // true si en dir empieza un bloque libre
+    bool estaLibre(unsigned int dir) const {
+        return libreEn[dir];
+    }
+
+    // Recorrido de la lista libre de un orden (SIN_BLOQUE al final)
+    unsigned int primeroLibre(int k) const {
+        return cabeza[k];
+    }
+
+    unsigned int siguienteLibreDe(unsigned int dir) const {
+        return siguienteLibre[dir];
+    }
+
+    // Unidades que ocupa el bloque (reservado o libre) que empieza en dir
+    unsigned int tamanioBloque(unsigned int dir) const {
+        return 1u << ordenDe[dir];
+    }
+
+    unsigned int capacidadTotal() const {
+        return capacidad;
+    }
+
+    unsigned int libres() const {
+        return unidadesLibres;
+    }
+
+    // Tamaño del mayor bloque libre: el orden mas alto del mapa de bits
+    unsigned int mayorBloqueLibre() const {
+        if (mapaOrdenes == 0) return 0;
+        return 1u << (31 - __builtin_clz(mapaOrdenes));
+    }
+
+    unsigned int bloquesLibresDeOrden(int k) const {
+        return libresPorOrden[k];
+    }
+
+    // Fragmentacion externa: 1 - (mayor bloque libre / memoria libre total)
+    double fragmentacionExterna() const {
+        if (unidadesLibres == 0) return 0.0;
+        return 1.0 - (double)mayorBloqueLibre() / unidadesLibres;
+    }
+
+    ~AsignadorBuddy() {
+        delete[] ordenDe;
+        delete[] libreEn;
+        delete[] siguienteLibre;
+        delete[] anteriorLibre;
+    }
+};
+
+// ============================================
+// ASIGNADOR DE LISTA LIBRE CON POLITICA DE UBICACION
+// Reserva rangos de tamaño exacto (sin redondeo) y une cada bloque
+// liberado con sus vecinos libres en O(1) usando etiquetas de
+// frontera: el inicio de un bloque libre guarda su tamaño y su
+// ultima unidad guarda su inicio. La politica, elegida en
+// compilacion, decide que bloque libre usar para cada pedido:
+//   AjustePrimero    menor direccion que alcance (recorrido en orden)
+//   AjusteSiguiente  como el primero, pero desde la ultima ubicacion
+//   AjusteMejor      el mas chico que alcance (arbol por tamaño)
+//   AjustePeor       el mas grande (arbol por tamaño)
+//   AjusteSegregado  listas por clase de tamaño potencia de 2
+// ============================================
+const unsigned int SIN_BLOQUE_LIBRE = 0xFFFFFFFFu;
+
+struct BloqueLibre {
+    unsigned int direccion;
+    unsigned int tamanio;
+};
+
+struct OrdenPorDireccion {
+    static bool menor(const BloqueLibre& a, const BloqueLibre& b) {
+        return a.direccion < b.direccion;
+    }
+};
+
+// A igual tamaño decide la direccion: cada bloque tiene clave unica
+struct OrdenPorTamanio {
+    static bool menor(const BloqueLibre& a, const BloqueLibre& b) {
+        return a.tamanio < b.tamanio || (a.tamanio == b.tamanio && a.direccion < b.direccion);
+    }
+};
+
+// Bloques libres ordenados por direccion (base de primer y siguiente ajuste)
+class IndicePorDireccion {
+protected:
+    typedef ArbolRojoNegro<BloqueLibre, OrdenPorDireccion> Arbol;
+    Arbol arbol;
+
+public:
+    void insertar(unsigned int direccion, unsigned int tamanio) {
+        BloqueLibre b = {direccion, tamanio};
+        arbol.insertar(b);
+    }
+
+    void quitar(unsigned int direccion, unsigned int tamanio) {
+        BloqueLibre b = {direccion, tamanio};
+        arbol.eliminar(arbol.buscar(b));
+    }
+
+    // Recorre todos los bloques (solo para reportes)
+    unsigned int mayorLibre() const {
+        unsigned int mayor = 0;
+        for (Arbol::Nodo* n = arbol.primero(); n != NULL; n = arbol.siguiente(n)) {
+            if (n->valor.tamanio > mayor) mayor = n->valor.tamanio;
+        }
+        return mayor;
+    }
+};
+
+class AjustePrimero : public IndicePorDireccion {
+public:
+    AjustePrimero(unsigned int) {}
+
+    static const char* nombre() {
+        return "primer-ajuste";
+    }
+
+    unsigned int buscar(unsigned int tamanio) const {
+        for (Arbol::Nodo* n = arbol.primero(); n != NULL; n = arbol.siguiente(n)) {
+            if (n->valor.tamanio >= tamanio) return n->valor.direccion;
+        }
+        return SIN_BLOQUE_LIBRE;
+    }
+};
+
+class AjusteSiguiente : public IndicePorDireccion {
+private:
+    unsigned int ultimaDireccion;   // Donde se ubico el pedido anterior
+
+public:
+    AjusteSiguiente(unsigned int) {
+        ultimaDireccion = 0;
+    }
+
+    static const char* nombre() {
+        return "siguiente-ajuste";
+    }
+
+    // Busca desde la ultima ubicacion hasta el final y luego da la vuelta
+    unsigned int buscar(unsigned int tamanio) {
+        BloqueLibre desde = {ultimaDireccion, 0};
+        Arbol::Nodo* inicio = arbol.limiteInferior(desde);
+        for (Arbol::Nodo* n = inicio; n != NULL; n = arbol.siguiente(n)) {
+            if (n->valor.tamanio >= tamanio) return ultimaDireccion = n->valor.direccion;
+        }
+        for (Arbol::Nodo* n = arbol.primero(); n != inicio; n = arbol.siguiente(n)) {
+            if (n->valor.tamanio >= tamanio) return ultimaDireccion = n->valor.direccion;
+        }
+        return SIN_BLOQUE_LIBRE;
+    }
+};
+
+// Bloques libres ordenados por (tamaño, direccion) (base de mejor y peor ajuste)
+class IndicePorTamanio {
+protected:
+    typedef ArbolRojoNegro<BloqueLibre, OrdenPorTamanio> Arbol;
+    Arbol arbol;
+
+public:
+    void insertar(unsigned int direccion, unsigned int tamanio) {
+        BloqueLibre b = {direccion, tamanio};
+        arbol.insertar(b);
+    }
+
+    void quitar(unsigned int direccion, unsigned int tamanio) {
+        BloqueLibre b = {direccion, tamanio};
+        arbol.eliminar(arbol.buscar(b));
+    }
+
+    unsigned int mayorLibre() const {
+        Arbol::Nodo* n = arbol.ultimo();
+        return (n == NULL) ? 0 : n->valor.tamanio;
+    }
+};
+
+class AjusteMejor : public IndicePorTamanio {
+public:
+    AjusteMejor(unsigned int) {}
+
+    static const char* nombre() {
+        return "mejor-ajuste";
+    }
+
+    // El menor tamaño >= pedido (y la menor direccion entre iguales): O(log n)
+    unsigned int buscar(unsigned int tamanio) const {
+        BloqueLibre pedido = {0, tamanio};
+        Arbol::Nodo* n = arbol.limiteInferior(pedido);
+        return (n == NULL) ? SIN_BLOQUE_LIBRE : n->valor.direccion;
+    }
+};
+
+class AjustePeor : public IndicePorTamanio {
+public:
+    AjustePeor(unsigned int) {}
+
+    static const char* nombre() {
+        return "peor-ajuste";
+    }
+
+    unsigned int buscar(unsigned int tamanio) const {
+        Arbol::Nodo* n = arbol.ultimo();
+        return (n == NULL || n->valor.tamanio < tamanio) ? SIN_BLOQUE_LIBRE : n->valor.direccion;
+    }
+};
+
+// Una lista doblemente enlazada por clase [2^c, 2^(c+1)) y un mapa de
+// bits de clases no vacias. Se prueban pocos bloques de la clase del
+// pedido y, si ninguno alcanza, cualquiera de una clase mayor sirve.
+class AjusteSegregado {
+private:
+    static const int CLASES = 32;
+    static const int SONDEOS = 8;
+
+    unsigned int* siguienteDe;      // Enlaces por direccion
+    unsigned int* anteriorDe;
+    unsigned int* tamanioDe;
+    unsigned int cabeza[CLASES];
+    unsigned int mapaClases;
+
+    static int claseDe(unsigned int tamanio) {
+        return 31 - __builtin_clz(tamanio);
+    }
+
+public:
+    AjusteSegregado(unsigned int capacidad) {
+        siguienteDe = new unsigned int[capacidad];
+        anteriorDe = new unsigned int[capacidad];
+        tamanioDe = new unsigned int[capacidad];
+        for (int c = 0; c < CLASES; c++) cabeza[c] = SIN_BLOQUE_LIBRE;
+        mapaClases = 0;
+    }
+
+    static const char* nombre() {
+        return "segregado";
+    }
+
+    void insertar(unsigned int direccion, unsigned int tamanio) {
+        int c = claseDe(tamanio);
+        tamanioDe[direccion] = tamanio;
+        anteriorDe[direccion] = SIN_BLOQUE_LIBRE;
+        siguienteDe[direccion] = cabeza[c];
+        if (cabeza[c] != SIN_BLOQUE_LIBRE) anteriorDe[cabeza[c]] = direccion;
+        cabeza[c] = direccion;
+        mapaClases |= 1u << c;
+    }
+
+    void quitar(unsigned int direccion, unsigned int tamanio) {
+        int c = claseDe(tamanio);
+        if (anteriorDe[direccion] != SIN_BLOQUE_LIBRE) siguienteDe[anteriorDe[direccion]] = siguienteDe[direccion];
+        else cabeza[c] = siguienteDe[direccion];
+        if (siguienteDe[direccion] != SIN_BLOQUE_LIBRE) anteriorDe[siguienteDe[direccion]] = anteriorDe[direccion];
+        if (cabeza[c] == SIN_BLOQUE_LIBRE) mapaClases &= ~(1u << c);
+    }
+
+    unsigned int buscar(unsigned int tamanio) const {
+        int c = claseDe(tamanio);
+        unsigned int d = cabeza[c];
+        for (int i = 0; i < SONDEOS && d != SIN_BLOQUE_LIBRE; i++, d = siguienteDe[d]) {
+            if (tamanioDe[d] >= tamanio) return d;
+        }
+        unsigned int mayores = (c + 1 < CLASES) ? (mapaClases & ~((2u << c) - 1)) : 0;
+        if (mayores != 0) return cabeza[__builtin_ctz(mayores)];
+        // Sin clases mayores: terminar de recorrer la propia clase
+        for (; d != SIN_BLOQUE_LIBRE; d = siguienteDe[d]) {
+            if (tamanioDe[d] >= tamanio) return d;
+        }
+        return SIN_BLOQUE_LIBRE;
+    }
+
+    unsigned int mayorLibre() const {
+        if (mapaClases == 0) return 0;
+        unsigned int mayor = 0;
+        for (unsigned int d = cabeza[31 - __builtin_clz(mapaClases)]; d != SIN_BLOQUE_LIBRE; d = siguienteDe[d]) {
+            if (tamanioDe[d] > mayor) mayor = tamanioDe[d];
+        }
+        return mayor;
+    }
+
+    ~AjusteSegregado() {
+        delete[] siguienteDe;
+        delete[] anteriorDe;
+        delete[] tamanioDe;
+    }
+};
+
+template <class Politica>
+class AsignadorListaLibre {
+public:
+    static const unsigned int SIN_BLOQUE = SIN_BLOQUE_LIBRE;
+
+private:
+    unsigned int capacidad;         // En unidades
+    unsigned int* tamanioEn;        // Tamaño del bloque (libre u ocupado) que empieza en cada direccion
+    unsigned int* inicioDe;         // En la ultima unidad de un bloque libre: su direccion inicial
+    bool* libreEn;                  // true si en esa direccion empieza un bloque libre
+    unsigned int unidadesLibres;
+    Politica politica;
+
+    void agregarLibre(unsigned int direccion, unsigned int tamanio) {
+        tamanioEn[direccion] = tamanio;
+        libreEn[direccion] = true;
+        inicioDe[direccion + tamanio - 1] = direccion;
+        politica.insertar(direccion, tamanio);
+    }
+
+    void quitarLibre(unsigned int direccion) {
+        libreEn[direccion] = false;
+        politica.quitar(direccion, tamanioEn[direccion]);
+    }
+
+public:
+    AsignadorListaLibre(unsigned int _capacidad) : politica(_capacidad) {
+        capacidad = _capacidad;
+        tamanioEn = new unsigned int[capacidad];
+        inicioDe = new unsigned int[capacidad];
+        libreEn = new bool[capacidad];
+        for (unsigned int i = 0; i < capacidad; i++) {
+            inicioDe[i] = 0;
+            libreEn[i] = false;
+        }
+        unidadesLibres = capacidad;
+        agregarLibre(0, capacidad);
+    }
+
+    static const char* nombre() {
+        return Politica::nombre();
+    }
+
+    // Retorna la direccion del bloque o SIN_BLOQUE si la politica no encuentra lugar
+    unsigned int reservar(unsigned int unidades) {
+        if (unidades == 0 || unidades > unidadesLibres) return SIN_BLOQUE;
+        unsigned int direccion = politica.buscar(unidades);
+        if (direccion == SIN_BLOQUE) return SIN_BLOQUE;
+
+        unsigned int tamanio = tamanioEn[direccion];
+        quitarLibre(direccion);
+        if (tamanio > unidades) agregarLibre(direccion + unidades, tamanio - unidades);
+        tamanioEn[direccion] = unidades;
+        unidadesLibres -= unidades;
+        return direccion;
+    }
+
+    // Libera el bloque y lo une con los vecinos libres de ambos lados
+    bool liberar(unsigned int direccion) {
+        if (direccion >= capacidad || libreEn[direccion]) return false;
+        unsigned int tamanio = tamanioEn[direccion];
+        unidadesLibres += tamanio;
+
+        unsigned int derecha = direccion + tamanio;
+        if (derecha < capacidad && libreEn[derecha]) {
+            tamanio += tamanioEn[derecha];
+            quitarLibre(derecha);
+        }
+        if (direccion > 0) {
+            unsigned int izquierda = inicioDe[direccion - 1];
+            if (izquierda < direccion && libreEn[izquierda] &&
+                izquierda + tamanioEn[izquierda] == direccion) {
+                quitarLibre(izquierda);
+                tamanio += direccion - izquierda;
+                direccion = izquierda;
+            }
+        }
+        agregarLibre(direccion, tamanio);
+        return true;
+    }
+
+    unsigned int tamanioBloque(unsigned int direccion) const {
+        return tamanioEn[direccion];
+    }
+
+    unsigned int capacidadTotal() const {
+        return capacidad;
+    }
+
+    unsigned int libres() const {
+        return unidadesLibres;
+    }
+
+    unsigned int mayorBloqueLibre() const {
+        return politica.mayorLibre();
+    }
+
+    // Fragmentacion externa: 1 - (mayor bloque libre / memoria libre total)
+    double fragmentacionExterna() const {
+        if (unidadesLibres == 0) return 0.0;
+        return 1.0 - (double)mayorBloqueLibre() / unidadesLibres;
+    }
+
+    ~AsignadorListaLibre() {
+        delete[] tamanioEn;
+        delete[] inicioDe;
+        delete[] libreEn;
+    }
+};
+
+// ============================================
+// ASIGNADOR SLAB (CLASES DE TAMAÑO PARA PEDIDOS CHICOS)
+// Los pedidos de hasta MAX_OBJETO bytes se redondean a una clase de
+// tamaño y se sirven desde slabs de TAMANIO_SLAB bytes que el
+// Proveedor (el gestor de memoria) saca del asignador general con
+// reservarSlab/liberarSlab. Cada clase guarda su lista de slabs
+// parciales y cada slab un mapa de bits de dos niveles con sus
+// objetos libres, asi que reservar y liberar son O(1). El slab de una
+// direccion se ubica por su alineacion: el buddy alinea cada bloque
+// a su tamaño. De cada clase se conserva a lo sumo un slab vacio; los
+// demas vuelven al proveedor para no retener memoria ociosa.
+// ============================================
+template <class Proveedor>
+class AsignadorSlab {
+public:
+    static const unsigned int TAMANIO_SLAB = 64 * 1024;
+    static const unsigned int MAX_OBJETO = 2048;
+    static const int CANTIDAD_CLASES = 14;
+
+private:
+    struct Slab {
+        unsigned long long direccion;
+        int clase;
+        unsigned int enUso;
+        unsigned long long resumen;     // Bit w encendido: mapa[w] tiene objetos libres
+        unsigned long long mapa[64];    // Bit encendido = objeto libre (hasta 4096)
+        Slab* siguiente;                // Lista de parciales de su clase
+        Slab* anterior;
+    };
+
+    struct Clase {
+        unsigned int tamanio;
+        unsigned int objetosPorSlab;
+        Slab* parciales;
+        Slab* vacio;                    // Slab de reserva sin objetos (o NULL)
+        unsigned int slabs;             // Slabs de la clase, incluido el vacio
+        unsigned long long objetosEnUso;
+        unsigned long long bytesSolicitados;
+    };
+
+    Proveedor& proveedor;
+    Clase clases[CANTIDAD_CLASES];
+    unsigned char claseDe[MAX_OBJETO / 16 + 1];     // Clase por tamaño redondeado a 16
+    Slab** slabEn;                      // Slab que empieza en cada multiplo de TAMANIO_SLAB
+    PoolNodos<Slab> poolSlabs;
+
+    void agregarParcial(Clase& c, Slab* s) {
+        s->anterior = NULL;
+        s->siguiente = c.parciales;
+        if (c.parciales != NULL) c.parciales->anterior = s;
+        c.parciales = s;
+    }
+
+    void quitarParcial(Clase& c, Slab* s) {
+        if (s->anterior == NULL) c.parciales = s->siguiente;
+        else s->anterior->siguiente = s->siguiente;
+        if (s->siguiente != NULL) s->siguiente->anterior = s->anterior;
+    }
+
+    Slab* nuevoSlab(int clase) {
+        unsigned long long direccion = proveedor.reservarSlab(TAMANIO_SLAB);
+        if (direccion == SIN_DIRECCION) return NULL;
+        Slab* s = new (poolSlabs.reservar()) Slab;
+        s->direccion = direccion;
+        s->clase = clase;
+        s->enUso = 0;
+        unsigned int objetos = clases[clase].objetosPorSlab;
+        for (int w = 0; w < 64; w++) {
+            unsigned int desde = (unsigned int)w * 64;
+            if (desde + 64 <= objetos) s->mapa[w] = ~0ULL;
+            else if (desde < objetos) s->mapa[w] = (1ULL << (objetos - desde)) - 1;
+            else s->mapa[w] = 0;
+        }
+        unsigned int palabras = (objetos + 63) / 64;
+        s->resumen = (palabras == 64) ? ~0ULL : (1ULL << palabras) - 1;
+        slabEn[direccion / TAMANIO_SLAB] = s;
+        clases[clase].slabs++;
+        return s;
+    }
+
+    void devolverSlab(Slab* s) {
+        slabEn[s->direccion / TAMANIO_SLAB] = NULL;
+        clases[s->clase].slabs--;
+        proveedor.liberarSlab(s->direccion);
+        poolSlabs.liberar(s);
+    }
+
+public:
+    // capacidad: bytes que puede entregar el proveedor (para indexar slabs)
+    AsignadorSlab(Proveedor& _proveedor, unsigned long long capacidad) : proveedor(_proveedor) {
+        const unsigned int tamanios[CANTIDAD_CLASES] = {16, 32, 48, 64, 96, 128, 192, 256,
+                                                        384, 512, 768, 1024, 1536, 2048};
+        int c = 0;
+        for (unsigned int t = 0; t <= MAX_OBJETO / 16; t++) {
+            while (tamanios[c] < t * 16) c++;
+            claseDe[t] = (unsigned char)c;
+        }
+        for (int i = 0; i < CANTIDAD_CLASES; i++) {
+            clases[i].tamanio = tamanios[i];
+            clases[i].objetosPorSlab = TAMANIO_SLAB / tamanios[i];
+            clases[i].parciales = NULL;
+            clases[i].vacio = NULL;
+            clases[i].slabs = 0;
+            clases[i].objetosEnUso = 0;
+            clases[i].bytesSolicitados = 0;
+        }
+        unsigned long long indices = capacidad / TAMANIO_SLAB + 1;
+        slabEn = new Slab*[indices];
+        for (unsigned long long i = 0; i < indices; i++) slabEn[i] = NULL;
+    }
+
+    static bool esPequenio(unsigned long long tamanio) {
+        return tamanio > 0 && tamanio <= MAX_OBJETO;
+    }
+
+    // Tamaño real que ocupa un pedido chico (el de su clase)
+    unsigned int tamanioClase(unsigned long long tamanio) const {
+        return clases[claseDe[(tamanio + 15) / 16]].tamanio;
+    }
+
+    // Direccion del objeto, o SIN_DIRECCION si el proveedor no da otro slab
+    unsigned long long reservar(unsigned long long tamanio) {
+        int clase = claseDe[(tamanio + 15) / 16];
+        Clase& c = clases[clase];
+        Slab* s = c.parciales;
+        if (s == NULL) {
+            s = c.vacio;
+            c.vacio = NULL;
+            if (s == NULL) s = nuevoSlab(clase);
+            if (s == NULL) return SIN_DIRECCION;
+            agregarParcial(c, s);
+        }
+
+        int w = __builtin_ctzll(s->resumen);
+        int b = __builtin_ctzll(s->mapa[w]);
+        s->mapa[w] &= s->mapa[w] - 1;
+        if (s->mapa[w] == 0) s->resumen &= ~(1ULL << w);
+        if (++s->enUso == c.objetosPorSlab) quitarParcial(c, s);     // Queda lleno
+        c.objetosEnUso++;
+        c.bytesSolicitados += tamanio;
+        return s->direccion + (unsigned long long)(w * 64 + b) * c.tamanio;
+    }
+
+    // Devuelve el objeto; tamanio es el pedido original (para las estadisticas)
+    bool liberar(unsigned long long direccion, unsigned long long tamanio) {
+        Slab* s = slabEn[direccion / TAMANIO_SLAB];
+        if (s == NULL) return false;
+        Clase& c = clases[s->clase];
+        unsigned int indice = (unsigned int)((direccion - s->direccion) / c.tamanio);
+        int w = indice / 64, b = indice % 64;
+        if (s->mapa[w] & (1ULL << b)) return false;     // Ya estaba libre
+
+        if (s->enUso == c.objetosPorSlab) agregarParcial(c, s);      // Estaba lleno
+        s->mapa[w] |= 1ULL << b;
+        s->resumen |= 1ULL << w;
+        c.objetosEnUso--;
+        c.bytesSolicitados -= tamanio;
+        if (--s->enUso == 0) {
+            quitarParcial(c, s);
+            if (c.vacio == NULL) c.vacio = s;
+            else devolverSlab(s);
+        }
+        return true;
+    }
+
+    // Devuelve al proveedor los slabs vacios de reserva
+    void recortar() {
+        for (int i = 0; i < CANTIDAD_CLASES; i++) {
+            if (clases[i].vacio != NULL) devolverSlab(clases[i].vacio);
+            clases[i].vacio = NULL;
+        }
+    }
+
+    unsigned long long bytesEnSlabs() const {
+        unsigned long long total = 0;
+        for (int i = 0; i < CANTIDAD_CLASES; i++) total += (unsigned long long)clases[i].slabs * TAMANIO_SLAB;
+        return total;
+    }
+
+    // Ocupacion por clase: objetos usados sobre la capacidad de sus slabs
+    void mostrarOcupacion() const {
+        cout << "Clase    Slabs  Objetos (usados/capacidad)  Ocupacion  Pedido / ocupado\n";
+        bool alguna = false;
+        for (int i = 0; i < CANTIDAD_CLASES; i++) {
+            const Clase& c = clases[i];
+            if (c.slabs == 0) continue;
+            unsigned long long capacidad = (unsigned long long)c.slabs * c.objetosPorSlab;
+            unsigned long long ocupado = c.objetosEnUso * c.tamanio;
+            char linea[120];
+            sprintf(linea, "%-4u B   %-7u%10llu / %-15llu%6.1f%%    %.1f%%", c.tamanio, c.slabs,
+                    c.objetosEnUso, capacidad, 100.0 * c.objetosEnUso / capacidad,
+                    ocupado > 0 ? 100.0 * c.bytesSolicitados / ocupado : 0.0);
+            cout << linea << "\n";
+            alguna = true;
+        }
+        if (!alguna) cout << "(sin slabs)\n";
+    }
+
+    ~AsignadorSlab() {
+        delete[] slabEn;
+    }
+};
+
+// ============================================
+// AREA DE INTERCAMBIO (SWAP) EN ARCHIVO
+// Guarda en un archivo local la imagen de los bloques desalojados.
+// Las ranuras del archivo se reparten con un AsignadorListaLibre
+// (unidad: una pagina simulada = bytesPorUnidad bytes reales). Un hilo de
+// E/S atiende los pedidos: el hilo principal solo encola y recoge
+// resultados, nunca espera al disco. Cada vez que despierta, el hilo
+// toma todos los pedidos acumulados como un lote, lo ordena por
+// posicion en el archivo y une las ranuras contiguas en una sola
+// escritura o lectura. Dentro de un lote las escrituras van antes
+// que las lecturas, asi que leer una ranura recien escrita es seguro.
+// El contenido de un bloque es simulado: su imagen se deriva de una
+// firma, la arma el hilo de E/S al escribir y la verifica al leer, asi
+// que el hilo principal nunca copia datos. Las ranuras se reservan y
+// liberan solo desde el hilo principal.
+// ============================================
+struct EstadisticasIntercambio {
+    long long escrituras;           // Pedidos de salida (page-out) completados
+    long long lecturas;             // Pedidos de entrada (page-in) completados
+    long long lotes;
+    long long operacionesArchivo;   // fwrite/fread emitidos (tras unir contiguos)
+    long long errores;              // Fallos de E/S o imagen corrupta al leer
+    unsigned long long bytesEscritos;
+    unsigned long long bytesLeidos;
+    double segundosEscritura;       // Tiempo del hilo de E/S escribiendo
+    double segundosLectura;
+    double latenciaEscritura;       // Suma de (encolado -> completado)
+    double latenciaLectura;
+    double latenciaMaximaEscritura;
+    double latenciaMaximaLectura;
+};
+
+class AreaIntercambio {
+public:
+    static const unsigned int SIN_RANURA = SIN_BLOQUE_LIBRE;
+
+    // Lectura terminada: la etiqueta es la que se paso a leer()
+    struct Completado {
+        void* etiqueta;
+        bool correcto;              // false si fallo la E/S o la imagen no coincide
+    };
+
+private:
+    struct Pedido {
+        bool escritura;
+        unsigned int ranura;
+        unsigned int unidades;
+        unsigned long long firma;   // Contenido esperado de la imagen
+        unsigned long long secuencia;
+        void* etiqueta;
+        chrono::steady_clock::time_point encolado;
+    };
+
+    FILE* archivo;
+    char* ruta;                     // El archivo se borra al destruir el area
+    unsigned int bytesPorUnidad;    // Multiplo de 8
+    AsignadorListaLibre<AjusteMejor> ranuras;
+    unsigned long long secuencia;
+
+    mutex cerrojo;                  // Protege todo lo que sigue
+    condition_variable hayTrabajo;
+    condition_variable loteTerminado;
+    Pedido* pendientes;
+    int cantidadPendientes;
+    int capacidadPendientes;
+    Completado* completados;
+    int cantidadCompletados;
+    int capacidadCompletados;
+    int enVuelo;                    // Pedidos tomados por el hilo y no terminados
+    bool terminar;
+    EstadisticasIntercambio estadisticas;
+    thread hilo;
+
+    template <class T>
+    static void agregar(T*& arreglo, int& cantidad, int& capacidad, const T& valor) {
+        if (cantidad == capacidad) {
+            T* nuevo = new T[capacidad * 2];
+            for (int i = 0; i < cantidad; i++) nuevo[i] = arreglo[i];
+            delete[] arreglo;
+            arreglo = nuevo;
+            capacidad *= 2;
+        }
+        arreglo[cantidad++] = valor;
+    }
+
+    // Patron de la imagen: cada palabra depende de la firma y de su posicion
+    static unsigned long long palabraImagen(unsigned long long firma, size_t i) {
+        return firma ^ (i * 0x9E3779B97F4A7C15ULL);
+    }
+
+    static int compararPedidos(const void* a, const void* b) {
+        const Pedido* x = (const Pedido*)a;
+        const Pedido* y = (const Pedido*)b;
+        if (x->escritura != y->escritura) return x->escritura ? -1 : 1;
+        if (x->ranura != y->ranura) return x->ranura < y->ranura ? -1 : 1;
+        return x->secuencia < y->secuencia ? -1 : 1;
+    }
+
+    // Cantidad de pedidos a partir de i que ocupan ranuras contiguas
+    static int tramoContiguo(const Pedido* lote, int i, int cantidad, char*& buffer, size_t& capacidad,
+                             size_t bytesPorUnidad) {
+        int j = i + 1;
+        unsigned int fin = lote[i].ranura + lote[i].unidades;
+        while (j < cantidad && lote[j].escritura == lote[i].escritura && lote[j].ranura == fin) {
+            fin += lote[j].unidades;
+            j++;
+        }
+        size_t bytes = (size_t)(fin - lote[i].ranura) * bytesPorUnidad;
+        if (bytes > capacidad) {
+            delete[] buffer;
+            buffer = new char[bytes];
+            capacidad = bytes;
+        }
+        return j - i;
+    }
+
+    void procesarLote(Pedido* lote, int cantidad, char*& buffer, size_t& capacidad) {
+        qsort(lote, cantidad, sizeof(Pedido), compararPedidos);
+        long long operaciones = 0, errores = 0;
+        unsigned long long bytesEscritos = 0, bytesLeidos = 0;
+        double segundosEscritura = 0, segundosLectura = 0;
+        Completado* listos = new Completado[cantidad];
+        int cantidadListos = 0;
+
+        for (int i = 0; i < cantidad; ) {
+            int tramo = tramoContiguo(lote, i, cantidad, buffer, capacidad, bytesPorUnidad);
+            size_t bytes = 0;
+            for (int k = i; k < i + tramo; k++) bytes += (size_t)lote[k].unidades * bytesPorUnidad;
+            long desplazamiento = (long)lote[i].ranura * (long)bytesPorUnidad;
+
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            bool correcto = (fseek(archivo, desplazamiento, SEEK_SET) == 0);
+            if (lote[i].escritura) {
+                unsigned long long* palabras = (unsigned long long*)buffer;
+                for (int k = i; k < i + tramo; k++) {
+                    size_t cantidadPalabras = (size_t)lote[k].unidades * bytesPorUnidad / 8;
+                    for (size_t w = 0; w < cantidadPalabras; w++) *palabras++ = palabraImagen(lote[k].firma, w);
+                }
+                correcto = correcto && fwrite(buffer, 1, bytes, archivo) == bytes;
+                segundosEscritura += chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+                bytesEscritos += bytes;
+            } else {
+                correcto = correcto && fread(buffer, 1, bytes, archivo) == bytes;
+                segundosLectura += chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+                bytesLeidos += bytes;
+            }
+            operaciones++;
+            if (!correcto) errores++;
+
+            // Verificar cada imagen leida contra su firma
+            size_t offset = 0;
+            for (int k = i; k < i + tramo; k++) {
+                size_t b = (size_t)lote[k].unidades * bytesPorUnidad;
+                if (!lote[k].escritura) {
+                    bool coincide = correcto;
+                    const unsigned long long* palabras = (const unsigned long long*)(buffer + offset);
+                    for (size_t w = 0; coincide && w < b / 8; w++) {
+                        coincide = (palabras[w] == palabraImagen(lote[k].firma, w));
+                    }
+                    if (correcto && !coincide) errores++;
+                    Completado c = {lote[k].etiqueta, coincide};
+                    listos[cantidadListos++] = c;
+                }
+                offset += b;
+            }
+            // Al pasar de escrituras a lecturas, volcar lo escrito
+            if (lote[i].escritura && (i + tramo == cantidad || !lote[i + tramo].escritura)) {
+                chrono::steady_clock::time_point inicioVolcado = chrono::steady_clock::now();
+                fflush(archivo);
+                segundosEscritura += chrono::duration<double>(chrono::steady_clock::now() - inicioVolcado).count();
+            }
+            i += tramo;
+        }
+
+        chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+        lock_guard<mutex> guardia(cerrojo);
+        for (int k = 0; k < cantidad; k++) {
+            double latencia = chrono::duration<double>(fin - lote[k].encolado).count();
+            if (lote[k].escritura) {
+                estadisticas.escrituras++;
+                estadisticas.latenciaEscritura += latencia;
+                if (latencia > estadisticas.latenciaMaximaEscritura) estadisticas.latenciaMaximaEscritura = latencia;
+            } else {
+                estadisticas.lecturas++;
+                estadisticas.latenciaLectura += latencia;
+                if (latencia > estadisticas.latenciaMaximaLectura) estadisticas.latenciaMaximaLectura = latencia;
+            }
+        }
+        for (int k = 0; k < cantidadListos; k++) {
+            agregar(completados, cantidadCompletados, capacidadCompletados, listos[k]);
+        }
+        estadisticas.lotes++;
+        estadisticas.operacionesArchivo += operaciones;
+        estadisticas.errores += errores;
+        estadisticas.bytesEscritos += bytesEscritos;
+        estadisticas.bytesLeidos += bytesLeidos;
+        estadisticas.segundosEscritura += segundosEscritura;
+        estadisticas.segundosLectura += segundosLectura;
+        enVuelo = 0;
+        loteTerminado.notify_all();
+        delete[] listos;
+    }
+
+    // Hilo de E/S: intercambia la lista de pendientes por una vacia y la procesa
+    void atender() {
+        int capacidadLote = 64;
+        Pedido* lote = new Pedido[capacidadLote];
+        char* buffer = NULL;
+        size_t capacidadBuffer = 0;
+        while (true) {
+            int cantidad;
+            {
+                unique_lock<mutex> guardia(cerrojo);
+                while (cantidadPendientes == 0 && !terminar) hayTrabajo.wait(guardia);
+                if (cantidadPendientes == 0) break;
+                Pedido* tomado = pendientes;
+                pendientes = lote;
+                lote = tomado;
+                int capacidadTomada = capacidadPendientes;
+                capacidadPendientes = capacidadLote;
+                capacidadLote = capacidadTomada;
+                cantidad = cantidadPendientes;
+                cantidadPendientes = 0;
+                enVuelo = cantidad;
+            }
+            procesarLote(lote, cantidad, buffer, capacidadBuffer);
+        }
+        delete[] lote;
+        delete[] buffer;
+    }
+
+    void encolarPedido(const Pedido& pedido) {
+        {
+            lock_guard<mutex> guardia(cerrojo);
+            agregar(pendientes, cantidadPendientes, capacidadPendientes, pedido);
+        }
+        hayTrabajo.notify_one();
+    }
+
+public:
+    // Toma un archivo ya abierto (lectura y escritura) y lo borra al terminar;
+    // capacidad en unidades (paginas simuladas)
+    AreaIntercambio(FILE* _archivo, const char* _ruta, unsigned int capacidad, unsigned int _bytesPorUnidad)
+        : archivo(_archivo), bytesPorUnidad(_bytesPorUnidad), ranuras(capacidad), secuencia(0) {
+        ruta = new char[strlen(_ruta) + 1];
+        strcpy(ruta, _ruta);
+        capacidadPendientes = 64;
+        pendientes = new Pedido[capacidadPendientes];
+        cantidadPendientes = 0;
+        capacidadCompletados = 64;
+        completados = new Completado[capacidadCompletados];
+        cantidadCompletados = 0;
+        enVuelo = 0;
+        terminar = false;
+        memset(&estadisticas, 0, sizeof(estadisticas));
+        hilo = thread(&AreaIntercambio::atender, this);
+    }
+
+    unsigned int capacidadTotal() const {
+        return ranuras.capacidadTotal();
+    }
+
+    unsigned int unidadesLibres() const {
+        return ranuras.libres();
+    }
+
+    // Encola la escritura de la imagen. Retorna la ranura usada,
+    // o SIN_RANURA si el archivo esta lleno (no se escribe nada)
+    unsigned int escribir(unsigned int unidades, unsigned long long firma) {
+        unsigned int ranura = ranuras.reservar(unidades);
+        if (ranura == SIN_RANURA) return SIN_RANURA;
+
+        Pedido pedido;
+        pedido.escritura = true;
+        pedido.ranura = ranura;
+        pedido.unidades = unidades;
+        pedido.firma = firma;
+        pedido.secuencia = secuencia++;
+        pedido.etiqueta = NULL;
+        pedido.encolado = chrono::steady_clock::now();
+        encolarPedido(pedido);
+        return ranura;
+    }
+
+    // Encola la lectura de una ranura; el resultado se obtiene con recoger()
+    void leer(unsigned int ranura, unsigned int unidades, unsigned long long firma, void* etiqueta) {
+        Pedido pedido;
+        pedido.escritura = false;
+        pedido.ranura = ranura;
+        pedido.unidades = unidades;
+        pedido.firma = firma;
+        pedido.secuencia = secuencia++;
+        pedido.etiqueta = etiqueta;
+        pedido.encolado = chrono::steady_clock::now();
+        encolarPedido(pedido);
+    }
+
+    // Libera la ranura (las escrituras pendientes sobre ella siguen en orden)
+    void liberar(unsigned int ranura) {
+        ranuras.liberar(ranura);
+    }
+
+    // Copia hasta maximo lecturas terminadas en salida sin bloquear
+    int recoger(Completado* salida, int maximo) {
+        lock_guard<mutex> guardia(cerrojo);
+        int cantidad = (cantidadCompletados < maximo) ? cantidadCompletados : maximo;
+        for (int i = 0; i < cantidad; i++) salida[i] = completados[i];
+        for (int i = cantidad; i < cantidadCompletados; i++) completados[i - cantidad] = completados[i];
+        cantidadCompletados -= cantidad;
+        return cantidad;
+    }
+
+    // Bloquea hasta que el hilo de E/S vacie la cola (solo fuera del bucle del planificador)
+    void esperar() {
+        unique_lock<mutex> guardia(cerrojo);
+        while (cantidadPendientes > 0 || enVuelo > 0) loteTerminado.wait(guardia);
+    }
+
+    EstadisticasIntercambio obtenerEstadisticas() {
+        lock_guard<mutex> guardia(cerrojo);
+        return estadisticas;
+    }
+
+    ~AreaIntercambio() {
+        {
+            lock_guard<mutex> guardia(cerrojo);
+            terminar = true;
+        }
+        hayTrabajo.notify_one();
+        hilo.join();
+        fclose(archivo);
+        remove(ruta);
+        delete[] ruta;
+        delete[] pendientes;
+        delete[] completados;
+    }
+};
+
+// ============================================
+// GESTOR DE MEMORIA: Implementación con estructura de pila (LIFO)
+// Permite asignar y liberar bloques de memoria para procesos.
+// Los tamaños son bytes de 64 bits. Los pedidos chicos se sirven de
+// slabs por clase de tamaño; los demás ocupan un rango de páginas
+// del asignador buddy. La pila solo conserva el orden de asignacion
+// para el POP. La compactacion mueve bloques para juntar la memoria
+// libre, de una vez o de a poco en cada tick del planificador.
+// Con el area de intercambio habilitada, cuando el buddy no tiene
+// lugar se desalojan los bloques usados hace mas tiempo (lista LRU
+// de bloques residentes) y vuelven cuando su proceso va a ejecutarse.
+// ============================================
+
+// Costo acumulado de las compactaciones (las pausas incluyen la copia)
+struct EstadisticasCompactacion {
+    long long compactaciones;       // Iniciadas (totales o incrementales)
+    long long pasos;                // Ticks con trabajo incremental
+    unsigned long long bytesMovidos;
+    long long bloquesMovidos;
+    long long regionesUnidas;       // Regiones vaciadas y unidas con su compañero
+    long long abortadas;            // Regiones abandonadas porque la memoria cambio
+    double segundos;
+    double pausaMaxima;             // Compactacion total o tick mas largo
+};
+
+// Donde esta el contenido de un bloque
+enum UbicacionBloque {
+    EN_MEMORIA,         // Tiene direccion (en el buddy o en un slab)
+    EN_INTERCAMBIO,     // Solo en el archivo de intercambio
+    ENTRANDO,           // Direccion reservada, lectura pendiente
+    DESCARTADO          // Liberado con la lectura pendiente (se recicla al terminar)
+};
+
+class GestorMemoria : public ResidenciaProcesos, public ObservadorProcesos {
+public:
+    static const unsigned long long TAMANIO_PAGINA = 4096;  // Unidad del buddy
+
+private:
+    // ============================================
+    // ESTRUCTURA BLOQUE DE MEMORIA
+    // Representa un bloque de memoria asignado a un proceso
+    // ============================================
+    struct BloqueMemoria {
+        HandleProceso proceso;      // Handle del proceso dueño (detecta procesos eliminados)
+        int idProceso;              // ID único del proceso dueño del bloque
+        char nombreProceso[50];     // Nombre descriptivo del proceso
+        unsigned long long tamanio;     // Tamaño solicitado en bytes
+        unsigned long long direccion;   // Dirección base en bytes (SIN_DIRECCION si está en intercambio)
+        BloqueMemoria* siguiente;   // Puntero al siguiente bloque en la pila (más antiguo)
+        BloqueMemoria* anterior;    // Bloque apilado justo encima (más reciente)
+        BloqueMemoria* siguienteDelProceso;     // Lista de bloques del mismo proceso
+        BloqueMemoria* anteriorDelProceso;
+        BloqueMemoria* menosReciente;   // Lista LRU de bloques residentes
+        BloqueMemoria* masReciente;
+        unsigned char ubicacion;        // UbicacionBloque
+        bool enSlab;                    // Objeto chico servido por el asignador slab
+        unsigned int ranura;            // Posicion en el area de intercambio
+        unsigned long long firma;       // Contenido simulado (se verifica al volver)
+        
+        // ============================================
+        // CONSTRUCTOR DEL BLOQUE DE MEMORIA
+        // Inicializa un nuevo bloque con los datos del proceso
+        // ============================================
+        BloqueMemoria(HandleProceso _proceso, int _id, const char* _nombre, unsigned long long _tamanio,
+                      unsigned long long _direccion, bool _enSlab) {
+            proceso = _proceso;
+            idProceso = _id;
+            // Copia segura del nombre del proceso
+            strncpy(nombreProceso, _nombre, 49);
+            nombreProceso[49] = '\0';  // Asegura terminación de cadena
+            tamanio = _tamanio;
+            direccion = _direccion;
+            siguiente = NULL;  // Inicialmente no apunta a ningún bloque
+            anterior = NULL;
+            siguienteDelProceso = NULL;
+            anteriorDelProceso = NULL;
+            menosReciente = NULL;
+            masReciente = NULL;
+            ubicacion = EN_MEMORIA;
+            enSlab = _enSlab;
+            ranura = AreaIntercambio::SIN_RANURA;
+            firma = 0;
+        }
+    };
+
+    // ============================================
+    // CONTABILIDAD POR PROCESO
+    // Bloques de cada ID (del más reciente al más antiguo) y su total,
+    // para consultar en O(1) y liberar en O(k) sin recorrer la pila.
+    // La cuenta guarda el handle del dueño: con IDs reciclados el mismo
+    // ID puede pasar a otro proceso (ver cuentaDe).
+    // ============================================
+    struct CuentaProceso {
+        HandleProceso dueno;        // Proceso al que pertenecen los bloques
+        BloqueMemoria* bloques;     // Bloque más reciente del proceso
+        unsigned long long total;   // Suma de los tamaños solicitados (bytes)
+        int cantidadBloques;
+    };
+    
+    // ============================================
+    // VARIABLES PRIVADAS DEL GESTOR
+    // Todos los tamaños en bytes
+    // ============================================
+    GestorProcesos& gestor;     // Tabla de procesos compartida (resuelve handles)
+    PoolNodos<BloqueMemoria> poolBloques;   // Arena de bloques (sin malloc por operación)
+    BloqueMemoria* tope;        // Puntero al último bloque asignado (top de la pila)
+    unsigned long long memoriaTotal;        // Capacidad (multiplo de la página)
+    unsigned long long memoriaUsada;        // Ocupada en el buddy (incluye redondeo y slabs)
+    unsigned long long memoriaSolicitada;   // Suma de los tamaños pedidos residentes
+    AsignadorBuddy buddy;       // Direcciones de cada bloque (unidad: una página)
+    AsignadorSlab<GestorMemoria> slab;      // Pedidos chicos por clase de tamaño
+    TablaHashPorID<CuentaProceso> porProceso;   // Solo IDs con al menos un bloque
+
+    // Area de intercambio (NULL = deshabilitada). Solo se desalojan
+    // bloques del buddy: los slabs mezclan objetos de varios procesos.
+    static const unsigned int BYTES_POR_PAGINA_SIMULADA = TAMANIO_PAGINA / 16;
+    static const unsigned long long MAXIMO_INTERCAMBIO = 64 * BYTES_GB;
+    AreaIntercambio* intercambio;
+    BloqueMemoria* usoReciente;     // Extremos de la lista LRU de residentes
+    BloqueMemoria* usoAntiguo;
+    unsigned long long memoriaEnIntercambio;    // Solicitado por bloques fuera del buddy
+    int bloquesEnIntercambio;       // Bloques con ranura en el archivo
+    int cargasPendientes;
+    unsigned long long memoriaCargando;         // Reservado por lecturas en curso
+    unsigned long long contadorFirmas;
+    long long desalojos;
+    long long cargas;
+
+    // Compactacion. Dos bloques libres del mismo orden k no se pueden
+    // unir; si el compañero (buddy) de uno solo tiene bloques movibles,
+    // se copian a las mismas posiciones dentro del otro bloque libre y
+    // la region vaciada se une con su compañero en un bloque de orden
+    // k + 1. Se avanza de los ordenes chicos a los grandes; al final
+    // queda a lo sumo un bloque libre por orden (salvo lo que fijan los
+    // slabs y las lecturas en curso, que no se mueven). Un bloque
+    // grande se copia en tramos: mientras tanto sigue en su lugar y el
+    // destino ya esta reservado.
+    static const unsigned long long COSTO_EXAMEN = 64;  // Trabajo por bloque recorrido (bytes)
+    static const int MAX_CANDIDATOS = 32;           // Regiones evaluadas por eleccion
+    BloqueMemoria** bloqueEnPagina; // Bloque del buddy que empieza en cada pagina (no slabs)
+    bool compactando;
+    bool incremental;               // Avanza en finDeTick (si no, ya termino de una vez)
+    unsigned long long presupuestoPorTick;
+    int ordenCompactacion;          // Orden cuyos bloques libres se estan juntando
+    unsigned int regionOrigen;      // Region que se vacia (SIN_BLOQUE = ninguna)
+    unsigned int regionDestino;     // Bloque libre que recibe su contenido
+    BloqueMemoria* enMovimiento;    // Bloque a medio copiar (o NULL)
+    unsigned int paginaDestino;
+    unsigned long long bytesCopiados;
+    char* bufferCopia;              // Se crea con la primera compactacion
+    EstadisticasCompactacion compactacion;
+
+    friend class AsignadorSlab<GestorMemoria>;
+
+    static unsigned int paginasPara(unsigned long long bytes) {
+        return (unsigned int)((bytes + TAMANIO_PAGINA - 1) / TAMANIO_PAGINA);
+    }
+
+    unsigned long long bytesBloqueBuddy(unsigned long long direccion) const {
+        return buddy.tamanioBloque((unsigned int)(direccion / TAMANIO_PAGINA)) * TAMANIO_PAGINA;
+    }
+
+    void liberarEnBuddy(unsigned long long direccion) {
+        memoriaUsada -= bytesBloqueBuddy(direccion);
+        buddy.liberar((unsigned int)(direccion / TAMANIO_PAGINA));
+    }
+    
+    // Cuenta de bloques del proceso que hoy tiene el ID (NULL si no hay).
+    // Al eliminar un proceso sus bloques se liberan (procesoEliminado);
+    // si aun asi quedan bloques de un dueño anterior con el mismo ID
+    // (gestor sin lugar para otro observador), salen del indice para
+    // que el proceso nuevo no los herede y solo se alcanzan por la pila.
+    CuentaProceso* cuentaDe(int idProceso) {
+        CuentaProceso* cuenta = porProceso.buscar(idProceso);
+        if (cuenta == NULL) return NULL;
+        HandleProceso vigente = gestor.buscarHandle(idProceso);
+        if (vigente.esNulo() || vigente == cuenta->dueno) return cuenta;
+
+        BloqueMemoria* b = cuenta->bloques;
+        while (b != NULL) {
+            BloqueMemoria* siguienteBloque = b->siguienteDelProceso;
+            b->siguienteDelProceso = NULL;
+            b->anteriorDelProceso = NULL;
+            b = siguienteBloque;
+        }
+        porProceso.eliminar(idProceso);
+        return NULL;
+    }
+
+    // Desengancha el bloque de la pila y de la lista de su proceso (O(1))
+    void desenlazar(BloqueMemoria* bloque) {
+        if (bloque->anterior == NULL) tope = bloque->siguiente;
+        else bloque->anterior->siguiente = bloque->siguiente;
+        if (bloque->siguiente != NULL) bloque->siguiente->anterior = bloque->anterior;
+
+        CuentaProceso* cuenta = porProceso.buscar(bloque->idProceso);
+        if (cuenta == NULL || cuenta->dueno != bloque->proceso) return;    // Huerfano
+        if (bloque->anteriorDelProceso == NULL) cuenta->bloques = bloque->siguienteDelProceso;
+        else bloque->anteriorDelProceso->siguienteDelProceso = bloque->siguienteDelProceso;
+        if (bloque->siguienteDelProceso != NULL) {
+            bloque->siguienteDelProceso->anteriorDelProceso = bloque->anteriorDelProceso;
+        }
+        cuenta->total -= bloque->tamanio;
+        if (--cuenta->cantidadBloques == 0) porProceso.eliminar(bloque->idProceso);
+    }
+
+    // Pasa un bloque residente al frente de la lista LRU
+    void marcarUso(BloqueMemoria* bloque) {
+        if (bloque == usoReciente) return;
+        if (bloque->masReciente != NULL) quitarDeUso(bloque);
+        bloque->menosReciente = usoReciente;
+        bloque->masReciente = NULL;
+        if (usoReciente != NULL) usoReciente->masReciente = bloque;
+        else usoAntiguo = bloque;
+        usoReciente = bloque;
+    }
+
+    void quitarDeUso(BloqueMemoria* bloque) {
+        if (bloque->masReciente == NULL) usoReciente = bloque->menosReciente;
+        else bloque->masReciente->menosReciente = bloque->menosReciente;
+        if (bloque->menosReciente == NULL) usoAntiguo = bloque->masReciente;
+        else bloque->menosReciente->masReciente = bloque->masReciente;
+        bloque->menosReciente = NULL;
+        bloque->masReciente = NULL;
+    }
+
+    // Envia al archivo el bloque residente usado hace mas tiempo que no
+    // sea del proceso excluido. Solo encola la imagen: no espera al disco.
+    bool desalojarUno(int idExcluido) {
+        BloqueMemoria* victima = usoAntiguo;
+        while (victima != NULL && victima->idProceso == idExcluido) victima = victima->masReciente;
+        if (victima == NULL) return false;
+        unsigned int ranura = intercambio->escribir(paginasPara(victima->tamanio), victima->firma);
+        if (ranura == AreaIntercambio::SIN_RANURA) return false;
+
+        if (victima == enMovimiento) cancelarMovimiento();
+        quitarDeUso(victima);
+        memoriaSolicitada -= victima->tamanio;
+        bloqueEnPagina[victima->direccion / TAMANIO_PAGINA] = NULL;
+        liberarEnBuddy(victima->direccion);
+        victima->direccion = SIN_DIRECCION;
+        victima->ranura = ranura;
+        victima->ubicacion = EN_INTERCAMBIO;
+        memoriaEnIntercambio += victima->tamanio;
+        bloquesEnIntercambio++;
+        desalojos++;
+        return true;
+    }
+
+    // true si desalojando todo lo posible quedaria libre alguna region
+    // alineada de 2^orden paginas: alguna que no toque un bloque fijo
+    // (slabs, lecturas en curso o bloques del proceso excluido). Evita
+    // vaciar la memoria para un pedido que igual no va a entrar.
+    bool cabeDesalojando(int orden, int idExcluido) {
+        unsigned long long regiones = (memoriaTotal / TAMANIO_PAGINA) >> orden;
+        if (regiones == 0) return false;
+        unsigned char* fija = new unsigned char[regiones];
+        memset(fija, 0, regiones);
+        for (BloqueMemoria* b = tope; b != NULL; b = b->siguiente) {
+            if (b->ubicacion == EN_INTERCAMBIO) continue;
+            if (b->ubicacion == EN_MEMORIA && !b->enSlab && b->idProceso != idExcluido) continue;
+            unsigned long long desde = b->direccion / TAMANIO_PAGINA;
+            unsigned long long hasta = desde + (b->enSlab ? AsignadorSlab<GestorMemoria>::TAMANIO_SLAB / TAMANIO_PAGINA
+                                                           : bytesBloqueBuddy(b->direccion) / TAMANIO_PAGINA);
+            for (unsigned long long r = desde >> orden; r < regiones && (r << orden) < hasta; r++) fija[r] = 1;
+        }
+        bool cabe = false;
+        for (unsigned long long r = 0; r < regiones && !cabe; r++) cabe = (fija[r] == 0);
+        delete[] fija;
+        return cabe;
+    }
+
+    // Reserva en el buddy desalojando bloques si hace falta; retorna la
+    // direccion en bytes o SIN_DIRECCION. Antes de desalojar se
+    // devuelven los slabs vacios de reserva.
+    unsigned long long reservarDireccion(unsigned long long bytes, int idExcluido) {
+        if (bytes == 0 || bytes > memoriaTotal) return SIN_DIRECCION;
+        unsigned int paginas = paginasPara(bytes);
+        unsigned int pagina = buddy.reservar(paginas);
+        if (pagina == AsignadorBuddy::SIN_BLOQUE) {
+            slab.recortar();
+            pagina = buddy.reservar(paginas);
+        }
+        if (pagina == AsignadorBuddy::SIN_BLOQUE && intercambio != NULL
+            && !cabeDesalojando(AsignadorBuddy::ordenPara(paginas), idExcluido)) {
+            return SIN_DIRECCION;
+        }
+        while (pagina == AsignadorBuddy::SIN_BLOQUE && intercambio != NULL && desalojarUno(idExcluido)) {
+            pagina = buddy.reservar(paginas);
+        }
+        if (pagina == AsignadorBuddy::SIN_BLOQUE) return SIN_DIRECCION;
+        memoriaUsada += (unsigned long long)buddy.tamanioBloque(pagina) * TAMANIO_PAGINA;
+        return (unsigned long long)pagina * TAMANIO_PAGINA;
+    }
+
+    // Proveedor del asignador slab: un bloque buddy alineado a su tamaño
+    unsigned long long reservarSlab(unsigned long long bytes) {
+        return reservarDireccion(bytes, -1);
+    }
+
+    void liberarSlab(unsigned long long direccion) {
+        liberarEnBuddy(direccion);
+    }
+
+    // Reserva lugar para un bloque desalojado y encola su lectura. Las
+    // lecturas en curso no se pueden desalojar, asi que se limitan a un
+    // cuarto de la memoria: si no, muchas cargas a la vez empujarian
+    // afuera a los procesos que si estan ejecutando.
+    bool iniciarCarga(BloqueMemoria* bloque) {
+        if (memoriaCargando > 0 && memoriaCargando + bloque->tamanio > memoriaTotal / 4) return false;
+        unsigned long long direccion = reservarDireccion(bloque->tamanio, bloque->idProceso);
+        if (direccion == SIN_DIRECCION) return false;
+        bloque->direccion = direccion;
+        bloqueEnPagina[direccion / TAMANIO_PAGINA] = bloque;
+        bloque->ubicacion = ENTRANDO;
+        memoriaSolicitada += bloque->tamanio;
+        memoriaEnIntercambio -= bloque->tamanio;
+        intercambio->leer(bloque->ranura, paginasPara(bloque->tamanio), bloque->firma, bloque);
+        cargasPendientes++;
+        memoriaCargando += bloque->tamanio;
+        return true;
+    }
+
+    // El contenido es simulado, pero la copia se hace igual sobre un
+    // buffer de trabajo para que las pausas medidas incluyan su costo
+    static const unsigned long long TRAMO_COPIA = 1 << 20;
+
+    void copiarSimulado(unsigned long long bytes) {
+        while (bytes > 0) {
+            size_t n = (size_t)(bytes < TRAMO_COPIA ? bytes : TRAMO_COPIA);
+            memcpy(bufferCopia + TRAMO_COPIA, bufferCopia, n);
+            bytes -= n;
+        }
+    }
+
+    // Abandona la copia en curso: el bloque sigue en su lugar original
+    void cancelarMovimiento() {
+        memoriaUsada -= (unsigned long long)buddy.tamanioBloque(paginaDestino) * TAMANIO_PAGINA;
+        buddy.liberar(paginaDestino);
+        enMovimiento = NULL;
+    }
+
+    // Copia terminada: el bloque pasa al destino y libera su lugar viejo
+    void terminarMovimiento() {
+        BloqueMemoria* bloque = enMovimiento;
+        bloqueEnPagina[bloque->direccion / TAMANIO_PAGINA] = NULL;
+        liberarEnBuddy(bloque->direccion);
+        bloque->direccion = (unsigned long long)paginaDestino * TAMANIO_PAGINA;
+        bloqueEnPagina[paginaDestino] = bloque;
+        compactacion.bloquesMovidos++;
+        enMovimiento = NULL;
+    }
+
+    // Recorre la region alineada [inicio, inicio + 2^orden) bloque por
+    // bloque. Retorna los bytes a copiar para vaciarla, o -1 si tiene
+    // algo que no se puede mover (slab, lectura en curso, destino de
+    // una copia). En primera deja el primer bloque ocupado. Deja de
+    // recorrer apenas el costo supera 'tope' (si no es negativo).
+    long long examinarRegion(unsigned int inicio, int orden, unsigned int& primera,
+                             unsigned long long& trabajo, long long tope = -1) {
+        unsigned int fin = inicio + (1u << orden);
+        long long costo = 0;
+        primera = AsignadorBuddy::SIN_BLOQUE;
+        for (unsigned int p = inicio; p < fin; ) {
+            trabajo += COSTO_EXAMEN;
+            unsigned int tamanio = buddy.tamanioBloque(p);
+            if (buddy.estaLibre(p)) {
+                p += tamanio;
+                continue;
+            }
+            BloqueMemoria* bloque = bloqueEnPagina[p];
+            if (bloque == NULL || bloque->ubicacion != EN_MEMORIA || tamanio > fin - p) return -1;
+            if (primera == AsignadorBuddy::SIN_BLOQUE) primera = p;
+            costo += (long long)bloque->tamanio;
+            if (tope >= 0 && costo > tope) return costo;
+            p += tamanio;
+        }
+        return costo;
+    }
+
+    // Elige, entre los primeros bloques libres del orden, aquel cuyo
+    // compañero es mas barato de vaciar; el destino es otro libre del
+    // mismo orden. Deja de buscar si se agota el presupuesto y ya hay
+    // uno que sirve. false si ninguno sirve.
+    bool elegirRegion(int orden, unsigned long long& trabajo, unsigned long long presupuesto) {
+        unsigned int capacidad = buddy.capacidadTotal();
+        unsigned int tamanio = 1u << orden;
+        unsigned int mejorLibre = AsignadorBuddy::SIN_BLOQUE;
+        long long mejorCosto = -1;
+        int examinados = 0;
+        for (unsigned int libre = buddy.primeroLibre(orden);
+             libre != AsignadorBuddy::SIN_BLOQUE && examinados < MAX_CANDIDATOS
+             && (mejorCosto < 0 || trabajo < presupuesto);
+             libre = buddy.siguienteLibreDe(libre), examinados++) {
+            unsigned int companero = libre ^ tamanio;
+            if (companero >= capacidad || capacidad - companero < tamanio) continue;
+            unsigned int primera;
+            long long costo = examinarRegion(companero, orden, primera, trabajo, mejorCosto);
+            if (costo >= 0 && (mejorCosto < 0 || costo < mejorCosto)) {
+                mejorCosto = costo;
+                mejorLibre = libre;
+            }
+        }
+        if (mejorCosto < 0) return false;
+        regionOrigen = mejorLibre ^ tamanio;
+        regionDestino = buddy.primeroLibre(orden);
+        if (regionDestino == mejorLibre) regionDestino = buddy.siguienteLibreDe(mejorLibre);
+        return true;
+    }
+
+    // Hace hasta 'presupuesto' bytes de trabajo (copias y recorridos)
+    void avanzarCompactacion(unsigned long long presupuesto) {
+        unsigned long long trabajo = 0;
+        while (compactando && trabajo < presupuesto) {
+            if (enMovimiento != NULL) {
+                // Continuar la copia en curso
+                unsigned long long tramo = enMovimiento->tamanio - bytesCopiados;
+                if (tramo > presupuesto - trabajo) tramo = presupuesto - trabajo;
+                copiarSimulado(tramo);
+                bytesCopiados += tramo;
+                trabajo += tramo;
+                compactacion.bytesMovidos += tramo;
+                if (bytesCopiados == enMovimiento->tamanio) terminarMovimiento();
+                continue;
+            }
+            if (regionOrigen != AsignadorBuddy::SIN_BLOQUE) {
+                // Siguiente bloque de la region; si ya no queda ninguno, se unio
+                unsigned int libre = buddy.libreQueContiene(regionOrigen);
+                if (libre != AsignadorBuddy::SIN_BLOQUE
+                    && buddy.tamanioBloque(libre) >= (1u << ordenCompactacion)) {
+                    compactacion.regionesUnidas++;
+                    regionOrigen = AsignadorBuddy::SIN_BLOQUE;
+                    continue;
+                }
+                unsigned int primera;
+                long long costo = examinarRegion(regionOrigen, ordenCompactacion, primera, trabajo);
+                unsigned int destino = regionDestino + (primera - regionOrigen);
+                if (costo <= 0 || !buddy.reservarEn(destino, __builtin_ctz(buddy.tamanioBloque(primera)))) {
+                    // La memoria cambio entre ticks: se deja este orden
+                    compactacion.abortadas++;
+                    regionOrigen = AsignadorBuddy::SIN_BLOQUE;
+                    ordenCompactacion++;
+                    continue;
+                }
+                enMovimiento = bloqueEnPagina[primera];
+                paginaDestino = destino;
+                bytesCopiados = 0;
+                memoriaUsada += (unsigned long long)buddy.tamanioBloque(destino) * TAMANIO_PAGINA;
+                continue;
+            }
+            while (ordenCompactacion < AsignadorBuddy::MAX_ORDEN
+                   && buddy.bloquesLibresDeOrden(ordenCompactacion) < 2) {
+                ordenCompactacion++;
+            }
+            if (ordenCompactacion >= AsignadorBuddy::MAX_ORDEN) {
+                compactando = false;
+            } else if (!elegirRegion(ordenCompactacion, trabajo, presupuesto)) {
+                ordenCompactacion++;
+            }
+        }
+    }
+
+    void iniciarCompactacion() {
+        if (bufferCopia == NULL) {
+            bufferCopia = new char[2 * TRAMO_COPIA];
+            memset(bufferCopia, 0x5A, 2 * TRAMO_COPIA);
+        }
+        if (!compactando) {
+            compactando = true;
+            ordenCompactacion = 0;
+            regionOrigen = AsignadorBuddy::SIN_BLOQUE;
+            compactacion.compactaciones++;
+        }
+    }
+
+public:
+    // ============================================
+    // CONSTRUCTOR DEL GESTOR DE MEMORIA
+    // La capacidad (por defecto 2 GB) se redondea hacia abajo a páginas
+    // ============================================
+    GestorMemoria(GestorProcesos& _gestor, unsigned long long capacidad = 2048 * BYTES_MB)
+        : gestor(_gestor), memoriaTotal(capacidad / TAMANIO_PAGINA * TAMANIO_PAGINA),
+          buddy((unsigned int)(capacidad / TAMANIO_PAGINA)), slab(*this, capacidad) {
+        tope = NULL;            // Pila vacía al inicio
+        memoriaUsada = 0;       // Sin memoria usada inicialmente
+        memoriaSolicitada = 0;
+        intercambio = NULL;     // Sin area de intercambio hasta habilitarla
+        usoReciente = NULL;
+        usoAntiguo = NULL;
+        memoriaEnIntercambio = 0;
+        bloquesEnIntercambio = 0;
+        cargasPendientes = 0;
+        memoriaCargando = 0;
+        contadorFirmas = 0;
+        desalojos = 0;
+        cargas = 0;
+        bloqueEnPagina = new BloqueMemoria*[memoriaTotal / TAMANIO_PAGINA];
+        for (unsigned long long i = 0; i < memoriaTotal / TAMANIO_PAGINA; i++) bloqueEnPagina[i] = NULL;
+        compactando = false;
+        incremental = false;
+        presupuestoPorTick = 0;
+        ordenCompactacion = 0;
+        regionOrigen = AsignadorBuddy::SIN_BLOQUE;
+        regionDestino = AsignadorBuddy::SIN_BLOQUE;
+        enMovimiento = NULL;
+        paginaDestino = 0;
+        bytesCopiados = 0;
+        bufferCopia = NULL;
+        memset(&compactacion, 0, sizeof(compactacion));
+        gestor.registrarObservador(this);   // Para liberar la memoria de procesos eliminados
+        char texto[32];
+        cout << "[INFO] Gestor de Memoria inicializado (Memoria total: " 
+             << formatearTamanio(memoriaTotal, texto) << ")\n";
+    }
+
+    unsigned long long capacidadTotal() const {
+        return memoriaTotal;
+    }
+
+    unsigned long long memoriaLibre() const {
+        return memoriaTotal - memoriaUsada;
+    }
+
+    unsigned long long mayorBloqueLibre() const {
+        return (unsigned long long)buddy.mayorBloqueLibre() * TAMANIO_PAGINA;
+    }
+
+    double fragmentacionExterna() const {
+        return buddy.fragmentacionExterna();
+    }
+
+    unsigned int cantidadBloquesLibres() const {
+        unsigned int total = 0;
+        for (int k = 0; k <= AsignadorBuddy::MAX_ORDEN; k++) total += buddy.bloquesLibresDeOrden(k);
+        return total;
+    }
+
+    // Mayor pedido posible: el bloque más grande que puede formar el buddy
+    unsigned long long tamanioMaximo() const {
+        unsigned long long paginas = 1;
+        while (paginas * 2 <= memoriaTotal / TAMANIO_PAGINA) paginas *= 2;
+        return paginas * TAMANIO_PAGINA;
+    }
+
+    // ============================================
+    // HABILITAR AREA DE INTERCAMBIO
+    // Crea el archivo (se borra al destruir el gestor). Cada página
+    // simulada ocupa BYTES_POR_PAGINA_SIMULADA bytes reales.
+    // Retorna false (sin dejar el archivo) si ya estaba habilitada, si
+    // el archivo no se puede crear, si no hay memoria para el area o si
+    // la capacidad no esta entre una pagina y MAXIMO_INTERCAMBIO (la
+    // contabilidad de ranuras es O(paginas)).
+    // ============================================
+    bool habilitarIntercambio(const char* ruta, unsigned long long capacidad = 8 * BYTES_GB) {
+        if (intercambio != NULL) return false;
+        if (capacidad < TAMANIO_PAGINA || capacidad > MAXIMO_INTERCAMBIO) return false;
+        FILE* archivo = fopen(ruta, "w+b");
+        if (archivo == NULL) return false;
+        intercambio = new (nothrow) AreaIntercambio(archivo, ruta, paginasPara(capacidad), BYTES_POR_PAGINA_SIMULADA);
+        if (intercambio == NULL) {
+            fclose(archivo);
+            remove(ruta);
+            return false;
+        }
+        return true;
+    }
+
+    bool intercambioHabilitado() const {
+        return intercambio != NULL;
+    }
+
+    int cantidadCargasPendientes() const {
+        return cargasPendientes;
+    }
+
+    // Aplica las lecturas terminadas por el hilo de E/S (no bloquea)
+    void procesarIntercambio() {
+        if (intercambio == NULL || cargasPendientes == 0) return;
+        AreaIntercambio::Completado listos[64];
+        int cantidad;
+        while ((cantidad = intercambio->recoger(listos, 64)) > 0) {
+            for (int i = 0; i < cantidad; i++) {
+                BloqueMemoria* bloque = (BloqueMemoria*)listos[i].etiqueta;
+                cargasPendientes--;
+                memoriaCargando -= bloque->tamanio;
+                intercambio->liberar(bloque->ranura);
+                bloque->ranura = AreaIntercambio::SIN_RANURA;
+                bloquesEnIntercambio--;
+                if (bloque->ubicacion == DESCARTADO) {
+                    poolBloques.liberar(bloque);
+                    continue;
+                }
+                // Una imagen corrupta queda contada en las estadisticas del area
+                bloque->ubicacion = EN_MEMORIA;
+                marcarUso(bloque);
+                cargas++;
+            }
+        }
+    }
+
+    // Espera al hilo de E/S y aplica lo que termino (fuera del planificador)
+    void esperarIntercambio() {
+        if (intercambio == NULL) return;
+        intercambio->esperar();
+        procesarIntercambio();
+    }
+
+    // ============================================
+    // COMPACTACION TOTAL (STOP-THE-WORLD)
+    // Junta la memoria libre de una vez; si habia una compactacion
+    // incremental en curso, la termina
+    // ============================================
+    void compactar() {
+        iniciarCompactacion();
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        incremental = false;
+        // Lo elegido en ticks anteriores pudo quedar viejo: se recorre de nuevo
+        ordenCompactacion = 0;
+        regionOrigen = AsignadorBuddy::SIN_BLOQUE;
+        avanzarCompactacion(~0ULL);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        compactacion.segundos += segundos;
+        if (segundos > compactacion.pausaMaxima) compactacion.pausaMaxima = segundos;
+    }
+
+    // ============================================
+    // COMPACTACION INCREMENTAL
+    // Cada tick del planificador hace a lo sumo 'presupuesto' bytes
+    // de trabajo (copias y recorridos) hasta terminar
+    // ============================================
+    void iniciarCompactacionIncremental(unsigned long long presupuesto) {
+        iniciarCompactacion();
+        incremental = true;
+        presupuestoPorTick = (presupuesto > 0) ? presupuesto : 1;
+    }
+
+    void finDeTick() {
+        if (!compactando || !incremental) return;
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        avanzarCompactacion(presupuestoPorTick);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        compactacion.pasos++;
+        compactacion.segundos += segundos;
+        if (segundos > compactacion.pausaMaxima) compactacion.pausaMaxima = segundos;
+    }
+
+    bool compactacionEnCurso() const {
+        return compactando;
+    }
+
+    EstadisticasCompactacion estadisticasCompactacion() const {
+        return compactacion;
+    }
+
+    // ============================================
+    // PREPARAR EJECUCION (RESIDENCIA)
+    // true si toda la memoria del proceso esta cargada. Si no, pide
+    // de una vez todos sus bloques desalojados (lectura anticipada:
+    // van en el mismo lote y las ranuras contiguas se leen juntas).
+    // ============================================
+    bool prepararEjecucion(HandleProceso h) {
+        if (intercambio == NULL) return true;   // Sin intercambio todo esta residente
+        procesarIntercambio();
+        Proceso p = gestor.resolver(h);
+        if (!p.existe()) return true;
+        CuentaProceso* cuenta = cuentaDe(p.id());
+        if (cuenta == NULL || cuenta->dueno != h) return true;
+
+        bool residente = true;
+        for (BloqueMemoria* b = cuenta->bloques; b != NULL; b = b->siguienteDelProceso) {
+            if (b->ubicacion == EN_MEMORIA) {
+                if (!b->enSlab) marcarUso(b);
+                continue;
+            }
+            residente = false;
+            if (b->ubicacion == EN_INTERCAMBIO) iniciarCarga(b);
+        }
+        return residente;
+    }
+    
+    // ============================================
+    // RESERVAR MEMORIA SIN INTERACCIÓN (PUSH)
+    // Agrega un bloque adicional sin preguntar ni mostrar mensajes.
+    // Hasta AsignadorSlab::MAX_OBJETO bytes se sirve de un slab en
+    // O(1); lo demás se redondea a páginas en el buddy.
+    // Retorna false si el proceso no existe o no hay lugar
+    // ============================================
+    bool reservar(HandleProceso proceso, unsigned long long tamanio) {
+        Proceso p = gestor.resolver(proceso);
+        if (!p.existe() || tamanio == 0) {
+            return false;
+        }
+        bool pequenio = AsignadorSlab<GestorMemoria>::esPequenio(tamanio);
+        unsigned long long direccion = pequenio ? slab.reservar(tamanio)
+                                                : reservarDireccion(tamanio, p.id());
+        if (direccion == SIN_DIRECCION) {
+            return false;
+        }
+        BloqueMemoria* nuevo = new (poolBloques.reservar())
+            BloqueMemoria(proceso, p.id(), p.nombre(), tamanio, direccion, pequenio);
+        if (!pequenio) bloqueEnPagina[direccion / TAMANIO_PAGINA] = nuevo;
+        nuevo->firma = ((unsigned long long)p.id() << 32) ^ ++contadorFirmas;
+        if (intercambio != NULL && !pequenio) marcarUso(nuevo);
+        nuevo->siguiente = tope;    // El nuevo bloque apunta al anterior tope
+        if (tope != NULL) tope->anterior = nuevo;
+        tope = nuevo;               // El nuevo bloque se convierte en el tope
+
+        // Agregar al frente de la lista del proceso
+        CuentaProceso* cuenta = cuentaDe(nuevo->idProceso);
+        if (cuenta == NULL) {
+            CuentaProceso vacia = {proceso, NULL, 0, 0};
+            porProceso.insertar(nuevo->idProceso, vacia);
+            cuenta = porProceso.buscar(nuevo->idProceso);
+        }
+        nuevo->siguienteDelProceso = cuenta->bloques;
+        if (cuenta->bloques != NULL) cuenta->bloques->anteriorDelProceso = nuevo;
+        cuenta->bloques = nuevo;
+        cuenta->total += tamanio;
+        cuenta->cantidadBloques++;
+        memoriaSolicitada += tamanio;
+        return true;
+    }
+
+    // Saca el bloque de la pila y de su proceso y devuelve su lugar al
+    // slab, al buddy o al area de intercambio. Si hay una lectura en
+    // curso, el bloque se recicla cuando esta termine.
+    void devolverBloque(BloqueMemoria* bloque) {
+        desenlazar(bloque);
+        if (bloque->enSlab) {
+            slab.liberar(bloque->direccion, bloque->tamanio);
+            memoriaSolicitada -= bloque->tamanio;
+            poolBloques.liberar(bloque);
+            return;
+        }
+        if (bloque->ubicacion == EN_INTERCAMBIO) {
+            intercambio->liberar(bloque->ranura);
+            memoriaEnIntercambio -= bloque->tamanio;
+            bloquesEnIntercambio--;
+            poolBloques.liberar(bloque);
+            return;
+        }
+        if (bloque == enMovimiento) cancelarMovimiento();
+        if (intercambio != NULL && bloque->ubicacion == EN_MEMORIA) quitarDeUso(bloque);
+        memoriaSolicitada -= bloque->tamanio;
+        bloqueEnPagina[bloque->direccion / TAMANIO_PAGINA] = NULL;
+        liberarEnBuddy(bloque->direccion);
+        if (bloque->ubicacion == ENTRANDO) {
+            bloque->ubicacion = DESCARTADO;
+            return;
+        }
+        poolBloques.liberar(bloque);
+    }
+    
+    // ============================================
+    // QUITAR BLOQUE POR ID SIN MENSAJES
+    // Quita el bloque más reciente del proceso en O(1)
+    // Retorna el tamaño liberado, o -1 si el proceso no tiene bloques
+    // Si nombre no es NULL, copia ahí el nombre del proceso
+    // ============================================
+    long long quitarPorID(int idProceso, char* nombre = NULL) {
+        CuentaProceso* cuenta = cuentaDe(idProceso);
+        if (cuenta == NULL) return -1;
+        
+        BloqueMemoria* actual = cuenta->bloques;
+        long long tamanio = (long long)actual->tamanio;
+        if (nombre != NULL) strcpy(nombre, actual->nombreProceso);
+        devolverBloque(actual);
+        return tamanio;
+    }
+    
+    // ============================================
+    // QUITAR TODOS LOS BLOQUES DE UN PROCESO SIN MENSAJES
+    // O(k) con k = bloques del proceso, sin importar la altura de la pila
+    // Retorna el total liberado, o -1 si el proceso no tiene bloques
+    // ============================================
+    long long quitarTodosDe(int idProceso, char* nombre = NULL, int* bloques = NULL) {
+        CuentaProceso* cuenta = cuentaDe(idProceso);
+        if (cuenta == NULL) return -1;
+        
+        long long total = (long long)cuenta->total;
+        if (bloques != NULL) *bloques = cuenta->cantidadBloques;
+        if (nombre != NULL) strcpy(nombre, cuenta->bloques->nombreProceso);
+        // Al quitar el último bloque la cuenta desaparece del índice
+        BloqueMemoria* actual = cuenta->bloques;
+        while (actual != NULL) {
+            BloqueMemoria* siguienteBloque = actual->siguienteDelProceso;
+            devolverBloque(actual);
+            actual = siguienteBloque;
+        }
+        return total;
+    }
+
+    // ============================================
+    // AVISOS DEL GESTOR DE PROCESOS
+    // Al eliminarse un proceso se devuelven sus bloques en O(k), para
+    // que no queden huerfanos debajo del tope de la pila
+    // ============================================
+    void procesoEliminado(HandleProceso h, int id) {
+        CuentaProceso* cuenta = porProceso.buscar(id);
+        if (cuenta == NULL || cuenta->dueno != h) return;
+        BloqueMemoria* actual = cuenta->bloques;
+        while (actual != NULL) {
+            BloqueMemoria* siguienteBloque = actual->siguienteDelProceso;
+            devolverBloque(actual);
+            actual = siguienteBloque;
+        }
+    }
+
+    void prioridadCambiada(HandleProceso, int) {}   // La memoria no depende de la prioridad
+    
+    // ============================================
+    // MEMORIA DE UN PROCESO (O(1))
+    // Retorna los bytes solicitados que tiene el proceso (0 si ninguno)
+    // ============================================
+    unsigned long long memoriaDeProceso(int idProceso, int* bloques = NULL) {
+        CuentaProceso* cuenta = cuentaDe(idProceso);
+        if (bloques != NULL) *bloques = (cuenta == NULL) ? 0 : cuenta->cantidadBloques;
+        return (cuenta == NULL) ? 0 : cuenta->total;
+    }
+    
+    // ============================================
+    // QUITAR BLOQUE DEL TOPE SIN MENSAJES (POP)
+    // Retorna el tamaño liberado, o -1 si la pila está vacía
+    // ============================================
+    long long quitarTope(int* idProceso = NULL, char* nombre = NULL) {
+        if (tope == NULL) return -1;
+        
+        BloqueMemoria* bloqueALiberar = tope;
+        long long tamanio = (long long)bloqueALiberar->tamanio;
+        if (idProceso != NULL) *idProceso = bloqueALiberar->idProceso;
+        if (nombre != NULL) strcpy(nombre, bloqueALiberar->nombreProceso);
+        
+        devolverBloque(bloqueALiberar);     // El siguiente bloque pasa a ser el tope
+        return tamanio;
+    }
+    
+    // ============================================
+    // ASIGNAR MEMORIA A UN PROCESO (OPERACIÓN PUSH)
+    // Agrega un nuevo bloque de memoria al tope de la pila
+    // ============================================
+    void asignarMemoria(HandleProceso proceso, unsigned long long tamanio) {
+        // El proceso pudo haber sido eliminado desde que se obtuvo el handle
+        Proceso p = gestor.resolver(proceso);
+        if (!p.existe()) {
+            cout << "\n[ERROR] El proceso ya no existe.\n";
+            return;
+        }
+        int idProceso = p.id();
+        char nombreProceso[50];
+        strcpy(nombreProceso, p.nombre());
+
+        // ============================================
+        // VERIFICAR SI EL PROCESO YA TIENE MEMORIA
+        // ============================================
+        int bloquesExistentes;
+        unsigned long long memoriaExistente = memoriaDeProceso(idProceso, &bloquesExistentes);
+        char texto[32], textoPedido[32];
+        formatearTamanio(tamanio, textoPedido);
+        
+        if (bloquesExistentes > 0) {
+            // El proceso ya tiene memoria asignada - ofrecer opciones
+            cout << "\n[AVISO] El proceso '" << nombreProceso 
+                 << "' ya tiene " << formatearTamanio(memoriaExistente, texto) << " asignados en "
+                 << bloquesExistentes << " bloque(s).\n";
+            cout << "\nOpciones:\n";
+            cout << "1. Reemplazar (liberar " << texto 
+                 << " y asignar " << textoPedido << ")\n";
+            cout << "2. Agregar bloque adicional (total: " 
+                 << formatearTamanio(memoriaExistente + tamanio, texto) << ")\n";
+            cout << "3. Cancelar operacion\n";
+            cout << "Seleccione una opcion: ";
+            
+            int opcion;
+            cin >> opcion;
+            
+            // Validar entrada del usuario
+            if (cin.fail()) {
+                cin.clear();
+                cin.ignore(1000, '\n');
+                cout << "\n[ERROR] Opcion invalida. Operacion cancelada.\n";
+                return;
+            }
+            cin.ignore(1000, '\n');
+            
+            if (opcion == 1) {
+                // REEMPLAZAR: Liberar todos los bloques anteriores y asignar nuevo
+                liberarPorID(idProceso);
+                cout << "\n[INFO] Bloques anteriores liberados. Asignando nuevo bloque...\n";
+            } else if (opcion == 2) {
+                // AGREGAR: Continuar con asignación normal (permite múltiples bloques)
+                cout << "\n[INFO] Agregando bloque adicional...\n";
+            } else {
+                cout << "\n[INFO] Operacion cancelada.\n";
+                return;
+            }
+        }
+        
+        // ============================================
+        // CREAR Y AGREGAR NUEVO BLOQUE (OPERACIÓN PUSH)
+        // El buddy redondea a páginas en potencia de 2 y puede fallar por
+        // fragmentación aunque la memoria libre total alcance; los
+        // pedidos chicos se redondean a su clase dentro de un slab
+        // ============================================
+        bool pequenio = AsignadorSlab<GestorMemoria>::esPequenio(tamanio);
+        unsigned long long bloquePedido = pequenio ? slab.tamanioClase(tamanio)
+            : ((unsigned long long)1 << AsignadorBuddy::ordenPara(paginasPara(tamanio))) * TAMANIO_PAGINA;
+        char textoBloque[32];
+        formatearTamanio(bloquePedido, textoBloque);
+        long long desalojosAntes = desalojos;
+        if (!reservar(proceso, tamanio)) {
+            cout << "\n[ERROR] Memoria insuficiente. Disponible: " 
+                 << formatearTamanio(memoriaTotal - memoriaUsada, texto) << ", Solicitado: " 
+                 << textoPedido << " (bloque de " << textoBloque << "), ";
+            cout << "Mayor bloque libre: " 
+                 << formatearTamanio(buddy.mayorBloqueLibre() * TAMANIO_PAGINA, texto) << "\n";
+            return;
+        }
+        
+        // Confirmar asignación exitosa
+        cout << "\n[OK] Memoria asignada correctamente:\n";
+        cout << "     Proceso ID: " << idProceso << " (" << nombreProceso << ")\n";
+        sprintf(texto, "0x%llx", tope->direccion);
+        cout << "     Tamanio: " << textoPedido << " (" << (pequenio ? "objeto de " : "bloque de ")
+             << textoBloque << " en la direccion " << texto << ")\n";
+        cout << "     Memoria disponible: " << formatearTamanio(memoriaTotal - memoriaUsada, texto) << "\n";
+        if (desalojos > desalojosAntes) {
+            cout << "     Bloques enviados al area de intercambio: " << (desalojos - desalojosAntes) << "\n";
+        }
+    }
+    
+    // ============================================
+    // LIBERAR MEMORIA POR ID DE PROCESO
+    // Libera todos los bloques del proceso en O(k)
+    // ============================================
+    void liberarPorID(int idProceso) {
+        // Verificar si hay bloques en la pila
+        if (tope == NULL) {
+            cout << "\n[INFO] No hay bloques de memoria asignados.\n";
+            return;
+        }
+        
+        // Eliminar los bloques, guardando el nombre para el mensaje
+        char nombre[50];
+        int bloques;
+        long long tamanio = quitarTodosDe(idProceso, nombre, &bloques);
+        
+        // Verificar si el proceso tenía bloques
+        if (tamanio < 0) {
+            cout << "\n[ERROR] No se encontro memoria asignada al proceso ID " << idProceso << endl;
+            return;
+        }
+        
+        cout << "\n[OK] Memoria liberada correctamente:\n";
+        cout << "     Proceso ID: " << idProceso << " (" << nombre << ")\n";
+        char texto[32];
+        cout << "     Tamanio liberado: " << formatearTamanio(tamanio, texto) << " en " << bloques << " bloque(s)\n";
+        cout << "     Memoria disponible: " << formatearTamanio(memoriaTotal - memoriaUsada, texto) << "\n";
+    }
+    
+    // ============================================
+    // LIBERAR ÚLTIMO BLOQUE ASIGNADO (OPERACIÓN POP)
+    // Elimina el bloque del tope de la pila (LIFO)
+    // ============================================
+    void liberarMemoria() {
+        // Verificar si hay bloques en la pila
+        if (tope == NULL) {
+            cout << "\n[INFO] No hay bloques de memoria asignados.\n";
+            return;
+        }
+        
+        // ============================================
+        // REALIZAR OPERACIÓN POP
+        // ============================================
+        int idProceso;
+        char nombre[50];
+        long long tamanio = quitarTope(&idProceso, nombre);
+        
+        char texto[32];
+        cout << "\n[OK] Memoria liberada correctamente:\n";
+        cout << "     Proceso ID: " << idProceso << " (" << nombre << ")\n";
+        cout << "     Tamanio liberado: " << formatearTamanio(tamanio, texto) << "\n";
+        cout << "     Memoria disponible: " << formatearTamanio(memoriaTotal - memoriaUsada, texto) << "\n";
+    }
+    
+    // ============================================
+    // MOSTRAR ESTADO ACTUAL DE LA MEMORIA
+    // Muestra todos los bloques desde el tope hasta el fondo
+    // ============================================
+    void mostrarEstadoMemoria() {
+        char texto[32];
+        cout << "\n=============== ESTADO DE LA MEMORIA ===============\n";
+        cout << "Memoria Total:      " << formatearTamanio(memoriaTotal, texto) << "\n";
+        cout << "Memoria Usada:      " << formatearTamanio(memoriaUsada, texto) << "\n";
+        cout << "Memoria Disponible: " << formatearTamanio(memoriaTotal - memoriaUsada, texto) << "\n";
+        cout << "Porcentaje de uso:  " 
+             << (memoriaUsada * 100 / memoriaTotal) << "%\n";
+        mostrarFragmentacion();
+        if (intercambio != NULL) {
+            cout << "En intercambio:     " << formatearTamanio(memoriaEnIntercambio, texto) << " ("
+                 << bloquesEnIntercambio << " bloques, " << cargasPendientes << " cargando)\n";
+        }
+        if (compactacion.compactaciones > 0) {
+            cout << "Compactacion:       " << formatearTamanio(compactacion.bytesMovidos, texto) << " movidos en "
+                 << compactacion.bloquesMovidos << " bloques" << (compactando ? " (en curso)" : "") << "\n";
+        }
+        cout << "----------------------------------------------------\n";
+        cout << "Slabs (pedidos de hasta " << AsignadorSlab<GestorMemoria>::MAX_OBJETO << " B): "
+             << formatearTamanio(slab.bytesEnSlabs(), texto) << "\n";
+        slab.mostrarOcupacion();
+        cout << "====================================================\n";
+        
+        // Verificar si hay bloques asignados
+        if (tope == NULL) {
+            cout << "\n*** No hay bloques de memoria asignados ***\n";
+            cout << "====================================================\n";
+            return;
+        }
+        
+        // Mostrar lista de bloques asignados
+        cout << "\nBLOQUES ASIGNADOS (del mas reciente al mas antiguo):\n";
+        cout << "----------------------------------------------------\n";
+        cout << "Posicion  ID Proc  Nombre Proceso          Tamanio     Direcciones\n";
+        cout << "----------------------------------------------------\n";
+        
+        BloqueMemoria* actual = tope;
+        int posicion = 1;
+        
+        // Recorrer toda la pila mostrando cada bloque
+        while (actual != NULL) {
+            // Formatear salida para alinear columnas
+            cout << posicion;
+            if (posicion < 10) cout << "         ";
+            else cout << "        ";
+            
+            cout << actual->idProceso;
+            if (actual->idProceso < 10) cout << "        ";
+            else if (actual->idProceso < 100) cout << "       ";
+            else cout << "      ";
+            
+            cout << actual->nombreProceso;
+            int len = strlen(actual->nombreProceso);
+            for (int i = len; i < 24; i++) cout << " ";
+            
+            char rango[80];
+            formatearTamanio(actual->tamanio, texto);
+            if (actual->ubicacion == EN_INTERCAMBIO) {
+                sprintf(rango, "%-10s  [intercambio]", texto);
+            } else if (actual->enSlab) {
+                sprintf(rango, "%-10s  0x%llx (slab de %u B)", texto, actual->direccion,
+                        slab.tamanioClase(actual->tamanio));
+            } else {
+                sprintf(rango, "%-10s  [0x%llx, 0x%llx)%s", texto, actual->direccion,
+                        actual->direccion + bytesBloqueBuddy(actual->direccion),
+                        actual->ubicacion == ENTRANDO ? " cargando" : "");
+            }
+            cout << rango;
+            // Bloques de un proceso eliminado: solo quedan si la memoria
+            // no pudo registrarse como observador del gestor
+            if (!gestor.resolver(actual->proceso).existe()) {
+                cout << "  [proceso eliminado]";
+            }
+            cout << "\n";
+            
+            actual = actual->siguiente;
+            posicion++;
+        }
+        
+        cout << "====================================================\n";
+    }
+    
+    // ============================================
+    // REPORTE DE FRAGMENTACIÓN
+    // Interna: lo que el redondeo a potencia de 2 desperdicia dentro
+    // de los bloques. Externa: memoria libre que no forma parte del
+    // mayor bloque libre (no sirve para un pedido de ese tamaño).
+    // ============================================
+    void mostrarFragmentacion() {
+        char texto[32];
+        unsigned long long interna = memoriaUsada - memoriaSolicitada;
+        cout << "Memoria Solicitada: " << formatearTamanio(memoriaSolicitada, texto) << "\n";
+        cout << "Frag. interna:      " << formatearTamanio(interna, texto);
+        if (memoriaUsada > 0) cout << " (" << (interna * 100 / memoriaUsada) << "% de lo usado)";
+        cout << "\n";
+        cout << "Mayor bloque libre: " 
+             << formatearTamanio(buddy.mayorBloqueLibre() * TAMANIO_PAGINA, texto) << "\n";
+        cout << "Frag. externa:      " << (int)(buddy.fragmentacionExterna() * 100 + 0.5) << "%\n";
+        cout << "Bloques libres:     ";
+        bool alguno = false;
+        for (int k = 0; k <= AsignadorBuddy::MAX_ORDEN; k++) {
+            unsigned int cantidad = buddy.bloquesLibresDeOrden(k);
+            if (cantidad == 0) continue;
+            cout << (alguno ? ", " : "") << cantidad << " x "
+                 << formatearTamanio(((unsigned long long)1 << k) * TAMANIO_PAGINA, texto);
+            alguno = true;
+        }
+        cout << (alguno ? "\n" : "ninguno\n");
+    }
+
+    // ============================================
+    // REPORTE DE COMPACTACION
+    // ============================================
+    void mostrarCompactacion() {
+        char texto[32];
+        cout << "\n================= COMPACTACION =================\n";
+        cout << "Estado:             " << (compactando ? (incremental ? "incremental en curso" : "en curso") 
+                                                      : "inactiva") << "\n";
+        if (compactando && incremental) {
+            cout << "Presupuesto/tick:   " << formatearTamanio(presupuestoPorTick, texto) << "\n";
+        }
+        cout << "Compactaciones:     " << compactacion.compactaciones << " (" << compactacion.pasos 
+             << " ticks incrementales)\n";
+        cout << "Bytes movidos:      " << formatearTamanio(compactacion.bytesMovidos, texto) << " en "
+             << compactacion.bloquesMovidos << " bloques\n";
+        cout << "Regiones unidas:    " << compactacion.regionesUnidas << " (abandonadas: " 
+             << compactacion.abortadas << ")\n";
+        char linea[120];
+        sprintf(linea, "Tiempo total:       %.3f ms (pausa maxima %.3f ms)\n",
+                1000.0 * compactacion.segundos, 1000.0 * compactacion.pausaMaxima);
+        cout << linea;
+        cout << "Mayor bloque libre: " 
+             << formatearTamanio(buddy.mayorBloqueLibre() * TAMANIO_PAGINA, texto) << "\n";
+        cout << "Frag. externa:      " << (int)(buddy.fragmentacionExterna() * 100 + 0.5) << "%\n";
+        cout << "================================================\n";
+    }
+
+    // ============================================
+    // REPORTE DEL AREA DE INTERCAMBIO
+    // Ancho de banda = bytes / tiempo del hilo de E/S en fwrite/fread
+    // (mas el volcado); latencia = desde que se encola hasta que el
+    // lote que lo contiene termina
+    // ============================================
+    void mostrarIntercambio() {
+        if (intercambio == NULL) {
+            cout << "\n[INFO] El area de intercambio no esta habilitada (use --intercambio <archivo>).\n";
+            return;
+        }
+        procesarIntercambio();
+        EstadisticasIntercambio e = intercambio->obtenerEstadisticas();
+        const double MB_REAL = 1024.0 * 1024.0;     // Bytes reales del archivo
+        char linea[160], texto[32];
+        cout << "\n=============== AREA DE INTERCAMBIO ===============\n";
+        cout << "Capacidad:          " 
+             << formatearTamanio(intercambio->capacidadTotal() * TAMANIO_PAGINA, texto) << " (";
+        cout << formatearTamanio(intercambio->unidadesLibres() * TAMANIO_PAGINA, texto) << " libres, "
+             << BYTES_POR_PAGINA_SIMULADA << " B reales por pagina)\n";
+        cout << "En intercambio:     " << formatearTamanio(memoriaEnIntercambio, texto) << " en " << bloquesEnIntercambio
+             << " bloques, " << cargasPendientes << " cargando\n";
+        cout << "Desalojos / cargas: " << desalojos << " / " << cargas << "\n";
+        cout << "Lotes de E/S:       " << e.lotes << " (" << (e.escrituras + e.lecturas) << " pedidos en "
+             << e.operacionesArchivo << " operaciones de archivo)\n";
+        sprintf(linea, "Salida (page-out):  %.1f MB | %.1f MB/s | latencia media %.3f ms, max %.3f ms\n",
+                e.bytesEscritos / MB_REAL, e.segundosEscritura > 0 ? e.bytesEscritos / MB_REAL / e.segundosEscritura : 0.0,
+                e.escrituras > 0 ? 1000.0 * e.latenciaEscritura / e.escrituras : 0.0,
+                1000.0 * e.latenciaMaximaEscritura);
+        cout << linea;
+        sprintf(linea, "Entrada (page-in):  %.1f MB | %.1f MB/s | latencia media %.3f ms, max %.3f ms\n",
+                e.bytesLeidos / MB_REAL, e.segundosLectura > 0 ? e.bytesLeidos / MB_REAL / e.segundosLectura : 0.0,
+                e.lecturas > 0 ? 1000.0 * e.latenciaLectura / e.lecturas : 0.0,
+                1000.0 * e.latenciaMaximaLectura);
+        cout << linea;
+        if (e.errores > 0) cout << "[ERROR] Errores de E/S o imagenes corruptas: " << e.errores << "\n";
+        cout << "===================================================\n";
+    }
+    
+    // ============================================
+    // MENÚ PRINCIPAL DEL GESTOR DE MEMORIA
+    // Interfaz de usuario para interactuar con el sistema
+    // ============================================
+    void menuMemoria() {
+        int opcion;
+        
+        do {
+            cout << "\n======= GESTOR DE MEMORIA =======\n";
+            cout << "1. Asignar memoria a proceso (PUSH)\n";
+            cout << "2. Liberar ultimo bloque (POP)\n";
+            cout << "3. Ver estado de la memoria\n";
+            cout << "4. Ver area de intercambio\n";
+            cout << "5. Compactar memoria\n";
+            cout << "6. Volver al menu principal\n";
+            cout << "=================================\n";
+            cout << "Opcion: ";
+            cin >> opcion;
+            
+            // Validar entrada del usuario
+            if (cin.fail()) {
+                cin.clear();
+                cin.ignore(1000, '\n');
+                cout << "Error: Ingrese un numero valido.\n";
+                continue;
+            }
+            cin.ignore();
+            
+            switch(opcion) {
+                case 1: { // ASIGNAR MEMORIA (PUSH)
+                    // Verificar si hay procesos disponibles
+                    if (gestor.estaVacia()) {
+                        cout << "\n[ERROR] No hay procesos creados en el Gestor de Procesos.\n";
+                        cout << "Debe crear procesos primero antes de asignar memoria.\n";
+                        break;
+                    }
+                    
+                    // Mostrar procesos disponibles
+                    gestor.mostrar();
+                    
+                    int idSeleccionado;
+                    char textoTamanio[32];
+                    unsigned long long tamanio;
+                    bool entradaValida = false;
+                    
+                    // Solicitar ID del proceso con validación
+                    while (!entradaValida) {
+                        cout << "\nIngrese el ID del proceso: ";
+                        cin >> idSeleccionado;
+                        
+                        if (cin.fail()) {
+                            cin.clear();
+                            cin.ignore(1000, '\n');
+                            cout << "Error: Debe ingresar un numero valido.\n";
+                        } else if (idSeleccionado <= 0) {
+                            cin.ignore(1000, '\n');
+                            cout << "Error: El ID debe ser un numero positivo.\n";
+                        } else {
+                            // Buscar el proceso por ID
+                            Proceso p = gestor.buscar(idSeleccionado);
+                            if (!p.existe()) {
+                                cin.ignore(1000, '\n');
+                                cout << "Error: No existe ningun proceso con ese ID.\n";
+                            } else {
+                                entradaValida = true;
+                                cin.ignore(1000, '\n');
+                                
+                                // Solicitar tamaño de memoria con validación
+                                bool tamanioValido = false;
+                                while (!tamanioValido) {
+                                    // Sin unidad se toma MB (p. ej. 64, 512KB, 100B, 1G)
+                                    char maximo[32];
+                                    formatearTamanio(tamanioMaximo(), maximo);
+                                    cout << "Ingrese el tamanio de memoria (1 B - " << maximo << ", MB por defecto): ";
+                                    cin.width(sizeof(textoTamanio));
+                                    cin >> textoTamanio;
+                                    
+                                    if (cin.fail()) {
+                                        cin.clear();
+                                        cin.ignore(1000, '\n');
+                                        cout << "Error: Debe ingresar un tamanio valido.\n";
+                                    } else if (!leerTamanio(textoTamanio, tamanio, BYTES_MB)) {
+                                        cin.ignore(1000, '\n');
+                                        cout << "Error: Tamanio invalido (use B, KB, MB o GB).\n";
+                                    } else if (tamanio < 1 || tamanio > tamanioMaximo()) {
+                                        cin.ignore(1000, '\n');
+                                        cout << "Error: El tamanio debe estar entre 1 B y " << maximo << ".\n";
+                                    } else {
+                                        tamanioValido = true;
+                                        cin.ignore(1000, '\n');
+                                        
+                                        // Asignar memoria al proceso
+                                        asignarMemoria(gestor.buscarHandle(idSeleccionado), tamanio);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    break;
+                }
+                
+                case 2: // LIBERAR MEMORIA (POP)
+                    liberarMemoria();
+                    break;
+                
+                case 3: // VER ESTADO DE LA MEMORIA
+                    mostrarEstadoMemoria();
+                    break;
+                
+                case 4: // VER AREA DE INTERCAMBIO
+                    mostrarIntercambio();
+                    break;
+                
+                case 5: { // COMPACTAR MEMORIA
+                    cout << "\n1. Total (detiene todo hasta terminar)\n";
+                    cout << "2. Incremental (un poco en cada ejecucion del planificador)\n";
+                    cout << "Modo: ";
+                    int modo;
+                    cin >> modo;
+                    if (cin.fail() || (modo != 1 && modo != 2)) {
+                        cin.clear();
+                        cin.ignore(1000, '\n');
+                        cout << "Error: Modo invalido.\n";
+                        break;
+                    }
+                    cin.ignore(1000, '\n');
+                    if (modo == 1) {
+                        compactar();
+                        mostrarCompactacion();
+                        break;
+                    }
+                    char textoPresupuesto[32];
+                    unsigned long long presupuesto;
+                    cout << "Trabajo por tick (p. ej. 4MB, 512KB; MB por defecto): ";
+                    cin.width(sizeof(textoPresupuesto));
+                    cin >> textoPresupuesto;
+                    cin.clear();
+                    cin.ignore(1000, '\n');
+                    if (!leerTamanio(textoPresupuesto, presupuesto, BYTES_MB) || presupuesto == 0) {
+                        cout << "Error: Tamanio invalido.\n";
+                        break;
+                    }
+                    iniciarCompactacionIncremental(presupuesto);
+                    cout << "\n[OK] Compactacion incremental iniciada; avanza al ejecutar procesos.\n";
+                    break;
+                }
+                
+                case 6: // VOLVER AL MENÚ PRINCIPAL
+                    cout << "Volviendo al menu principal...\n";
+                    break;
+                
+                default:
+                    cout << "Opcion invalida.\n";
+            }
+        } while(opcion != 6);
+    }
+    
+    // ============================================
+    // DESTRUCTOR DEL GESTOR DE MEMORIA
+    // Libera toda la memoria asignada al destruir el objeto
+    // ============================================
+    // El pool libera todos los bloques de una vez (sin recorrer la pila);
+    // antes se detiene el hilo de E/S del area de intercambio
+    ~GestorMemoria() {
+        gestor.quitarObservador(this);
+        delete intercambio;
+        delete[] bloqueEnPagina;
+        delete[] bufferCopia;
+        tope = NULL;
+    }
+};
+
+// ============================================
+// MEMORIA VIRTUAL PAGINADA
+// Simula la traduccion de una traza de referencias (proceso, pagina
+// virtual) sobre una cantidad fija de marcos. Cada proceso tiene su
+// tabla de paginas; todas son tramos contiguos de un mismo arreglo
+// (base del proceso + pagina). Antes de la tabla se consulta una TLB
+// de mapeo directo, que se invalida al desalojar la pagina. La
+// politica de reemplazo se elige en compilacion:
+//   ReemplazoFIFO    el marco cargado hace mas tiempo
+//   ReemplazoLRU     el usado hace mas tiempo (lista doble por marco)
+//   ReemplazoReloj   segunda oportunidad con bit de referencia
+//   ReemplazoOptimo  Belady: la pagina que se vuelve a usar mas tarde
+// Todas arrancan con los marcos vacios ya ubicados, asi que solo se
+// pide una victima cuando no queda ningun marco libre.
+// ============================================
+const unsigned int SIN_MARCO = 0xFFFFFFFFu;
+
+struct ReferenciaPagina {
+    unsigned int proceso;
+    unsigned int pagina;
+};
+
+// Los marcos se cargan y se desalojan en el mismo orden circular
+class ReemplazoFIFO {
+private:
+    unsigned int marcos;
+    unsigned int manecilla;
+
+public:
+    ReemplazoFIFO(unsigned int _marcos) : marcos(_marcos), manecilla(0) {}
+
+    static const char* nombre() {
+        return "FIFO";
+    }
+
+    void preparar(const ReferenciaPagina*, long long, const unsigned int*, unsigned int) {}
+
+    void usado(unsigned int, long long) {}
+
+    void cargado(unsigned int, long long) {}
+
+    unsigned int victima() {
+        unsigned int marco = manecilla;
+        if (++manecilla == marcos) manecilla = 0;
+        return marco;
+    }
+};
+
+// Lista doble de marcos del mas reciente (cabeza) al menos reciente (cola)
+class ReemplazoLRU {
+private:
+    unsigned int* anterior;
+    unsigned int* siguiente;
+    unsigned int cabeza;
+    unsigned int cola;
+
+    void moverAlFrente(unsigned int marco) {
+        if (marco == cabeza) return;
+        siguiente[anterior[marco]] = siguiente[marco];
+        if (marco == cola) cola = anterior[marco];
+        else anterior[siguiente[marco]] = anterior[marco];
+        anterior[marco] = SIN_MARCO;
+        siguiente[marco] = cabeza;
+        anterior[cabeza] = marco;
+        cabeza = marco;
+    }
+
+public:
+    ReemplazoLRU(unsigned int marcos) {
+        anterior = new unsigned int[marcos];
+        siguiente = new unsigned int[marcos];
+        // Los marcos vacios quedan del mas viejo (0) al mas nuevo
+        for (unsigned int i = 0; i < marcos; i++) {
+            anterior[i] = (i + 1 < marcos) ? i + 1 : SIN_MARCO;
+            siguiente[i] = (i > 0) ? i - 1 : SIN_MARCO;
+        }
+        cabeza = marcos - 1;
+        cola = 0;
+    }
+
+    static const char* nombre() {
+        return "LRU";
+    }
+
+    void preparar(const ReferenciaPagina*, long long, const unsigned int*, unsigned int) {}
+
+    void usado(unsigned int marco, long long) {
+        moverAlFrente(marco);
+    }
+
+    void cargado(unsigned int marco, long long) {
+        moverAlFrente(marco);
+    }
+
+    unsigned int victima() {
+        return cola;
+    }
+
+    ~ReemplazoLRU() {
+        delete[] anterior;
+        delete[] siguiente;
+    }
+};
+
+// CLOCK: la manecilla limpia bits de referencia hasta encontrar uno en 0
+class ReemplazoReloj {
+private:
+    unsigned int marcos;
+    unsigned int manecilla;
+    unsigned char* referenciado;
+
+public:
+    ReemplazoReloj(unsigned int _marcos) : marcos(_marcos), manecilla(0) {
+        referenciado = new unsigned char[marcos];
+        memset(referenciado, 0, marcos);
+    }
+
+    static const char* nombre() {
+        return "CLOCK";
+    }
+
+    void preparar(const ReferenciaPagina*, long long, const unsigned int*, unsigned int) {}
+
+    void usado(unsigned int marco, long long) {
+        referenciado[marco] = 1;
+    }
+
+    void cargado(unsigned int marco, long long) {
+        referenciado[marco] = 1;
+    }
+
+    unsigned int victima() {
+        while (referenciado[manecilla]) {
+            referenciado[manecilla] = 0;
+            if (++manecilla == marcos) manecilla = 0;
+        }
+        unsigned int marco = manecilla;
+        if (++manecilla == marcos) manecilla = 0;
+        return marco;
+    }
+
+    ~ReemplazoReloj() {
+        delete[] referenciado;
+    }
+};
+
+// Belady necesita conocer la traza completa: preparar calcula, para
+// cada referencia, la posicion del proximo uso de la misma pagina.
+// Un monticulo de maximos indexado por marco da la pagina mas lejana.
+class ReemplazoOptimo {
+private:
+    static const unsigned int NUNCA = 0xFFFFFFFFu;
+
+    unsigned int* proximoUso;       // Por referencia (NUNCA si no se repite)
+    unsigned int* monticulo;        // Marcos ordenados por clave
+    unsigned int* posicion;         // Posicion de cada marco en el monticulo
+    unsigned int* clave;            // Proximo uso de la pagina de cada marco
+    unsigned int marcos;
+
+    void intercambiar(unsigned int i, unsigned int j) {
+        unsigned int a = monticulo[i], b = monticulo[j];
+        monticulo[i] = b;
+        monticulo[j] = a;
+        posicion[b] = i;
+        posicion[a] = j;
+    }
+
+    void subir(unsigned int i) {
+        while (i > 0) {
+            unsigned int padre = (i - 1) / 2;
+            if (clave[monticulo[padre]] >= clave[monticulo[i]]) break;
+            intercambiar(i, padre);
+            i = padre;
+        }
+    }
+
+    void bajar(unsigned int i) {
+        while (true) {
+            unsigned int mayor = i;
+            unsigned int izquierdo = 2 * i + 1, derecho = 2 * i + 2;
+            if (izquierdo < marcos && clave[monticulo[izquierdo]] > clave[monticulo[mayor]]) mayor = izquierdo;
+            if (derecho < marcos && clave[monticulo[derecho]] > clave[monticulo[mayor]]) mayor = derecho;
+            if (mayor == i) break;
+            intercambiar(i, mayor);
+            i = mayor;
+        }
+    }
+
+public:
+    ReemplazoOptimo(unsigned int _marcos) : proximoUso(NULL), marcos(_marcos) {
+        monticulo = new unsigned int[marcos];
+        posicion = new unsigned int[marcos];
+        clave = new unsigned int[marcos];
+        // Clave 0 en todos los marcos vacios: cualquier orden es un monticulo valido
+        for (unsigned int i = 0; i < marcos; i++) {
+            monticulo[i] = i;
+            posicion[i] = i;
+            clave[i] = 0;
+        }
+    }
+
+    static const char* nombre() {
+        return "OPT";
+    }
+
+    // Recorre la traza hacia atras recordando el ultimo uso de cada pagina
+    void preparar(const ReferenciaPagina* traza, long long n, const unsigned int* baseDe,
+                  unsigned int totalPaginas) {
+        delete[] proximoUso;
+        proximoUso = new unsigned int[n];
+        unsigned int* ultimoUso = new unsigned int[totalPaginas];
+        for (unsigned int i = 0; i < totalPaginas; i++) ultimoUso[i] = NUNCA;
+        for (long long t = n - 1; t >= 0; t--) {
+            unsigned int g = baseDe[traza[t].proceso] + traza[t].pagina;
+            proximoUso[t] = ultimoUso[g];
+            ultimoUso[g] = (unsigned int)t;
+        }
+        delete[] ultimoUso;
+    }
+
+    // El proximo uso solo puede alejarse: la clave sube
+    void usado(unsigned int marco, long long t) {
+        clave[marco] = proximoUso[t];
+        subir(posicion[marco]);
+    }
+
+    void cargado(unsigned int marco, long long t) {
+        clave[marco] = proximoUso[t];
+        subir(posicion[marco]);
+        bajar(posicion[marco]);
+    }
+
+    unsigned int victima() {
+        return monticulo[0];
+    }
+
+    ~ReemplazoOptimo() {
+        delete[] proximoUso;
+        delete[] monticulo;
+        delete[] posicion;
+        delete[] clave;
+    }
+};
+
+template <class Reemplazo>
+class SimuladorPaginacion {
+private:
+    unsigned int marcos;
+    unsigned int procesos;
+    unsigned int totalPaginas;
+    unsigned int* baseDe;           // Inicio de la tabla de cada proceso
+    unsigned int* marcoDe;          // Tablas de paginas: marco de cada pagina o SIN_MARCO
+    unsigned int* paginaEn;         // Pagina (global) cargada en cada marco
+    unsigned int marcosUsados;
+    unsigned int mascaraTLB;
+    unsigned int* etiquetaTLB;      // Pagina (global) de cada entrada o SIN_MARCO
+    unsigned int* marcoTLB;
+    Reemplazo reemplazo;
+
+    long long referencias;
+    long long aciertosTLB;
+    long long fallos;
+
+public:
+    // entradasTLB se redondea a potencia de 2
+    SimuladorPaginacion(unsigned int _marcos, unsigned int entradasTLB,
+                        const unsigned int* paginasPorProceso, unsigned int _procesos)
+        : marcos(_marcos), procesos(_procesos), reemplazo(_marcos) {
+        baseDe = new unsigned int[procesos];
+        totalPaginas = 0;
+        for (unsigned int p = 0; p < procesos; p++) {
+            baseDe[p] = totalPaginas;
+            totalPaginas += paginasPorProceso[p];
+        }
+        marcoDe = new unsigned int[totalPaginas];
+        for (unsigned int i = 0; i < totalPaginas; i++) marcoDe[i] = SIN_MARCO;
+        paginaEn = new unsigned int[marcos];
+        marcosUsados = 0;
+
+        unsigned int entradas = 1;
+        while (entradas < entradasTLB) entradas <<= 1;
+        mascaraTLB = entradas - 1;
+        etiquetaTLB = new unsigned int[entradas];
+        marcoTLB = new unsigned int[entradas];
+        for (unsigned int i = 0; i < entradas; i++) etiquetaTLB[i] = SIN_MARCO;
+
+        referencias = 0;
+        aciertosTLB = 0;
+        fallos = 0;
+    }
+
+    static const char* nombre() {
+        return Reemplazo::nombre();
+    }
+
+    // La traza debe tener proceso < procesos y pagina < paginas del proceso
+    void preparar(const ReferenciaPagina* traza, long long n) {
+        reemplazo.preparar(traza, n, baseDe, totalPaginas);
+    }
+
+    // El tiempo t de cada referencia es su posicion en la traza
+    void ejecutar(const ReferenciaPagina* traza, long long n) {
+        for (long long t = 0; t < n; t++) {
+            unsigned int g = baseDe[traza[t].proceso] + traza[t].pagina;
+            unsigned int ranura = g & mascaraTLB;
+            if (etiquetaTLB[ranura] == g) {
+                aciertosTLB++;
+                reemplazo.usado(marcoTLB[ranura], t);
+                continue;
+            }
+
+            // Fallo de TLB: recorrer la tabla de paginas
+            unsigned int marco = marcoDe[g];
+            if (marco != SIN_MARCO) {
+                reemplazo.usado(marco, t);
+            } else {
+                fallos++;
+                if (marcosUsados < marcos) {
+                    marco = marcosUsados++;
+                } else {
+                    marco = reemplazo.victima();
+                    unsigned int desalojada = paginaEn[marco];
+                    marcoDe[desalojada] = SIN_MARCO;
+                    if (etiquetaTLB[desalojada & mascaraTLB] == desalojada) {
+                        etiquetaTLB[desalojada & mascaraTLB] = SIN_MARCO;
+                    }
+                }
+                marcoDe[g] = marco;
+                paginaEn[marco] = g;
+                reemplazo.cargado(marco, t);
+            }
+            etiquetaTLB[ranura] = g;
+            marcoTLB[ranura] = marco;
+        }
+        referencias += n;
+    }
+
+    long long cantidadReferencias() const {
+        return referencias;
+    }
+
+    long long cantidadFallos() const {
+        return fallos;
+    }
+
+    long long cantidadAciertosTLB() const {
+        return aciertosTLB;
+    }
+
+    // Referencias que encontraron la pagina en memoria (con o sin TLB)
+    double tasaAciertos() const {
+        return (referencias == 0) ? 0.0 : 1.0 - (double)fallos / referencias;
+    }
+
+    double tasaAciertosTLB() const {
+        return (referencias == 0) ? 0.0 : (double)aciertosTLB / referencias;
+    }
+
+    ~SimuladorPaginacion() {
+        delete[] baseDe;
+        delete[] marcoDe;
+        delete[] paginaEn;
+        delete[] etiquetaTLB;
+        delete[] marcoTLB;
+    }
+};
+
+// ============================================
+// ENTRADA DE LA COLA DE LISTOS
+// Comun a todas las estructuras que puede usar el planificador
+// ============================================
+struct EntradaCola {
+    unsigned long long clave;       // Orden interno de la estructura (menor = primero)
+    HandleProceso proceso;
+    int id;                         // ID del proceso al encolar
+    int prioridad;                  // Prioridad con la que se encolo
+};
+
+// ============================================
+// POLITICAS DE PLANIFICACION
+// Una politica es una cola de listos: el planificador y el simulador
+// son plantillas sobre ella, asi que la politica se elige al compilar y
+// no hay funciones virtuales. Ademas de insertar, extraer, reinsertar,
+// contiene, actualizarPrioridad, eliminar, tamanio y copiarOrdenado, cada politica
+// responde las consultas de PoliticaBase (las de una politica sin
+// desalojo) y redefine las que necesita.
+// ============================================
+struct PoliticaBase {
+    // true si un proceso que pasa a listo puede desalojar a uno en CPU
+    static const bool DESALOJA_AL_LLEGAR = false;
+
+    // Duracion (o resto) de la rafaga del proceso que se va a insertar
+    void preverRafaga(HandleProceso, long long) {
+    }
+
+    void fijarQuantum(long long) {
+    }
+
+    // Cuanto usa la CPU el elegido: sin desalojo, toda su rafaga
+    long long porcionDeCPU(int, long long restante) const {
+        return restante;
+    }
+
+    // CPU que uso un proceso al dejar el procesador
+    void cargarTiempo(HandleProceso, int, long long) {
+    }
+
+    // true si el que llega (prioridad, rafaga) desaloja al que esta en CPU
+    bool desaloja(int, long long, int, long long) const {
+        return false;
+    }
+};
+
+// Criterios de orden para MonticuloIndexado. clave() arma la clave
+// completa (menor = sale primero) a partir de la prioridad, la rafaga
+// prevista y el numero de llegada a la cola; llegada() lo recupera para
+// reubicar un proceso sin perder su turno.
+// Los lexicograficos ponen un criterio de 24 bits delante de 40 bits de
+// llegada (FIFO a igual criterio).
+struct OrdenLexicografico {
+    static const int BITS_LLEGADA = 40;
+
+    static unsigned long long componer(unsigned long long criterio, unsigned long long llegada) {
+        return (criterio << BITS_LLEGADA) | (llegada & ((1ull << BITS_LLEGADA) - 1));
+    }
+
+    static unsigned long long llegada(unsigned long long clave) {
+        return clave & ((1ull << BITS_LLEGADA) - 1);
+    }
+};
+
+struct OrdenPorPrioridad : OrdenLexicografico {
+    static unsigned long long clave(int prioridad, long long, unsigned long long llegada) {
+        return componer((unsigned long long)(0x7FFFFF - prioridad) & 0xFFFFFFull, llegada);
+    }
+};
+
+struct OrdenPorLlegada : OrdenLexicografico {
+    static unsigned long long clave(int, long long, unsigned long long llegada) {
+        return componer(0, llegada);
+    }
+};
+
+struct OrdenPorRafaga : OrdenLexicografico {
+    static unsigned long long clave(int, long long rafaga, unsigned long long llegada) {
+        if (rafaga < 0) rafaga = 0;
+        return componer((rafaga > 0xFFFFFF) ? 0xFFFFFFull : (unsigned long long)rafaga, llegada);
+    }
+};
+
+// Prioridad con envejecimiento: un proceso sube un nivel por cada K
+// llegadas a la cola mientras espera. La prioridad efectiva al
+// desencolar seria prioridad + (ahora - llegada) / K; ordenar por ella
+// equivale a ordenar por llegada - prioridad * K, porque "ahora" es el
+// mismo para todos. Esa clave no cambia mientras el proceso espera, asi
+// que envejecer no toca la cola: cuesta lo mismo que sin envejecimiento.
+// El reloj (la epoca) es el numero de llegada, que en regimen avanza
+// una vez por decision. Un proceso de prioridad 1 sale, a mas tardar,
+// despues de los que ya estaban y de 9 * K llegadas mas.
+// Los 4 bits bajos desempatan por prioridad (las llegadas son unicas).
+template <int K>
+struct OrdenConEnvejecimiento {
+    static unsigned long long clave(int prioridad, long long, unsigned long long llegada) {
+        if (prioridad < 1) prioridad = 1;
+        if (prioridad > 10) prioridad = 10;
+        unsigned long long atraso = (unsigned long long)(10 - prioridad);
+        return ((llegada + atraso * K) << 4) | atraso;
+    }
+
+    static unsigned long long llegada(unsigned long long clave) {
+        unsigned long long atraso = clave & 15;
+        return (clave >> 4) - atraso * K;
+    }
+};
+
+// ============================================
+// MONTICULO D-ARIO INDEXADO (COLA DE LISTOS)
+// Ordena por prioridad (mayor primero) y, a igual prioridad, por orden
+// de llegada (FIFO). Guarda la posicion de cada proceso en el monticulo
+// indexada por ranura del handle, para consultas y eliminaciones en O(1)
+// y O(log n). Encolar y desencolar cuestan O(log n).
+// Orden cambia el criterio principal (llegada para FCFS, rafaga
+// prevista para SJF) o lo mezcla con la espera (envejecimiento); el
+// desempate siempre es FIFO.
+// ============================================
+template <int D, class Orden = OrdenPorPrioridad>
+class MonticuloIndexado : public PoliticaBase {
+public:
+    // clave = criterio de Orden + secuencia de llegada
+    typedef EntradaCola Entrada;
+
+    static const char* nombre() {
+        return "monticulo indexado";
+    }
+
+private:
+    static const int NO_ENCOLADO = -1;
+
+    // Combina el criterio (p. ej. prioridad, mayor primero) y el orden de
+    // llegada (FIFO) en un solo entero, asi cada comparacion del monticulo
+    // es una sola instruccion
+    unsigned long long construirClave(unsigned int ranura, int prioridad, unsigned long long secuencia) const {
+        return Orden::clave(prioridad, rafagaPrevista[ranura], secuencia);
+    }
+
+    Entrada* datos;
+    int cantidad;
+    int capacidad;
+
+    int* posicionDe;                    // Ranura del handle -> posicion en datos
+    long long* rafagaPrevista;          // Por ranura (solo la usa OrdenPorRafaga)
+    unsigned int capacidadPosiciones;
+
+    unsigned long long contadorSecuencia;
+
+    // true si a debe salir antes que b
+    static bool precede(const Entrada& a, const Entrada& b) {
+        return a.clave < b.clave;
+    }
+
+    void colocar(int i, const Entrada& e) {
+        datos[i] = e;
+        posicionDe[e.proceso.indice] = i;
+    }
+
+    void subir(int i) {
+        Entrada e = datos[i];
+        while (i > 0) {
+            int padre = (i - 1) / D;
+            if (!precede(e, datos[padre])) break;
+            colocar(i, datos[padre]);
+            i = padre;
+        }
+        colocar(i, e);
+    }
+
+    void bajar(int i) {
+        Entrada e = datos[i];
+        while (true) {
+            int primerHijo = i * D + 1;
+            if (primerHijo >= cantidad) break;
+            int mejor = primerHijo;
+            int ultimoHijo = primerHijo + D;
+            if (ultimoHijo > cantidad) ultimoHijo = cantidad;
+            for (int h = primerHijo + 1; h < ultimoHijo; h++) {
+                if (precede(datos[h], datos[mejor])) mejor = h;
+            }
+            if (!precede(datos[mejor], e)) break;
+            colocar(i, datos[mejor]);
+            i = mejor;
+        }
+        colocar(i, e);
+    }
+
+    // Quita la entrada en la posicion i rellenando con la ultima
+    void quitarEn(int i) {
+        posicionDe[datos[i].proceso.indice] = NO_ENCOLADO;
+        cantidad--;
+        if (i == cantidad) return;
+        colocar(i, datos[cantidad]);
+        if (i > 0 && precede(datos[i], datos[(i - 1) / D])) subir(i);
+        else bajar(i);
+    }
+
+    void asegurarPosiciones(unsigned int indice) {
+        if (indice < capacidadPosiciones) return;
+        unsigned int nueva = (capacidadPosiciones == 0) ? 16 : capacidadPosiciones;
+        while (nueva <= indice) nueva *= 2;
+        int* posiciones = new int[nueva];
+        long long* rafagas = new long long[nueva];
+        for (unsigned int i = 0; i < capacidadPosiciones; i++) {
+            posiciones[i] = posicionDe[i];
+            rafagas[i] = rafagaPrevista[i];
+        }
+        for (unsigned int i = capacidadPosiciones; i < nueva; i++) {
+            posiciones[i] = NO_ENCOLADO;
+            rafagas[i] = 0;
+        }
+        delete[] posicionDe;
+        delete[] rafagaPrevista;
+        posicionDe = posiciones;
+        rafagaPrevista = rafagas;
+        capacidadPosiciones = nueva;
+    }
+
+    static void hundir(Entrada* arreglo, int n, int i) {
+        while (true) {
+            int ultimo = i;
+            int izq = 2 * i + 1, der = 2 * i + 2;
+            if (izq < n && precede(arreglo[ultimo], arreglo[izq])) ultimo = izq;
+            if (der < n && precede(arreglo[ultimo], arreglo[der])) ultimo = der;
+            if (ultimo == i) return;
+            Entrada aux = arreglo[i];
+            arreglo[i] = arreglo[ultimo];
+            arreglo[ultimo] = aux;
+            i = ultimo;
+        }
+    }
+
+    // Coloca el proceso con el numero de llegada dado; false si ya estaba
+    bool encolar(HandleProceso h, int id, int prioridad, unsigned long long secuencia) {
+        asegurarPosiciones(h.indice);
+        int pos = posicionDe[h.indice];
+        if (pos != NO_ENCOLADO) {
+            if (datos[pos].proceso == h) return false;
+            // La ranura fue reutilizada: la entrada vieja es de un proceso eliminado
+            quitarEn(pos);
+        }
+
+        if (cantidad == capacidad) {
+            capacidad *= 2;
+            Entrada* nuevos = new Entrada[capacidad];
+            for (int i = 0; i < cantidad; i++) nuevos[i] = datos[i];
+            delete[] datos;
+            datos = nuevos;
+        }
+
+        Entrada e;
+        e.proceso = h;
+        e.id = id;
+        e.prioridad = prioridad;
+        e.clave = construirClave(h.indice, prioridad, secuencia);
+        cantidad++;
+        colocar(cantidad - 1, e);
+        subir(cantidad - 1);
+        return true;
+    }
+
+public:
+    MonticuloIndexado() {
+        capacidad = 16;
+        cantidad = 0;
+        datos = new Entrada[capacidad];
+        posicionDe = NULL;
+        rafagaPrevista = NULL;
+        capacidadPosiciones = 0;
+        contadorSecuencia = 0;
+    }
+
+    // Verifica si el proceso (con esa generacion exacta) esta encolado
+    bool contiene(HandleProceso h) const {
+        if (h.indice >= capacidadPosiciones) return false;
+        int pos = posicionDe[h.indice];
+        return pos != NO_ENCOLADO && datos[pos].proceso == h;
+    }
+
+    // Encola un proceso; retorna false si ya estaba en la cola
+    bool insertar(HandleProceso h, int id, int prioridad) {
+        if (!encolar(h, id, prioridad, contadorSecuencia)) return false;
+        contadorSecuencia++;
+        return true;
+    }
+
+    // Devuelve a la cola una entrada ya extraida con su numero de llegada
+    // original: no pierde su turno ni, con envejecimiento, la espera
+    // acumulada. La clave se rearma con la rafaga prevista actual.
+    bool reinsertar(const Entrada& e) {
+        return encolar(e.proceso, e.id, e.prioridad, Orden::llegada(e.clave));
+    }
+
+    // Extrae la entrada de mayor prioridad; retorna false si esta vacia
+    bool extraer(Entrada& salida) {
+        if (cantidad == 0) return false;
+        salida = datos[0];
+        quitarEn(0);
+        return true;
+    }
+
+    // Cambia la prioridad de un proceso encolado y lo reubica en O(log n).
+    // Conserva su orden de llegada frente a los de igual prioridad.
+    bool actualizarPrioridad(HandleProceso h, int nuevaPrioridad) {
+        if (!contiene(h)) return false;
+        int pos = posicionDe[h.indice];
+        unsigned long long secuencia = Orden::llegada(datos[pos].clave);
+        unsigned long long claveAnterior = datos[pos].clave;
+        datos[pos].prioridad = nuevaPrioridad;
+        datos[pos].clave = construirClave(h.indice, nuevaPrioridad, secuencia);
+        if (datos[pos].clave < claveAnterior) subir(pos);
+        else bajar(pos);
+        return true;
+    }
+
+    // Quita un proceso cualquiera de la cola en O(log n)
+    bool eliminar(HandleProceso h) {
+        if (!contiene(h)) return false;
+        quitarEn(posicionDe[h.indice]);
+        return true;
+    }
+
+    // Se usa en la proxima insercion del proceso (ordena a SJF)
+    void preverRafaga(HandleProceso h, long long rafaga) {
+        asegurarPosiciones(h.indice);
+        rafagaPrevista[h.indice] = rafaga;
+    }
+
+    int tamanio() const {
+        return cantidad;
+    }
+
+    bool estaVacia() const {
+        return cantidad == 0;
+    }
+
+    // Copia las entradas en orden de salida (para mostrar la cola)
+    void copiarOrdenado(Entrada* destino) const {
+        for (int i = 0; i < cantidad; i++) destino[i] = datos[i];
+        for (int i = cantidad / 2 - 1; i >= 0; i--) hundir(destino, cantidad, i);
+        for (int fin = cantidad - 1; fin > 0; fin--) {
+            Entrada aux = destino[0];
+            destino[0] = destino[fin];
+            destino[fin] = aux;
+            hundir(destino, fin, 0);
+        }
+    }
+
+    ~MonticuloIndexado() {
+        delete[] datos;
+        delete[] posicionDe;
+        delete[] rafagaPrevista;
+    }
+};
+
+// Cola por defecto del planificador: prioridad sin inanicion
+const int LLEGADAS_POR_NIVEL = 256;
+
+class ColaEnvejecimiento : public MonticuloIndexado<4, OrdenConEnvejecimiento<LLEGADAS_POR_NIVEL> > {
+public:
+    static const char* nombre() {
+        return "prioridad con envejecimiento";
+    }
+};
+
+// ============================================
+// COLA MULTINIVEL CON MAPA DE BITS (ESTILO O(1) DE LINUX)
+// Una cola FIFO por nivel de prioridad y un entero de 64 bits cuyo
+// bit k indica si el nivel k tiene procesos. El siguiente proceso se
+// encuentra con una sola instruccion (find-first-set). Encolar,
+// desencolar y cambiar de nivel cuestan O(1) sin importar cuantos
+// procesos esten listos. Los enlaces se guardan en arreglos indexados
+// por ranura del handle, asi que no se reserva memoria por operacion.
+// ============================================
+class ColaNiveles : public PoliticaBase {
+public:
+    typedef EntradaCola Entrada;    // clave = numero de llegada
+
+    static const char* nombre() {
+        return "multinivel con mapa de bits";
+    }
+
+private:
+    static const int NIVELES = 64;
+    static const int NINGUNO = -1;
+
+    // Nivel 0 = prioridad mas alta, para que el primer bit encendido
+    // (el de menor indice) sea siempre el nivel a atender
+    static int nivelDe(int prioridad) {
+        if (prioridad < 0) prioridad = 0;
+        if (prioridad > NIVELES - 1) prioridad = NIVELES - 1;
+        return (NIVELES - 1) - prioridad;
+    }
+
+    unsigned long long mapaNiveles;     // Bit k encendido = nivel k no vacio
+    int cabezaNivel[NIVELES];
+    int colaNivel[NIVELES];
+
+    Entrada* entradas;                  // Indexados por ranura del handle
+    int* siguienteDe;
+    int* anteriorDe;
+    bool* encolado;
+    unsigned int capacidadRanuras;
+
+    int cantidad;
+    unsigned long long contadorLlegada;
+
+    void asegurarRanuras(unsigned int indice) {
+        if (indice < capacidadRanuras) return;
+        unsigned int nueva = (capacidadRanuras == 0) ? 16 : capacidadRanuras;
+        while (nueva <= indice) nueva *= 2;
+
+        Entrada* nuevasEntradas = new Entrada[nueva];
+        int* nuevoSiguiente = new int[nueva];
+        int* nuevoAnterior = new int[nueva];
+        bool* nuevoEncolado = new bool[nueva];
+        for (unsigned int i = 0; i < capacidadRanuras; i++) {
+            nuevasEntradas[i] = entradas[i];
+            nuevoSiguiente[i] = siguienteDe[i];
+            nuevoAnterior[i] = anteriorDe[i];
+            nuevoEncolado[i] = encolado[i];
+        }
+        for (unsigned int i = capacidadRanuras; i < nueva; i++) {
+            nuevoEncolado[i] = false;
+        }
+        delete[] entradas;
+        delete[] siguienteDe;
+        delete[] anteriorDe;
+        delete[] encolado;
+        entradas = nuevasEntradas;
+        siguienteDe = nuevoSiguiente;
+        anteriorDe = nuevoAnterior;
+        encolado = nuevoEncolado;
+        capacidadRanuras = nueva;
+    }
+
+    // Agrega la ranura r al final de la cola de su nivel
+    void enlazarAlFinal(int r) {
+        int nivel = nivelDe(entradas[r].prioridad);
+        siguienteDe[r] = NINGUNO;
+        anteriorDe[r] = colaNivel[nivel];
+        if (colaNivel[nivel] == NINGUNO) cabezaNivel[nivel] = r;
+        else siguienteDe[colaNivel[nivel]] = r;
+        colaNivel[nivel] = r;
+        mapaNiveles |= (1ull << nivel);
+    }
+
+    // Enlaza la ranura r delante del primero de su nivel que llego
+    // despues (para devolver una entrada sin que pierda su turno)
+    void enlazarPorLlegada(int r) {
+        int nivel = nivelDe(entradas[r].prioridad);
+        int despues = cabezaNivel[nivel];
+        while (despues != NINGUNO && entradas[despues].clave < entradas[r].clave) {
+            despues = siguienteDe[despues];
+        }
+        if (despues == NINGUNO) {
+            enlazarAlFinal(r);
+            return;
+        }
+        siguienteDe[r] = despues;
+        anteriorDe[r] = anteriorDe[despues];
+        if (anteriorDe[despues] == NINGUNO) cabezaNivel[nivel] = r;
+        else siguienteDe[anteriorDe[despues]] = r;
+        anteriorDe[despues] = r;
+    }
+
+    // Saca la ranura r de la cola de su nivel
+    void desenlazar(int r) {
+        int nivel = nivelDe(entradas[r].prioridad);
+        if (anteriorDe[r] == NINGUNO) cabezaNivel[nivel] = siguienteDe[r];
+        else siguienteDe[anteriorDe[r]] = siguienteDe[r];
+        if (siguienteDe[r] == NINGUNO) colaNivel[nivel] = anteriorDe[r];
+        else anteriorDe[siguienteDe[r]] = anteriorDe[r];
+        if (cabezaNivel[nivel] == NINGUNO) mapaNiveles &= ~(1ull << nivel);
+    }
+
+public:
+    ColaNiveles() {
+        mapaNiveles = 0;
+        for (int i = 0; i < NIVELES; i++) {
+            cabezaNivel[i] = NINGUNO;
+            colaNivel[i] = NINGUNO;
+        }
+        entradas = NULL;
+        siguienteDe = NULL;
+        anteriorDe = NULL;
+        encolado = NULL;
+        capacidadRanuras = 0;
+        cantidad = 0;
+        contadorLlegada = 0;
+    }
+
+    bool contiene(HandleProceso h) const {
+        return h.indice < capacidadRanuras && encolado[h.indice] &&
+               entradas[h.indice].proceso == h;
+    }
+
+    // Encola al final del nivel de su prioridad; false si ya estaba
+    bool insertar(HandleProceso h, int id, int prioridad) {
+        asegurarRanuras(h.indice);
+        int r = (int)h.indice;
+        if (encolado[r]) {
+            if (entradas[r].proceso == h) return false;
+            // La ranura fue reutilizada: la entrada vieja es de un proceso eliminado
+            desenlazar(r);
+            cantidad--;
+        }
+        entradas[r].proceso = h;
+        entradas[r].id = id;
+        entradas[r].prioridad = prioridad;
+        entradas[r].clave = contadorLlegada++;
+        encolado[r] = true;
+        enlazarAlFinal(r);
+        cantidad++;
+        return true;
+    }
+
+    // Devuelve una entrada ya extraida a su lugar por orden de llegada
+    bool reinsertar(const Entrada& e) {
+        asegurarRanuras(e.proceso.indice);
+        int r = (int)e.proceso.indice;
+        if (encolado[r]) {
+            if (entradas[r].proceso == e.proceso) return false;
+            desenlazar(r);
+            cantidad--;
+        }
+        entradas[r] = e;
+        encolado[r] = true;
+        enlazarPorLlegada(r);
+        cantidad++;
+        return true;
+    }
+
+    // Toma la cabeza del nivel mas alto no vacio
+    bool extraer(Entrada& salida) {
+        if (mapaNiveles == 0) return false;
+        int nivel = __builtin_ctzll(mapaNiveles);   // Una sola instruccion (bsf/tzcnt)
+        int r = cabezaNivel[nivel];
+        salida = entradas[r];
+        desenlazar(r);
+        encolado[r] = false;
+        cantidad--;
+        return true;
+    }
+
+    // Mueve el proceso al final de la cola de su nuevo nivel (O(1))
+    bool actualizarPrioridad(HandleProceso h, int nuevaPrioridad) {
+        if (!contiene(h)) return false;
+        int r = (int)h.indice;
+        desenlazar(r);
+        entradas[r].prioridad = nuevaPrioridad;
+        enlazarAlFinal(r);
+        return true;
+    }
+
+    bool eliminar(HandleProceso h) {
+        if (!contiene(h)) return false;
+        desenlazar((int)h.indice);
+        encolado[h.indice] = false;
+        cantidad--;
+        return true;
+    }
+
+    int tamanio() const {
+        return cantidad;
+    }
+
+    bool estaVacia() const {
+        return cantidad == 0;
+    }
+
+    // Recorre los niveles de mayor a menor prioridad (ya quedan en orden)
+    void copiarOrdenado(Entrada* destino) const {
+        int k = 0;
+        for (int nivel = 0; nivel < NIVELES; nivel++) {
+            for (int r = cabezaNivel[nivel]; r != NINGUNO; r = siguienteDe[r]) {
+                destino[k++] = entradas[r];
+            }
+        }
+    }
+
+    ~ColaNiveles() {
+        delete[] entradas;
+        delete[] siguienteDe;
+        delete[] anteriorDe;
+        delete[] encolado;
+    }
+};
+
+// ============================================
+// COLA CFS (COMPLETELY FAIR SCHEDULER)
+// Los listos se ordenan por tiempo virtual de ejecucion (vruntime) en
+// un ArbolRojoNegro: el proximo es el de menor vruntime, que el arbol
+// tiene en cache (O(1)), e insertar o quitar cuesta O(log n). Cada
+// microsegundo de CPU avanza el vruntime en proporcion inversa al peso
+// de la prioridad: un proceso de mas peso recibe mas CPU, pero ninguno
+// queda postergado para siempre. La porcion de CPU reparte una latencia
+// objetivo entre los listos segun su peso.
+// ============================================
+
+// Peso de cada prioridad (1 a 10): tabla nice de Linux de nice 8 a -10,
+// de a dos niveles (cada prioridad recibe ~1.56 veces la CPU de la anterior)
+int pesoDePrioridad(int prioridad) {
+    static const int PESOS[10] = {172, 272, 423, 655, 1024, 1586, 2501, 3906, 6100, 9548};
+    if (prioridad < 1) prioridad = 1;
+    if (prioridad > 10) prioridad = 10;
+    return PESOS[prioridad - 1];
+}
+
+class ColaCFS : public PoliticaBase {
+public:
+    typedef EntradaCola Entrada;    // clave = vruntime al encolar
+
+    static const char* nombre() {
+        return "arbol CFS por vruntime";
+    }
+
+    static const long long LATENCIA_US = 6000;         // Todos los listos ejecutan en este lapso
+    static const long long GRANULARIDAD_US = 750;      // Porcion minima
+
+private:
+    // A igual vruntime el arbol inserta a la derecha: FIFO
+    struct OrdenPorVruntime {
+        static bool menor(const Entrada& a, const Entrada& b) {
+            return a.clave < b.clave;
+        }
+    };
+    typedef ArbolRojoNegro<Entrada, OrdenPorVruntime> Arbol;
+    typedef Arbol::Nodo NodoArbol;
+
+    // El vruntime avanza en 1/1024 de microsegundo de un proceso de peso 1024
+    static const unsigned long long ESCALA = 1024ULL * 1024;
+
+    Arbol arbol;
+    NodoArbol** nodoDe;                 // Indexados por ranura del handle (NULL = no encolado)
+    unsigned long long* vruntimeDe;     // Se conserva mientras el proceso no esta en la cola
+    unsigned int* generacionDe;         // Generacion duenia del vruntime de la ranura
+    unsigned int capacidadRanuras;
+
+    unsigned long long minVruntime;     // Nunca retrocede
+    long long pesoTotal;                // Suma de los pesos encolados
+
+    void asegurarRanuras(unsigned int indice) {
+        if (indice < capacidadRanuras) return;
+        unsigned int nueva = (capacidadRanuras == 0) ? 16 : capacidadRanuras;
+        while (nueva <= indice) nueva *= 2;
+
+        NodoArbol** nuevosNodos = new NodoArbol*[nueva];
+        unsigned long long* nuevosVruntime = new unsigned long long[nueva];
+        unsigned int* nuevasGeneraciones = new unsigned int[nueva];
+        for (unsigned int i = 0; i < capacidadRanuras; i++) {
+            nuevosNodos[i] = nodoDe[i];
+            nuevosVruntime[i] = vruntimeDe[i];
+            nuevasGeneraciones[i] = generacionDe[i];
+        }
+        for (unsigned int i = capacidadRanuras; i < nueva; i++) {
+            nuevosNodos[i] = NULL;
+            nuevosVruntime[i] = 0;
+            nuevasGeneraciones[i] = 0;
+        }
+        delete[] nodoDe;
+        delete[] vruntimeDe;
+        delete[] generacionDe;
+        nodoDe = nuevosNodos;
+        vruntimeDe = nuevosVruntime;
+        generacionDe = nuevasGeneraciones;
+        capacidadRanuras = nueva;
+    }
+
+    void quitarRanura(unsigned int r) {
+        pesoTotal -= pesoDePrioridad(nodoDe[r]->valor.prioridad);
+        arbol.eliminar(nodoDe[r]);
+        nodoDe[r] = NULL;
+    }
+
+    void colocar(const Entrada& e, bool delanteDeIguales = false) {
+        nodoDe[e.proceso.indice] = arbol.insertar(e, delanteDeIguales);
+        pesoTotal += pesoDePrioridad(e.prioridad);
+    }
+
+public:
+    ColaCFS() {
+        nodoDe = NULL;
+        vruntimeDe = NULL;
+        generacionDe = NULL;
+        capacidadRanuras = 0;
+        minVruntime = 0;
+        pesoTotal = 0;
+    }
+
+    bool contiene(HandleProceso h) const {
+        return h.indice < capacidadRanuras && nodoDe[h.indice] != NULL &&
+               nodoDe[h.indice]->valor.proceso == h;
+    }
+
+    // Encola con su vruntime, o con el minimo si es nuevo o viene de
+    // esperar (no acumula credito mientras no compite); false si ya estaba
+    bool insertar(HandleProceso h, int id, int prioridad) {
+        asegurarRanuras(h.indice);
+        unsigned int r = h.indice;
+        if (nodoDe[r] != NULL) {
+            if (nodoDe[r]->valor.proceso == h) return false;
+            // La ranura fue reutilizada: la entrada vieja es de un proceso eliminado
+            quitarRanura(r);
+        }
+        if (generacionDe[r] != h.generacion || vruntimeDe[r] < minVruntime) {
+            generacionDe[r] = h.generacion;
+            vruntimeDe[r] = minVruntime;
+        }
+        Entrada e;
+        e.proceso = h;
+        e.id = id;
+        e.prioridad = prioridad;
+        e.clave = vruntimeDe[r];
+        colocar(e);
+        return true;
+    }
+
+    // Devuelve una entrada ya extraida con el vruntime que tenia, aunque
+    // el minimo haya avanzado mientras estaba afuera, y delante de los de
+    // igual vruntime (que llegaron despues que ella)
+    bool reinsertar(const Entrada& e) {
+        asegurarRanuras(e.proceso.indice);
+        unsigned int r = e.proceso.indice;
+        if (nodoDe[r] != NULL) {
+            if (nodoDe[r]->valor.proceso == e.proceso) return false;
+            quitarRanura(r);
+        }
+        colocar(e, true);
+        return true;
+    }
+
+    // Extrae el de menor vruntime; false si esta vacia
+    bool extraer(Entrada& salida) {
+        NodoArbol* n = arbol.primero();
+        if (n == NULL) return false;
+        salida = n->valor;
+        quitarRanura(salida.proceso.indice);
+        if (salida.clave > minVruntime) minVruntime = salida.clave;
+        return true;
+    }
+
+    // Cambia el peso de un proceso encolado; conserva su vruntime
+    bool actualizarPrioridad(HandleProceso h, int nuevaPrioridad) {
+        if (!contiene(h)) return false;
+        Entrada e = nodoDe[h.indice]->valor;
+        quitarRanura(h.indice);
+        e.prioridad = nuevaPrioridad;
+        colocar(e);
+        return true;
+    }
+
+    bool eliminar(HandleProceso h) {
+        if (!contiene(h)) return false;
+        quitarRanura(h.indice);
+        return true;
+    }
+
+    // Porcion de la latencia proporcional al peso frente a los encolados
+    long long porcionDeCPU(int prioridad, long long restante) const {
+        long long peso = pesoDePrioridad(prioridad);
+        long long porcion = LATENCIA_US * peso / (pesoTotal + peso);
+        if (porcion < GRANULARIDAD_US) porcion = GRANULARIDAD_US;
+        return (porcion < restante) ? porcion : restante;
+    }
+
+    // Carga al vruntime del proceso la CPU que uso (ponderada por su peso)
+    void cargarTiempo(HandleProceso h, int prioridad, long long usadoUs) {
+        asegurarRanuras(h.indice);
+        if (generacionDe[h.indice] != h.generacion) return;
+        vruntimeDe[h.indice] += (unsigned long long)usadoUs * ESCALA / pesoDePrioridad(prioridad);
+    }
+
+    int tamanio() const {
+        return (int)arbol.tamanio();
+    }
+
+    bool estaVacia() const {
+        return arbol.estaVacio();
+    }
+
+    // Recorrido en orden del arbol = orden de salida
+    void copiarOrdenado(Entrada* destino) const {
+        int k = 0;
+        for (NodoArbol* n = arbol.primero(); n != NULL; n = arbol.siguiente(n)) {
+            destino[k++] = n->valor;
+        }
+    }
+
+    ~ColaCFS() {
+        delete[] nodoDe;
+        delete[] vruntimeDe;
+        delete[] generacionDe;
+    }
+};
+
+// ============================================
+// POLITICAS CLASICAS: FCFS, SJF, SRTF, ROUND ROBIN Y LOTERIA
+// FCFS y SJF son el monticulo indexado con otro criterio (llegada y
+// rafaga prevista); SRTF agrega el desalojo al llegar uno mas corto y
+// round robin reparte la CPU de a un quantum. La loteria sortea la CPU
+// en proporcion al peso de la prioridad (como CFS, pero al azar).
+// ============================================
+const long long QUANTUM_SIMULADO_US = 2000;     // Quantum por defecto (round robin, loteria)
+
+class ColaFCFS : public MonticuloIndexado<4, OrdenPorLlegada> {
+public:
+    static const char* nombre() {
+        return "FCFS";
+    }
+};
+
+class ColaSJF : public MonticuloIndexado<4, OrdenPorRafaga> {
+public:
+    static const char* nombre() {
+        return "SJF";
+    }
+};
+
+// SJF con desalojo: el que pasa a listo con una rafaga menor que lo que
+// le falta al que esta en CPU lo desaloja
+class ColaSRTF : public ColaSJF {
+public:
+    static const bool DESALOJA_AL_LLEGAR = true;
+
+    static const char* nombre() {
+        return "SRTF";
+    }
+
+    bool desaloja(int, long long rafagaNueva, int, long long restanteEnCPU) const {
+        return rafagaNueva < restanteEnCPU;
+    }
+};
+
+class ColaRoundRobin : public ColaFCFS {
+private:
+    long long quantum;
+
+public:
+    static const char* nombre() {
+        return "round robin";
+    }
+
+    ColaRoundRobin() {
+        quantum = QUANTUM_SIMULADO_US;
+    }
+
+    void fijarQuantum(long long q) {
+        if (q > 0) quantum = q;
+    }
+
+    long long porcionDeCPU(int, long long restante) const {
+        return (quantum < restante) ? quantum : restante;
+    }
+};
+
+// Cada proceso tiene tantos boletos como el peso de su prioridad y cada
+// decision sortea uno. Los boletos viven en un arbol de Fenwick indexado
+// por ranura del handle: sortear, insertar y quitar cuestan O(log n).
+class ColaLoteria : public PoliticaBase {
+public:
+    typedef EntradaCola Entrada;    // clave = boletos
+
+    static const char* nombre() {
+        return "loteria";
+    }
+
+private:
+    Entrada* entradas;                  // Indexados por ranura del handle
+    bool* encolado;
+    long long* boletosHasta;            // Arbol de Fenwick (base 1) sobre las ranuras
+    unsigned int capacidadRanuras;      // Potencia de 2
+    int cantidad;
+    long long totalBoletos;
+    unsigned long long estado;          // xorshift64*
+    long long quantum;
+
+    void sumarBoletos(unsigned int ranura, long long delta) {
+        for (unsigned int i = ranura + 1; i <= capacidadRanuras; i += i & (0u - i)) boletosHasta[i] += delta;
+    }
+
+    // Ranura que tiene el boleto numero b (0 <= b < totalBoletos)
+    unsigned int ranuraDelBoleto(long long b) const {
+        unsigned int pos = 0;
+        for (unsigned int paso = capacidadRanuras; paso > 0; paso >>= 1) {
+            if (pos + paso <= capacidadRanuras && boletosHasta[pos + paso] <= b) {
+                pos += paso;
+                b -= boletosHasta[pos];
+            }
+        }
+        return pos;
+    }
+
+    void asegurarRanuras(unsigned int indice) {
+        if (indice < capacidadRanuras) return;
+        unsigned int nueva = (capacidadRanuras == 0) ? 16 : capacidadRanuras;
+        while (nueva <= indice) nueva *= 2;
+
+        Entrada* nuevasEntradas = new Entrada[nueva];
+        bool* nuevoEncolado = new bool[nueva];
+        for (unsigned int i = 0; i < capacidadRanuras; i++) {
+            nuevasEntradas[i] = entradas[i];
+            nuevoEncolado[i] = encolado[i];
+        }
+        for (unsigned int i = capacidadRanuras; i < nueva; i++) nuevoEncolado[i] = false;
+        delete[] entradas;
+        delete[] encolado;
+        delete[] boletosHasta;
+        entradas = nuevasEntradas;
+        encolado = nuevoEncolado;
+        capacidadRanuras = nueva;
+
+        // Reconstruir el arbol de Fenwick en O(n)
+        boletosHasta = new long long[nueva + 1];
+        boletosHasta[0] = 0;
+        for (unsigned int i = 1; i <= nueva; i++) {
+            boletosHasta[i] = encolado[i - 1] ? entradas[i - 1].clave : 0;
+        }
+        for (unsigned int i = 1; i <= nueva; i++) {
+            unsigned int padre = i + (i & (0u - i));
+            if (padre <= nueva) boletosHasta[padre] += boletosHasta[i];
+        }
+    }
+
+    void quitarRanura(unsigned int r) {
+        sumarBoletos(r, -(long long)entradas[r].clave);
+        totalBoletos -= (long long)entradas[r].clave;
+        encolado[r] = false;
+        cantidad--;
+    }
+
+    void colocar(unsigned int r, HandleProceso h, int id, int prioridad) {
+        entradas[r].proceso = h;
+        entradas[r].id = id;
+        entradas[r].prioridad = prioridad;
+        entradas[r].clave = (unsigned long long)pesoDePrioridad(prioridad);
+        encolado[r] = true;
+        sumarBoletos(r, (long long)entradas[r].clave);
+        totalBoletos += (long long)entradas[r].clave;
+        cantidad++;
+    }
+
+public:
+    ColaLoteria() {
+        entradas = NULL;
+        encolado = NULL;
+        boletosHasta = NULL;
+        capacidadRanuras = 0;
+        cantidad = 0;
+        totalBoletos = 0;
+        estado = 0x9E3779B97F4A7C15ULL;
+        quantum = QUANTUM_SIMULADO_US;
+    }
+
+    bool contiene(HandleProceso h) const {
+        return h.indice < capacidadRanuras && encolado[h.indice] && entradas[h.indice].proceso == h;
+    }
+
+    bool insertar(HandleProceso h, int id, int prioridad) {
+        asegurarRanuras(h.indice);
+        unsigned int r = h.indice;
+        if (encolado[r]) {
+            if (entradas[r].proceso == h) return false;
+            // La ranura fue reutilizada: la entrada vieja es de un proceso eliminado
+            quitarRanura(r);
+        }
+        colocar(r, h, id, prioridad);
+        return true;
+    }
+
+    // Sin orden de llegada: vuelve a participar del sorteo con sus boletos
+    bool reinsertar(const Entrada& e) {
+        return insertar(e.proceso, e.id, e.prioridad);
+    }
+
+    // Sortea un boleto entre todos los encolados; false si esta vacia
+    bool extraer(Entrada& salida) {
+        if (cantidad == 0) return false;
+        estado ^= estado >> 12;
+        estado ^= estado << 25;
+        estado ^= estado >> 27;
+        unsigned long long azar = (estado * 0x2545F4914F6CDD1DULL) >> 11;
+        unsigned int r = ranuraDelBoleto((long long)(azar % (unsigned long long)totalBoletos));
+        salida = entradas[r];
+        quitarRanura(r);
+        return true;
+    }
+
+    bool actualizarPrioridad(HandleProceso h, int nuevaPrioridad) {
+        if (!contiene(h)) return false;
+        Entrada e = entradas[h.indice];
+        quitarRanura(h.indice);
+        colocar(h.indice, e.proceso, e.id, nuevaPrioridad);
+        return true;
+    }
+
+    bool eliminar(HandleProceso h) {
+        if (!contiene(h)) return false;
+        quitarRanura(h.indice);
+        return true;
+    }
+
+    void fijarQuantum(long long q) {
+        if (q > 0) quantum = q;
+    }
+
+    long long porcionDeCPU(int, long long restante) const {
+        return (quantum < restante) ? quantum : restante;
+    }
+
+    int tamanio() const {
+        return cantidad;
+    }
+
+    bool estaVacia() const {
+        return cantidad == 0;
+    }
+
+    // La loteria no tiene orden de salida: se copian por mas boletos primero
+    void copiarOrdenado(Entrada* destino) const {
+        int k = 0;
+        for (int prioridad = 10; prioridad >= 1; prioridad--) {
+            for (unsigned int r = 0; r < capacidadRanuras; r++) {
+                if (!encolado[r]) continue;
+                int p = entradas[r].prioridad;
+                if (p > 10) p = 10;
+                if (p < 1) p = 1;
+                if (p == prioridad) destino[k++] = entradas[r];
+            }
+        }
+    }
+
+    ~ColaLoteria() {
+        delete[] entradas;
+        delete[] encolado;
+        delete[] boletosHasta;
+    }
+};
+
+// ============================================
+// PLANIFICADOR MULTINUCLEO CON ROBO DE TRABAJO
+// Cada nucleo simulado tiene su propia cola de listos y un hilo del
+// sistema que la atiende. Las colas son deques de Chase-Lev: el nucleo
+// duenio apila y desapila por abajo sin bloqueos y, cuando se queda sin
+// trabajo, le roba por arriba a otro nucleo elegido al azar (un solo
+// compare-and-swap). Un proceso que ejecuta en otro nucleo que el
+// anterior cuenta como migracion.
+// ============================================
+
+// Deque de Chase-Lev de enteros (indices de tareas) con los ordenes de
+// memoria de C11 de Le, Pop, Cohen y Zappa Nardelli (2013). El arreglo
+// circular se duplica al llenarse; los anteriores se liberan recien al
+// destruir la deque porque un ladron puede estar leyendo de ellos.
+class DequeRobo {
+private:
+    struct Arreglo {
+        long long mascara;          // Capacidad - 1 (la capacidad es potencia de 2)
+        atomic<int>* datos;
+        Arreglo* anterior;          // Arreglo reemplazado al crecer
+
+        Arreglo(long long capacidad, atomic<int>* _datos, Arreglo* _anterior) {
+            mascara = capacidad - 1;
+            datos = _datos;
+            anterior = _anterior;
+        }
+
+        int leer(long long i) const {
+            return datos[i & mascara].load(memory_order_relaxed);
+        }
+
+        void escribir(long long i, int valor) {
+            datos[i & mascara].store(valor, memory_order_relaxed);
+        }
+
+        ~Arreglo() {
+            delete[] datos;
+        }
+    };
+
+    atomic<long long> arriba;       // Proximo a robar (lo avanzan los ladrones)
+    char separacion[64];            // arriba y abajo en lineas de cache distintas
+    atomic<long long> abajo;        // Proxima posicion libre (solo la mueve el duenio)
+    atomic<Arreglo*> arreglo;
+    char relleno[64];               // Sin compartir linea con la deque vecina
+
+    static Arreglo* nuevoArreglo(long long capacidad, Arreglo* anterior) {
+        atomic<int>* datos = new atomic<int>[capacidad];
+        return new Arreglo(capacidad, datos, anterior);
+    }
+
+    Arreglo* crecer(Arreglo* a, long long t, long long b) {
+        Arreglo* nuevo = nuevoArreglo(2 * (a->mascara + 1), a);
+        for (long long i = t; i < b; i++) nuevo->escribir(i, a->leer(i));
+        arreglo.store(nuevo, memory_order_release);
+        return nuevo;
+    }
+
+public:
+    enum ResultadoRobo { ROBADO, VACIA, CONFLICTO };
+
+    DequeRobo() {
+        arriba.store(0);
+        abajo.store(0);
+        arreglo.store(nuevoArreglo(64, NULL));
+    }
+
+    // Solo el duenio
+    void apilar(int valor) {
+        long long b = abajo.load(memory_order_relaxed);
+        long long t = arriba.load(memory_order_acquire);
+        Arreglo* a = arreglo.load(memory_order_relaxed);
+        if (b - t > a->mascara) a = crecer(a, t, b);
+        a->escribir(b, valor);
+        abajo.store(b + 1, memory_order_release);
+    }
+
+    // Solo el duenio: toma el ultimo apilado; false si la deque quedo vacia
+    bool desapilar(int& valor) {
+        long long b = abajo.load(memory_order_relaxed) - 1;
+        Arreglo* a = arreglo.load(memory_order_relaxed);
+        abajo.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        long long t = arriba.load(memory_order_relaxed);
+        if (t > b) {
+            abajo.store(b + 1, memory_order_relaxed);
+            return false;
+        }
+        valor = a->leer(b);
+        if (t < b) return true;
+
+        // Queda uno solo: se compite con los ladrones por el
+        bool gano = arriba.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+        abajo.store(b + 1, memory_order_relaxed);
+        return gano;
+    }
+
+    // Cualquier hilo: toma el mas viejo. CONFLICTO si otro lo tomo antes
+    ResultadoRobo robar(int& valor) {
+        long long t = arriba.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        long long b = abajo.load(memory_order_acquire);
+        if (t >= b) return VACIA;
+        Arreglo* a = arreglo.load(memory_order_acquire);
+        valor = a->leer(t);
+        if (!arriba.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+            return CONFLICTO;
+        }
+        return ROBADO;
+    }
+
+    ~DequeRobo() {
+        Arreglo* a = arreglo.load();
+        while (a != NULL) {
+            Arreglo* anterior = a->anterior;
+            delete a;
+            a = anterior;
+        }
+    }
+};
+
+// Proceso repartido a un nucleo. La tabla de procesos no guarda rafagas:
+// el planificador le asigna a cada uno una cantidad de quanta de trabajo.
+struct TareaNucleo {
+    HandleProceso proceso;
+    int id;
+    int prioridad;
+    int quantaRestantes;
+    int ultimoNucleo;               // Donde ejecuto por ultima vez (o donde se ubico)
+};
+
+// Contadores de un nucleo; cada hilo escribe solo los suyos
+struct EstadisticasNucleo {
+    long long quanta;
+    long long terminadas;
+    long long robos;
+    long long robosFallidos;        // Victima vacia o gano otro ladron
+    long long migraciones;
+    double segundosOcupado;         // Ejecutando quanta (no buscando trabajo)
+    unsigned int resultado;         // Resultado del trabajo simulado (evita que se omita)
+    char relleno[64];               // Sin compartir linea de cache con el nucleo vecino
+};
+
+class PlanificadorMultinucleo {
+private:
+    int nucleos;
+    bool robo;                      // false: cada nucleo solo atiende su cola
+    long long pasosPorQuantum;
+    DequeRobo* colas;
+    EstadisticasNucleo* estadisticas;
+    TareaNucleo* tareas;
+    int* ordenTerminacion;
+    atomic<int> pendientes;         // Tareas sin terminar (los hilos salen en 0)
+    atomic<int> terminadas;
+    int cantidadTareas;
+    double segundos;
+
+    // Trabajo de CPU de un quantum: pasos de xorshift encadenados
+    static unsigned int trabajoSimulado(long long pasos, unsigned int x) {
+        for (long long i = 0; i < pasos; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+        }
+        return x;
+    }
+
+    // Pasos de xorshift por nanosegundo en este equipo (la mejor de 3 medidas)
+    static double calibrar() {
+        const long long pasos = 1 << 22;
+        double mejor = 1e30;
+        unsigned int x = 2463534242u;
+        for (int i = 0; i < 3; i++) {
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            x = trabajoSimulado(pasos, x);
+            double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - inicio).count();
+            if (ns < mejor) mejor = ns;
+        }
+        volatile unsigned int resultado = x;    // Se usa el resultado: el bucle no se omite
+        (void)resultado;
+        return pasos / mejor;
+    }
+
+    static double pasosPorNs() {
+        static double calibrado = calibrar();   // Una sola vez
+        return calibrado;
+    }
+
+    // Prueba hasta nucleos - 1 victimas al azar
+    bool robarAlguna(int nucleo, int& tarea, unsigned int& semilla, EstadisticasNucleo& e) {
+        for (int intento = 1; intento < nucleos; intento++) {
+            semilla ^= semilla << 13;
+            semilla ^= semilla >> 17;
+            semilla ^= semilla << 5;
+            int victima = (int)(semilla % (unsigned int)(nucleos - 1));
+            if (victima >= nucleo) victima++;
+            if (colas[victima].robar(tarea) == DequeRobo::ROBADO) {
+                e.robos++;
+                return true;
+            }
+            e.robosFallidos++;
+        }
+        return false;
+    }
+
+    // Bucle del hilo de un nucleo: su cola primero, despues robar
+    void atender(int nucleo) {
+        EstadisticasNucleo& e = estadisticas[nucleo];
+        unsigned int semilla = 2463534242u + 7919u * nucleo;
+        unsigned int resultado = nucleo + 1;
+        int t;
+        while (pendientes.load(memory_order_acquire) > 0) {
+            if (!colas[nucleo].desapilar(t)
+                && (!robo || nucleos == 1 || !robarAlguna(nucleo, t, semilla, e))) {
+                this_thread::yield();       // Sin trabajo: cede el procesador del equipo
+                continue;
+            }
+            TareaNucleo& tarea = tareas[t];
+            if (tarea.ultimoNucleo != nucleo) {
+                e.migraciones++;
+                tarea.ultimoNucleo = nucleo;
+            }
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            resultado = trabajoSimulado(pasosPorQuantum, resultado);
+            e.segundosOcupado += chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+            e.quanta++;
+            if (--tarea.quantaRestantes > 0) {
+                colas[nucleo].apilar(t);    // Vuelve abajo: los ladrones toman las de arriba
+                continue;
+            }
+            e.terminadas++;
+            ordenTerminacion[terminadas.fetch_add(1)] = t;
+            pendientes.fetch_sub(1, memory_order_release);
+        }
+        e.resultado = resultado;
+    }
+
+public:
+    static const int MAX_NUCLEOS = 64;
+
+    PlanificadorMultinucleo(int _nucleos, long long quantumNs, bool _robo = true) {
+        nucleos = (_nucleos < 1) ? 1 : (_nucleos > MAX_NUCLEOS ? MAX_NUCLEOS : _nucleos);
+        robo = _robo;
+        pasosPorQuantum = (long long)(quantumNs * pasosPorNs());
+        if (pasosPorQuantum < 1) pasosPorQuantum = 1;
+        colas = NULL;
+        estadisticas = new EstadisticasNucleo[nucleos];
+        memset(estadisticas, 0, sizeof(EstadisticasNucleo) * nucleos);
+        tareas = NULL;
+        ordenTerminacion = NULL;
+        cantidadTareas = 0;
+        segundos = 0;
+    }
+
+    // Ejecuta todas las tareas hasta terminarlas. Vienen en orden de
+    // prioridad y se reparten en ronda (o todas al nucleo 0); cada nucleo
+    // empieza por la de mayor prioridad. ordenTerminacion recibe los
+    // indices de las tareas en el orden en que terminaron.
+    void ejecutar(TareaNucleo* _tareas, int cantidad, int* _ordenTerminacion, bool repartir = true) {
+        tareas = _tareas;
+        ordenTerminacion = _ordenTerminacion;
+        cantidadTareas = cantidad;
+        delete[] colas;
+        colas = new DequeRobo[nucleos];
+        memset(estadisticas, 0, sizeof(EstadisticasNucleo) * nucleos);
+        for (int k = cantidad - 1; k >= 0; k--) {
+            int nucleo = repartir ? k % nucleos : 0;
+            tareas[k].ultimoNucleo = nucleo;
+            colas[nucleo].apilar(k);
+        }
+        pendientes.store(cantidad);
+        terminadas.store(0);
+
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        thread* hilos = new thread[nucleos];
+        for (int n = 0; n < nucleos; n++) hilos[n] = thread(&PlanificadorMultinucleo::atender, this, n);
+        for (int n = 0; n < nucleos; n++) hilos[n].join();
+        segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        delete[] hilos;
+    }
+
+    int cantidadNucleos() const {
+        return nucleos;
+    }
+
+    double segundosTotales() const {
+        return segundos;
+    }
+
+    const EstadisticasNucleo& estadisticasDe(int nucleo) const {
+        return estadisticas[nucleo];
+    }
+
+    long long totalQuanta() const {
+        long long total = 0;
+        for (int n = 0; n < nucleos; n++) total += estadisticas[n].quanta;
+        return total;
+    }
+
+    long long totalRobos() const {
+        long long total = 0;
+        for (int n = 0; n < nucleos; n++) total += estadisticas[n].robos;
+        return total;
+    }
+
+    long long totalMigraciones() const {
+        long long total = 0;
+        for (int n = 0; n < nucleos; n++) total += estadisticas[n].migraciones;
+        return total;
+    }
+
+    // Fraccion del tiempo total que el nucleo estuvo ejecutando quanta
+    double ocupacion(int nucleo) const {
+        return (segundos > 0) ? estadisticas[nucleo].segundosOcupado / segundos : 0;
+    }
+
+    void mostrarEstadisticas() const {
+        long long quanta = totalQuanta();
+        unsigned int nucleosEquipo = thread::hardware_concurrency();
+        char linea[160];
+
+        cout << "\n========== EJECUCION EN " << nucleos << " NUCLEO(S) ==========\n";
+        sprintf(linea, "Procesos: %d | Quanta: %lld | Tiempo: %.1f ms | Rendimiento: %.0f quanta/s\n",
+                cantidadTareas, quanta, 1000.0 * segundos, (segundos > 0) ? quanta / segundos : 0.0);
+        cout << linea;
+        cout << "Nucleo  Quanta     Terminados  Ocupacion  Robos      Fallidos    Migraciones\n";
+        cout << "============================================================================\n";
+        for (int n = 0; n < nucleos; n++) {
+            const EstadisticasNucleo& e = estadisticas[n];
+            sprintf(linea, "%-7d %-10lld %-11lld %5.1f%%     %-10lld %-11lld %lld\n", n, e.quanta,
+                    e.terminadas, 100.0 * ocupacion(n), e.robos, e.robosFallidos, e.migraciones);
+            cout << linea;
+        }
+        cout << "============================================================================\n";
+        sprintf(linea, "Robos: %lld | Migraciones: %lld (%.2f%% de los quanta, %.0f por segundo)\n",
+                totalRobos(), totalMigraciones(), (quanta > 0) ? 100.0 * totalMigraciones() / quanta : 0.0,
+                (segundos > 0) ? totalMigraciones() / segundos : 0.0);
+        cout << linea;
+        if (nucleosEquipo != 0 && (unsigned int)nucleos > nucleosEquipo) {
+            cout << "(el equipo tiene " << nucleosEquipo << " nucleo(s): los hilos se reparten el tiempo)\n";
+        }
+    }
+
+    ~PlanificadorMultinucleo() {
+        delete[] colas;
+        delete[] estadisticas;
+    }
+};
+
+// ============================================
+// COLA DE ENVIOS (VARIOS PRODUCTORES, UN CONSUMIDOR)
+// Otros hilos le entregan procesos listos al planificador sin cerrojos:
+// cola intrusiva de Vyukov. Enviar es un exchange sobre la cabeza y un
+// store en el enlace del nodo anterior; el hilo del planificador la
+// vacia por lotes hacia su cola de listos. Hay un nodo por ranura de
+// handle, asi que cada proceso tiene a lo sumo un envio pendiente. Los
+// nodos viven en segmentos que nunca se mueven: el que envia para una
+// ranura sin segmento lo crea y lo publica con CAS, de modo que los
+// procesos creados despues de habilitar los envios tambien se aceptan.
+// ============================================
+class ColaEnvios {
+public:
+    enum ResultadoEnvio { ENVIADO, YA_PENDIENTE, FUERA_DE_RANGO };
+
+private:
+    struct NodoEnvio {
+        atomic<NodoEnvio*> siguiente;
+        atomic<bool> pendiente;         // La ranura tiene un envio sin drenar
+        HandleProceso proceso;
+    };
+
+    // El segmento k tiene NODOS_BASE << k nodos; entre todos cubren
+    // casi todo el rango de un indice de 32 bits
+    static const unsigned int NODOS_BASE = 64;
+    static const int SEGMENTOS = 26;
+    atomic<NodoEnvio*> segmentos[SEGMENTOS];
+    NodoEnvio centinela;                // La cola nunca queda sin nodos
+
+    char separacion[64];
+    atomic<NodoEnvio*> cabeza;          // Ultimo enviado (la mueven los productores)
+    char separacion2[64];
+    NodoEnvio* ultimo;                  // Proximo a drenar (solo el consumidor)
+    long long lotes;
+    long long drenados;
+    long long cortes;                   // Drenajes frenados por un envio a medio enlazar
+
+    // Nodo de la ranura, creando su segmento si falta; NULL si no entra
+    NodoEnvio* nodoDe(unsigned int ranura) {
+        unsigned long long s = ranura / NODOS_BASE + 1;
+        int k = 63 - __builtin_clzll(s);
+        if (k >= SEGMENTOS) return NULL;
+        unsigned long long posicion = ranura - (unsigned long long)NODOS_BASE * ((1ull << k) - 1);
+        NodoEnvio* segmento = segmentos[k].load(memory_order_acquire);
+        if (segmento == NULL) {
+            unsigned int tamanio = NODOS_BASE << k;
+            NodoEnvio* nuevo = new NodoEnvio[tamanio];
+            for (unsigned int i = 0; i < tamanio; i++) nuevo[i].pendiente.store(false, memory_order_relaxed);
+            if (segmentos[k].compare_exchange_strong(segmento, nuevo, memory_order_acq_rel,
+                                                     memory_order_acquire)) {
+                segmento = nuevo;
+            } else {
+                delete[] nuevo;         // Otro hilo lo publico primero
+            }
+        }
+        return &segmento[posicion];
+    }
+
+    void empujar(NodoEnvio* n) {
+        n->siguiente.store(NULL, memory_order_relaxed);
+        NodoEnvio* anterior = cabeza.exchange(n, memory_order_acq_rel);
+        // Hasta este store la cadena queda cortada en 'anterior'
+        anterior->siguiente.store(n, memory_order_release);
+    }
+
+    enum ResultadoSacar { SACADO, VACIA, CORTADA };
+
+    ResultadoSacar sacar(NodoEnvio*& salida) {
+        NodoEnvio* t = ultimo;
+        NodoEnvio* sig = t->siguiente.load(memory_order_acquire);
+        if (t == &centinela) {
+            if (sig == NULL) return VACIA;
+            ultimo = sig;
+            t = sig;
+            sig = t->siguiente.load(memory_order_acquire);
+        }
+        if (sig != NULL) {
+            ultimo = sig;
+            salida = t;
+            return SACADO;
+        }
+        // t es el ultimo enlazado: si un productor ya movio la cabeza pero
+        // no enlazo su nodo, se espera al proximo drenaje
+        if (t != cabeza.load(memory_order_acquire)) return CORTADA;
+        // Se vuelve a poner el centinela detras de t para poder sacarlo
+        empujar(&centinela);
+        sig = t->siguiente.load(memory_order_acquire);
+        if (sig == NULL) return CORTADA;
+        ultimo = sig;
+        salida = t;
+        return SACADO;
+    }
+
+public:
+    ColaEnvios() {
+        for (int k = 0; k < SEGMENTOS; k++) segmentos[k].store(NULL, memory_order_relaxed);
+        centinela.siguiente.store(NULL, memory_order_relaxed);
+        cabeza.store(&centinela, memory_order_relaxed);
+        ultimo = &centinela;
+        lotes = 0;
+        drenados = 0;
+        cortes = 0;
+    }
+
+    // Crea de antemano los segmentos de las ranuras 0..ranuras-1, para
+    // que los productores no reserven memoria en el camino caliente.
+    // Es opcional y se puede repetir desde cualquier hilo.
+    void reservar(unsigned int ranuras) {
+        for (int k = 0; k < SEGMENTOS; k++) {
+            unsigned long long inicio = (unsigned long long)NODOS_BASE * ((1ull << k) - 1);
+            if (inicio >= ranuras) return;
+            nodoDe((unsigned int)inicio);
+        }
+    }
+
+    // Desde cualquier hilo, sin bloquear (salvo la primera vez que se usa
+    // un segmento, que se reserva). YA_PENDIENTE si el proceso tiene un
+    // envio sin drenar; FUERA_DE_RANGO si el indice no entra en ningun segmento.
+    ResultadoEnvio enviar(HandleProceso h) {
+        NodoEnvio* n = nodoDe(h.indice);
+        if (n == NULL) return FUERA_DE_RANGO;
+        if (n->pendiente.exchange(true, memory_order_acquire)) return YA_PENDIENTE;
+        n->proceso = h;
+        empujar(n);
+        return ENVIADO;
+    }
+
+    // Solo desde el hilo consumidor: saca hasta 'maximo' envios en orden
+    // de llegada y retorna cuantos saco
+    int drenar(HandleProceso* destino, int maximo) {
+        int k = 0;
+        NodoEnvio* n = NULL;
+        while (k < maximo) {
+            ResultadoSacar r = sacar(n);
+            if (r == CORTADA) cortes++;
+            if (r != SACADO) break;
+            destino[k++] = n->proceso;
+            // El nodo ya no es alcanzable: el proceso puede volver a enviarse
+            n->pendiente.store(false, memory_order_release);
+        }
+        if (k > 0) {
+            lotes++;
+            drenados += k;
+        }
+        return k;
+    }
+
+    long long cantidadLotes() const {
+        return lotes;
+    }
+
+    long long cantidadDrenados() const {
+        return drenados;
+    }
+
+    long long cantidadCortes() const {
+        return cortes;
+    }
+
+    ~ColaEnvios() {
+        for (int k = 0; k < SEGMENTOS; k++) delete[] segmentos[k].load(memory_order_relaxed);
+    }
+};
+
+// ============================================
+// SIMULACION POR EVENTOS DISCRETOS
+// El tiempo salta de un evento al siguiente (llegada de un proceso, fin
+// de una rafaga de CPU, fin de una espera de E/S), sacados en orden de
+// una cola de prioridad. Cada proceso alterna rafagas de CPU con esperas
+// de E/S y la cola de listos es la misma estructura del planificador,
+// que tambien decide la porcion de CPU: el monticulo y la cola multinivel
+// dejan terminar la rafaga; CFS desaloja al vencer la porcion y el
+// proceso vuelve a la cola. Los tiempos son microsegundos simulados.
+// ============================================
+
+// Proceso de una carga simulada. Las duraciones no se guardan: salen de
+// la semilla y del numero de rafaga (se pueden consultar por adelantado).
+struct ProcesoSimulado {
+    int id;
+    int prioridad;
+    int rafagas;                    // Rafagas de CPU (entre cada par, una espera de E/S)
+    unsigned int semilla;
+    long long llegada;
+    long long rafagaFija;           // > 0: todas las rafagas duran esto (limitado por CPU)
+};
+
+// Resultado por proceso; espera = retorno - CPU - E/S
+struct ResultadoSimulado {
+    long long primeraCPU;           // -1 hasta que ejecuta por primera vez
+    long long fin;                  // -1 si no termino antes del horizonte
+    long long cpu;
+    long long es;
+};
+
+struct EstadisticasSimulacion {
+    int procesos;
+    int terminados;                 // Las medias y maximos son sobre estos
+    int cpus;
+    long long eventos;
+    long long desalojos;            // Porciones cortadas antes del fin de la rafaga
+    long long decisiones;           // Veces que se eligio un proceso para una CPU
+    long long tiempoFinal;          // Fin del ultimo proceso (o el horizonte)
+    double esperaMedia;
+    double retornoMedio;
+    double respuestaMedia;
+    long long esperaMaxima;
+    long long respuestaMaxima;
+    double rendimiento;             // Procesos terminados por segundo simulado
+    double ocupacionCPU;
+    double segundos;                // Tiempo real de la simulacion
+};
+
+const double MEDIA_RAFAGA_US = 1000;
+const double MEDIA_ES_US = 5000;
+const int MAX_RAFAGAS_SIMULADAS = 8;
+
+// Mezcla de bits (finalizador de MurmurHash3): enteros seguidos dan
+// resultados independientes
+unsigned int mezclarBits(unsigned int x) {
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+// Duracion exponencial de media dada, al menos 1 us
+long long duracionExponencial(unsigned int azar, double media) {
+    double u = (azar + 1.0) / 4294967297.0;     // En (0, 1)
+    long long d = (long long)(-media * log(u));
+    return (d < 1) ? 1 : d;
+}
+
+long long duracionRafaga(const ProcesoSimulado& p, int rafaga) {
+    if (p.rafagaFija > 0) return p.rafagaFija;
+    return duracionExponencial(mezclarBits(p.semilla + 2u * rafaga), MEDIA_RAFAGA_US);
+}
+
+long long duracionES(const ProcesoSimulado& p, int rafaga) {
+    return duracionExponencial(mezclarBits(p.semilla + 2u * rafaga + 1u), MEDIA_ES_US);
+}
+
+// Carga sintetica de n procesos con llegadas de Poisson a un ritmo que
+// mantiene las CPUs ocupadas cerca de la fraccion carga
+void generarCargaSimulada(ProcesoSimulado* procesos, int n, int cpus, double carga, unsigned int semilla) {
+    double rafagasMedias = (1 + MAX_RAFAGAS_SIMULADAS) / 2.0;
+    double mediaEntreLlegadas = rafagasMedias * MEDIA_RAFAGA_US / (cpus * carga);
+    long long ahora = 0;
+    for (int i = 0; i < n; i++) {
+        unsigned int r = mezclarBits(semilla + 3u * i);
+        ahora += duracionExponencial(mezclarBits(semilla + 3u * i + 1u), mediaEntreLlegadas) - 1;
+        procesos[i].id = i + 1;
+        procesos[i].prioridad = 1 + (int)(r % 10);
+        procesos[i].rafagas = 1 + (int)((r >> 8) % MAX_RAFAGAS_SIMULADAS);
+        procesos[i].semilla = mezclarBits(semilla + 3u * i + 2u);
+        procesos[i].llegada = ahora;
+        procesos[i].rafagaFija = 0;
+    }
+}
+
+// Monticulo 4-ario de minimos por (tiempo, secuencia): los eventos del
+// mismo instante salen en el orden en que se programaron
+class ColaEventos {
+public:
+    enum TipoEvento { LLEGADA, FIN_RAFAGA, FIN_PORCION, FIN_ES };
+
+    struct Evento {
+        long long tiempo;
+        unsigned long long secuencia;
+        int tipo;
+        int proceso;                // Indice en la carga
+        unsigned int marca;         // Fin de porcion: vale si coincide con la del proceso
+    };
+
+private:
+    static const int D = 4;
+
+    Evento* datos;
+    int cantidad;
+    int capacidad;
+    unsigned long long contadorSecuencia;
+
+    static bool precede(const Evento& a, const Evento& b) {
+        return a.tiempo < b.tiempo || (a.tiempo == b.tiempo && a.secuencia < b.secuencia);
+    }
+
+public:
+    ColaEventos() {
+        capacidad = 64;
+        cantidad = 0;
+        datos = new Evento[capacidad];
+        contadorSecuencia = 0;
+    }
+
+    void programar(long long tiempo, int tipo, int proceso, unsigned int marca = 0) {
+        if (cantidad == capacidad) {
+            capacidad *= 2;
+            Evento* nuevos = new Evento[capacidad];
+            for (int i = 0; i < cantidad; i++) nuevos[i] = datos[i];
+            delete[] datos;
+            datos = nuevos;
+        }
+        Evento e;
+        e.tiempo = tiempo;
+        e.secuencia = contadorSecuencia++;
+        e.tipo = tipo;
+        e.proceso = proceso;
+        e.marca = marca;
+        int i = cantidad++;
+        while (i > 0) {
+            int padre = (i - 1) / D;
+            if (!precede(e, datos[padre])) break;
+            datos[i] = datos[padre];
+            i = padre;
+        }
+        datos[i] = e;
+    }
+
+    // Saca el proximo evento; false si no queda ninguno
+    bool extraer(Evento& salida) {
+        if (cantidad == 0) return false;
+        salida = datos[0];
+        Evento e = datos[--cantidad];
+        int i = 0;
+        while (true) {
+            int primerHijo = i * D + 1;
+            if (primerHijo >= cantidad) break;
+            int mejor = primerHijo;
+            int ultimoHijo = primerHijo + D;
+            if (ultimoHijo > cantidad) ultimoHijo = cantidad;
+            for (int h = primerHijo + 1; h < ultimoHijo; h++) {
+                if (precede(datos[h], datos[mejor])) mejor = h;
+            }
+            if (!precede(datos[mejor], e)) break;
+            datos[i] = datos[mejor];
+            i = mejor;
+        }
+        datos[i] = e;
+        return true;
+    }
+
+    // true si el proximo evento ocurre en el instante t
+    bool hayEventoEn(long long t) const {
+        return cantidad > 0 && datos[0].tiempo == t;
+    }
+
+    int tamanio() const {
+        return cantidad;
+    }
+
+    ~ColaEventos() {
+        delete[] datos;
+    }
+};
+
+template <class ColaListos>
+class SimuladorEventos {
+private:
+    int cpus;
+    long long quantum;
+
+    // Estado de una corrida
+    const ProcesoSimulado* procesos;
+    ResultadoSimulado* resultados;
+    ColaListos* listos;
+    ColaEventos* eventos;
+    int* rafagaActual;
+    long long* restante;                // De la rafaga en curso (0 = por empezar)
+    long long* porcion;                 // Porcion en CPU (0 = no esta en CPU)
+    long long* inicioPorcion;
+    unsigned int* marca;                // Invalida el fin de una porcion desalojada
+    int* cpuDe;
+    int* enCPU;                         // Proceso en cada CPU (-1 = libre)
+    int* libres;                        // Pila de CPUs libres
+    int cpusLibres;
+    long long ahora;
+    long long desalojos;
+    long long decisiones;
+
+    // Los procesos entran a la cola de listos con un handle cuya ranura
+    // es su indice en la carga
+    static HandleProceso handleDe(int indice) {
+        HandleProceso h;
+        h.indice = (unsigned int)indice;
+        h.generacion = 1;
+        return h;
+    }
+
+    long long rafagaPendiente(int p) const {
+        return (restante[p] > 0) ? restante[p] : duracionRafaga(procesos[p], rafagaActual[p]);
+    }
+
+    void aListos(int p) {
+        listos->preverRafaga(handleDe(p), rafagaPendiente(p));
+        listos->insertar(handleDe(p), procesos[p].id, procesos[p].prioridad);
+    }
+
+    // Saca a p de su CPU habiendo usado 'usado' de su porcion
+    void dejarCPU(int p, long long usado) {
+        resultados[p].cpu += usado;
+        restante[p] -= usado;
+        listos->cargarTiempo(handleDe(p), procesos[p].prioridad, usado);
+        porcion[p] = 0;
+        marca[p]++;
+        enCPU[cpuDe[p]] = -1;
+        libres[cpusLibres++] = cpuDe[p];
+    }
+
+    // Con todas las CPUs ocupadas, la politica decide si p (recien listo)
+    // desaloja al que le falta mas
+    void desalojarPorLlegada(int p) {
+        if (!ColaListos::DESALOJA_AL_LLEGAR || cpusLibres > 0) return;
+        int victima = -1;
+        long long mayor = -1;
+        for (int c = 0; c < cpus; c++) {
+            int q = enCPU[c];
+            long long falta = restante[q] - (ahora - inicioPorcion[q]);
+            if (falta > mayor) {
+                mayor = falta;
+                victima = q;
+            }
+        }
+        if (victima < 0 || !listos->desaloja(procesos[p].prioridad, rafagaPendiente(p),
+                                             procesos[victima].prioridad, mayor)) return;
+        dejarCPU(victima, ahora - inicioPorcion[victima]);
+        desalojos++;
+        aListos(victima);
+    }
+
+    // Cada CPU libre toma el primero de la cola de listos por la porcion
+    // que decida la politica
+    void despachar() {
+        typename ColaListos::Entrada elegido;
+        while (cpusLibres > 0 && listos->extraer(elegido)) {
+            int q = (int)elegido.proceso.indice;
+            decisiones++;
+            if (resultados[q].primeraCPU < 0) resultados[q].primeraCPU = ahora;
+            if (restante[q] == 0) restante[q] = duracionRafaga(procesos[q], rafagaActual[q]);
+            porcion[q] = listos->porcionDeCPU(procesos[q].prioridad, restante[q]);
+            inicioPorcion[q] = ahora;
+            cpuDe[q] = libres[--cpusLibres];
+            enCPU[cpuDe[q]] = q;
+            eventos->programar(ahora + porcion[q],
+                               (porcion[q] < restante[q]) ? ColaEventos::FIN_PORCION : ColaEventos::FIN_RAFAGA,
+                               q, marca[q]);
+        }
+    }
+
+public:
+    SimuladorEventos(int _cpus = 1, long long _quantum = QUANTUM_SIMULADO_US) {
+        cpus = (_cpus < 1) ? 1 : _cpus;
+        quantum = (_quantum < 1) ? 1 : _quantum;
+    }
+
+    // Simula la carga (ordenada por llegada) hasta que terminan todos o
+    // hasta el horizonte (si es positivo). Solo la proxima llegada esta
+    // programada a la vez: la cola de eventos guarda a lo sumo una
+    // llegada, una porcion por CPU y las E/S en curso.
+    EstadisticasSimulacion simular(const ProcesoSimulado* _procesos, int n, ResultadoSimulado* _resultados,
+                                   long long horizonte = 0) {
+        chrono::steady_clock::time_point inicioReal = chrono::steady_clock::now();
+        procesos = _procesos;
+        resultados = _resultados;
+        ColaListos colaListos;          // Viven lo que dura la corrida
+        ColaEventos colaEventos;
+        listos = &colaListos;
+        eventos = &colaEventos;
+        listos->fijarQuantum(quantum);
+        rafagaActual = new int[n + 1];
+        restante = new long long[n + 1];
+        porcion = new long long[n + 1];
+        inicioPorcion = new long long[n + 1];
+        marca = new unsigned int[n + 1];
+        cpuDe = new int[n + 1];
+        enCPU = new int[cpus];
+        libres = new int[cpus];
+        for (int i = 0; i < n; i++) {
+            rafagaActual[i] = 0;
+            restante[i] = 0;
+            porcion[i] = 0;
+            marca[i] = 0;
+            resultados[i].primeraCPU = -1;
+            resultados[i].fin = -1;
+            resultados[i].cpu = 0;
+            resultados[i].es = 0;
+        }
+        for (int c = 0; c < cpus; c++) {
+            enCPU[c] = -1;
+            libres[c] = cpus - 1 - c;
+        }
+        cpusLibres = cpus;
+        ahora = 0;
+        desalojos = 0;
+        decisiones = 0;
+
+        long long procesados = 0;
+        if (n > 0) eventos->programar(procesos[0].llegada, ColaEventos::LLEGADA, 0);
+        ColaEventos::Evento e;
+        while (eventos->extraer(e)) {
+            int p = e.proceso;
+            bool finDePorcion = (e.tipo == ColaEventos::FIN_RAFAGA || e.tipo == ColaEventos::FIN_PORCION);
+            if (finDePorcion && e.marca != marca[p]) {
+                // Porcion desalojada antes de terminar
+                if (!eventos->hayEventoEn(ahora)) despachar();
+                continue;
+            }
+            if (horizonte > 0 && e.tiempo > horizonte) {
+                // Las porciones en curso cuentan hasta el horizonte
+                do {
+                    bool vigente = (e.tipo == ColaEventos::FIN_RAFAGA || e.tipo == ColaEventos::FIN_PORCION)
+                                   && e.marca == marca[e.proceso];
+                    if (vigente) resultados[e.proceso].cpu += porcion[e.proceso] - (e.tiempo - horizonte);
+                } while (eventos->extraer(e));
+                ahora = horizonte;
+                break;
+            }
+            ahora = e.tiempo;
+            procesados++;
+            switch (e.tipo) {
+                case ColaEventos::LLEGADA:
+                    aListos(p);
+                    desalojarPorLlegada(p);
+                    if (p + 1 < n) eventos->programar(procesos[p + 1].llegada, ColaEventos::LLEGADA, p + 1);
+                    break;
+                case ColaEventos::FIN_PORCION:
+                    desalojos++;
+                    dejarCPU(p, porcion[p]);
+                    aListos(p);
+                    break;
+                case ColaEventos::FIN_RAFAGA: {
+                    dejarCPU(p, porcion[p]);
+                    int k = rafagaActual[p]++;
+                    if (k + 1 == procesos[p].rafagas) {
+                        resultados[p].fin = ahora;
+                    } else {
+                        long long espera = duracionES(procesos[p], k);
+                        resultados[p].es += espera;
+                        eventos->programar(ahora + espera, ColaEventos::FIN_ES, p);
+                    }
+                    break;
+                }
+                case ColaEventos::FIN_ES:
+                    aListos(p);
+                    desalojarPorLlegada(p);
+                    break;
+            }
+
+            // Se despacha despues de todos los eventos del mismo instante
+            // (las llegadas simultaneas compiten)
+            if (!eventos->hayEventoEn(ahora)) despachar();
+        }
+        delete[] libres;
+        delete[] enCPU;
+        delete[] cpuDe;
+        delete[] marca;
+        delete[] inicioPorcion;
+        delete[] porcion;
+        delete[] restante;
+        delete[] rafagaActual;
+
+        EstadisticasSimulacion s;
+        memset(&s, 0, sizeof(s));
+        s.procesos = n;
+        s.cpus = cpus;
+        s.eventos = procesados;
+        s.desalojos = desalojos;
+        s.decisiones = decisiones;
+        s.tiempoFinal = ahora;
+        long long cpuTotal = 0;
+        for (int i = 0; i < n; i++) {
+            const ResultadoSimulado& r = resultados[i];
+            cpuTotal += r.cpu;
+            if (r.fin < 0) continue;
+            s.terminados++;
+            long long retorno = r.fin - procesos[i].llegada;
+            long long espera = retorno - r.cpu - r.es;
+            long long respuesta = r.primeraCPU - procesos[i].llegada;
+            s.retornoMedio += retorno;
+            s.esperaMedia += espera;
+            s.respuestaMedia += respuesta;
+            if (espera > s.esperaMaxima) s.esperaMaxima = espera;
+            if (respuesta > s.respuestaMaxima) s.respuestaMaxima = respuesta;
+        }
+        if (s.terminados > 0) {
+            s.retornoMedio /= s.terminados;
+            s.esperaMedia /= s.terminados;
+            s.respuestaMedia /= s.terminados;
+        }
+        if (ahora > 0) {
+            s.rendimiento = s.terminados * 1e6 / ahora;
+            s.ocupacionCPU = (double)cpuTotal / ((double)ahora * cpus);
+        }
+        s.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicioReal).count();
+        return s;
+    }
+};
+
+// Tabla por proceso (las primeras filas) y metricas agregadas
+void mostrarSimulacion(const ProcesoSimulado* procesos, const ResultadoSimulado* resultados,
+                       const EstadisticasSimulacion& s, int maxFilas) {
+    char linea[200];
+    int filas = (s.procesos < maxFilas) ? s.procesos : maxFilas;
+    if (filas > 0) {
+        cout << "\nID        Prio  Llegada     Rafagas  CPU        E/S        Espera     Retorno    Respuesta\n";
+        cout << "=========================================================================================\n";
+        for (int i = 0; i < filas; i++) {
+            const ResultadoSimulado& r = resultados[i];
+            long long retorno = r.fin - procesos[i].llegada;
+            char espera[24], textoRetorno[24], respuesta[24];
+            strcpy(espera, "-");            // Sin terminar (o sin ejecutar) al llegar al horizonte
+            strcpy(textoRetorno, "-");
+            strcpy(respuesta, "-");
+            if (r.fin >= 0) {
+                sprintf(espera, "%lld", retorno - r.cpu - r.es);
+                sprintf(textoRetorno, "%lld", retorno);
+            }
+            if (r.primeraCPU >= 0) sprintf(respuesta, "%lld", r.primeraCPU - procesos[i].llegada);
+            sprintf(linea, "%-9d %-5d %-11lld %-8d %-10lld %-10lld %-10s %-10s %s\n", procesos[i].id,
+                    procesos[i].prioridad, procesos[i].llegada, procesos[i].rafagas, r.cpu, r.es,
+                    espera, textoRetorno, respuesta);
+            cout << linea;
+        }
+        if (filas < s.procesos) cout << "... (" << (s.procesos - filas) << " procesos mas)\n";
+        cout << "=========================================================================================\n";
+    }
+    sprintf(linea, "Procesos: %d (terminados: %d) | CPUs: %d | Eventos: %lld | Desalojos: %lld | Decisiones: %lld\n",
+            s.procesos, s.terminados, s.cpus, s.eventos, s.desalojos, s.decisiones);
+    cout << linea;
+    sprintf(linea, "Tiempo simulado: %.3f s | Ocupacion CPU: %.1f%%\n", s.tiempoFinal / 1e6, 100.0 * s.ocupacionCPU);
+    cout << linea;
+    sprintf(linea, "Espera media: %.0f us (max %lld) | Retorno medio: %.0f us | Respuesta media: %.0f us (max %lld)\n",
+            s.esperaMedia, s.esperaMaxima, s.retornoMedio, s.respuestaMedia, s.respuestaMaxima);
+    cout << linea;
+    sprintf(linea, "Rendimiento: %.1f procesos/s simulado | Simulacion: %.3f s reales (%.2f M eventos/s)\n",
+            s.rendimiento, s.segundos, (s.segundos > 0) ? s.eventos / s.segundos / 1e6 : 0.0);
+    cout << linea;
+}
+
+// Equidad: un proceso limitado por CPU por cada prioridad (1 a 10),
+// todos listos desde el instante 0 en una CPU hasta el horizonte. La
+// parte justa de cada uno es su peso sobre la suma de los pesos. La
+// desviacion es la diferencia relativa entre la CPU recibida y esa parte
+// (0 = justo); el indice de Jain de recibida / justa va de 1 (justo) a
+// 1/10 (un solo proceso se queda con toda la CPU).
+struct EquidadSimulacion {
+    double parte[10];               // Fraccion de la CPU recibida (por prioridad)
+    double justa[10];
+    double desviacionMedia;
+    double desviacionMaxima;
+    double indiceJain;
+};
+
+template <class ColaListos>
+EquidadSimulacion medirEquidad(long long horizonteUs, long long quantumUs = QUANTUM_SIMULADO_US) {
+    const int procesos = 10;
+    ProcesoSimulado carga[procesos];
+    ResultadoSimulado resultados[procesos];
+    long long pesoTotal = 0;
+    for (int i = 0; i < procesos; i++) {
+        carga[i].id = i + 1;
+        carga[i].prioridad = i + 1;
+        carga[i].rafagas = 1;
+        carga[i].semilla = 0;
+        carga[i].llegada = 0;
+        carga[i].rafagaFija = 2 * horizonteUs;     // No termina antes del horizonte
+        pesoTotal += pesoDePrioridad(i + 1);
+    }
+    SimuladorEventos<ColaListos> simulador(1, quantumUs);
+    simulador.simular(carga, procesos, resultados, horizonteUs);
+
+    EquidadSimulacion q;
+    double suma = 0, sumaCuadrados = 0;
+    q.desviacionMedia = 0;
+    q.desviacionMaxima = 0;
+    for (int i = 0; i < procesos; i++) {
+        q.parte[i] = (double)resultados[i].cpu / horizonteUs;
+        q.justa[i] = (double)pesoDePrioridad(i + 1) / pesoTotal;
+        double relativa = q.parte[i] / q.justa[i];
+        double desviacion = fabs(relativa - 1);
+        q.desviacionMedia += desviacion / procesos;
+        if (desviacion > q.desviacionMaxima) q.desviacionMaxima = desviacion;
+        suma += relativa;
+        sumaCuadrados += relativa * relativa;
+    }
+    q.indiceJain = (sumaCuadrados > 0) ? suma * suma / (procesos * sumaCuadrados) : 0;
+    return q;
+}
+
+void mostrarEquidad(const EquidadSimulacion& q) {
+    char linea[160];
+    sprintf(linea, "Equidad (10 procesos de CPU, uno por prioridad): desviacion media %.1f%% | maxima %.1f%% | Jain %.3f\n",
+            100.0 * q.desviacionMedia, 100.0 * q.desviacionMaxima, q.indiceJain);
+    cout << linea;
+}
+
+// ============================================
+// PLANIFICADOR DE CPU
+// ColaListos define la estructura de la cola de listos (la politica):
+// ColaEnvejecimiento (por defecto), MonticuloIndexado<4>, ColaNiveles,
+// ColaCFS o las politicas clasicas
+// ============================================
+template <class ColaListos>
+class PlanificadorCPUGenerico : public ObservadorProcesos {
+private:
+	// Estructura que representa un proceso 
+    struct Nodo {
+        HandleProceso proceso;	// Handle del proceso (detecta si fue eliminado)
+        int id;					// ID del proceso al momento de encolar
+        int prioridad;			// Prioridad con la que se ordeno en la cola
+		Nodo* siguiente;	// Puntero al siguiente nodo en la cola		
+	// Constructor del nodo
+        Nodo(HandleProceso h, int _id, int _prioridad) {
+            proceso = h;
+            id = _id;
+            prioridad = _prioridad;
+            siguiente = NULL;
+        }
+    };
+
+    GestorProcesos& gestor;	// Tabla de procesos compartida (resuelve handles)
+    ColaListos cola;		// Cola de listos ordenada por prioridad
+	Nodo*ejecutados = NULL; // Lista de procesos que ya fueron ejecutados
+    PoolNodos<Nodo> poolNodos;	// Arena para los nodos del historial
+    ResidenciaProcesos* residencia;	// Memoria a consultar antes de ejecutar (o NULL)
+    static const int MAX_EN_ESPERA = 64;	// Procesos apartados por ejecucion
+    static const long long QUANTUM_NUCLEO_NS = 100000;	// Quantum del modo multinucleo (menu)
+    static const int LOTE_ENVIOS = 256;	// Envios que pasan a la cola por vez
+    ColaEnvios envios;		// Procesos enviados desde otros hilos
+ 
+    		
+
+public:
+	// Constructor del planificador
+    PlanificadorCPUGenerico(GestorProcesos& _gestor) : gestor(_gestor) {
+        ejecutados = NULL;		// Inicializa la lista de ejecutados vac�a
+        residencia = NULL;
+        gestor.registrarObservador(this);	// Recibir cambios de prioridad
+        cout << "[INFO] Planificador de CPU inicializado correctamente (cola: "
+             << ColaListos::nombre() << ")\n";
+    }
+
+    // Con residencia, solo se ejecutan procesos con la memoria cargada
+    void fijarResidencia(ResidenciaProcesos* r) {
+        residencia = r;
+    }
+
+    // Reserva los nodos de envio de todas las ranuras de la tabla de
+    // procesos (y de las primeras 'ranuras', si son mas) antes de lanzar
+    // a los productores. Es opcional: cada drenaje reserva las ranuras
+    // nuevas y enviar() crea lo que falte.
+    void habilitarEnvios(unsigned int ranuras = 0) {
+        unsigned int enTabla = gestor.totalRanuras();
+        envios.reservar(ranuras > enTabla ? ranuras : enTabla);
+    }
+
+    // Desde cualquier hilo: deja el proceso para que el hilo del
+    // planificador lo encole en el proximo drenaje. No toca el gestor.
+    ColaEnvios::ResultadoEnvio enviar(HandleProceso h) {
+        return envios.enviar(h);
+    }
+
+    // Pasa los envios pendientes a la cola de listos, de a lotes. Lo
+    // llama el hilo del planificador antes de elegir o mostrar; retorna
+    // cuantos procesos quedaron encolados (los eliminados o que no
+    // pueden pasar a "listo" se descartan).
+    int drenarEnvios() {
+        HandleProceso lote[LOTE_ENVIOS];
+        int encolados = 0;
+        int n;
+        envios.reservar(gestor.totalRanuras());     // Procesos creados desde el ultimo drenaje
+        while ((n = envios.drenar(lote, LOTE_ENVIOS)) > 0) {
+            for (int i = 0; i < n; i++) {
+                if (agregarACola(lote[i])) encolados++;
+            }
+        }
+        return encolados;
+    }
+
+    const ColaEnvios& colaEnvios() const {
+        return envios;
+    }
+
+    // Reubica en la cola un proceso cuya prioridad cambio (O(log n))
+    void prioridadCambiada(HandleProceso h, int nuevaPrioridad) {
+        cola.actualizarPrioridad(h, nuevaPrioridad);
+    }
+
+    // Inserta un proceso en la cola seg�n su prioridad y lo deja "listo"
+    void encolar(HandleProceso h) {
+    Proceso proc = gestor.resolver(h);
+    if (!proc.existe()) {
+        cout << "El proceso ya no existe." << endl;
+        return;
+    }
+    if (!gestor.puedePasarA(h, ESTADO_LISTO)) {
+        cout << "Un proceso en estado '" << proc.estado()
+             << "' no puede volver a la cola." << endl;
+        return;
+    }
+
+    // Insertar en el monticulo: O(log n), FIFO entre prioridades iguales
+    cola.preverRafaga(h, rafagaPrevistaUs(proc.id()));
+    if (!cola.insertar(h, proc.id(), proc.prioridad())) {
+        cout << "El proceso ya esta en la cola." << endl;
+        return;
+    }
+    gestor.fijarEstado(h, ESTADO_LISTO);
+
+    cout << "Proceso '" << proc.nombre() << "' agregado a la cola (Prioridad: "
+         << proc.prioridad() << ")" << endl;
+}
+
+    // Encola sin mensajes y deja el proceso "listo"; false si no existe,
+    // ya estaba o su estado no permite pasar a "listo" (p. ej. terminado)
+    bool agregarACola(HandleProceso h) {
+        Proceso proc = gestor.resolver(h);
+        if (!proc.existe() || !gestor.puedePasarA(h, ESTADO_LISTO)) return false;
+        cola.preverRafaga(h, rafagaPrevistaUs(proc.id()));
+        if (!cola.insertar(h, proc.id(), proc.prioridad())) return false;
+        gestor.fijarEstado(h, ESTADO_LISTO);
+        return true;
+    }
+
+    // Ejecuta el siguiente proceso sin mensajes. Retorna el proceso ejecutado
+    // (vista temporal) o uno que no existe() si la cola quedo vacia. Los procesos
+    // que fueron eliminados del gestor o que dejaron de estar "listos" (p. ej.
+    // bloqueados desde el menu) se descartan y se cuentan en descartados.
+    // Los que esperan que su memoria vuelva del area de intercambio se
+    // saltean sin bloquear, vuelven a la cola con su turno original (sin
+    // perder la espera acumulada) y se cuentan en enEspera.
+    Proceso ejecutarSiguiente(int* descartados = NULL, int* enEspera = NULL) {
+        drenarEnvios();
+        EntradaCola siguiente;
+        EntradaCola apartados[MAX_EN_ESPERA];
+        int cantidadApartados = 0;
+        Proceso elegido;
+        while (cantidadApartados < MAX_EN_ESPERA && cola.extraer(siguiente)) {	// Tomar el de mayor prioridad
+            // Si el proceso fue eliminado del gestor, su handle quedo obsoleto
+            Proceso proc = gestor.resolver(siguiente.proceso);
+            if (!proc.existe() || proc.codigoEstado() != ESTADO_LISTO) {
+                if (descartados != NULL) (*descartados)++;
+                continue;
+            }
+            if (residencia != NULL && !residencia->prepararEjecucion(siguiente.proceso)) {
+                apartados[cantidadApartados++] = siguiente;
+                continue;
+            }
+
+            // Cambia el estado del proceso (pasa por "ejecutando" hasta terminar)
+            gestor.fijarEstado(siguiente.proceso, ESTADO_EJECUTANDO);
+            gestor.fijarEstado(siguiente.proceso, ESTADO_TERMINADO);
+
+            // Guardar en historial de ejecutados SIN eliminar
+            Nodo* temp = new (poolNodos.reservar()) Nodo(siguiente.proceso, siguiente.id, siguiente.prioridad);
+            temp->siguiente = ejecutados;
+            ejecutados = temp;
+            elegido = proc;
+            break;
+        }
+        for (int i = cantidadApartados - 1; i >= 0; i--) {    // Al reves: CFS los pone delante de sus iguales
+            cola.preverRafaga(apartados[i].proceso, rafagaPrevistaUs(apartados[i].id));
+            cola.reinsertar(apartados[i]);
+        }
+        if (enEspera != NULL) *enEspera = cantidadApartados;
+        if (residencia != NULL) residencia->finDeTick();
+        return elegido;
+    }
+
+    // Quanta de trabajo de un proceso: de 1 a 16 segun su ID (reproducible)
+    static int rafagaDe(int id) {
+        return 1 + (int)(((unsigned int)id * 2654435761u) >> 16) % 16;
+    }
+
+    // La misma rafaga en microsegundos: la que usan SJF y SRTF para ordenar
+    static long long rafagaPrevistaUs(int id) {
+        return rafagaDe(id) * (QUANTUM_NUCLEO_NS / 1000);
+    }
+
+    // Vacia la cola de listos ejecutando en varios nucleos. La tabla de
+    // procesos no se comparte entre hilos: los procesos pasan a
+    // "ejecutando" antes de lanzar los nucleos y a "terminado" despues,
+    // en el orden en que terminaron. Los que esperan su memoria quedan
+    // en la cola. Retorna cuantos procesos se ejecutaron.
+    int ejecutarEnNucleos(PlanificadorMultinucleo& multinucleo, int* descartados = NULL, int* enEspera = NULL) {
+        drenarEnvios();
+        int capacidad = cola.tamanio();
+        TareaNucleo* tareas = new TareaNucleo[capacidad + 1];
+        EntradaCola* apartados = new EntradaCola[capacidad + 1];
+        int cantidad = 0, cantidadApartados = 0;
+        EntradaCola siguiente;
+        while (cola.extraer(siguiente)) {      // Sale en orden de prioridad
+            Proceso proc = gestor.resolver(siguiente.proceso);
+            if (!proc.existe() || proc.codigoEstado() != ESTADO_LISTO) {
+                if (descartados != NULL) (*descartados)++;
+                continue;
+            }
+            if (residencia != NULL && !residencia->prepararEjecucion(siguiente.proceso)) {
+                apartados[cantidadApartados++] = siguiente;
+                continue;
+            }
+            gestor.fijarEstado(siguiente.proceso, ESTADO_EJECUTANDO);
+            TareaNucleo& t = tareas[cantidad++];
+            t.proceso = siguiente.proceso;
+            t.id = siguiente.id;
+            t.prioridad = siguiente.prioridad;
+            t.quantaRestantes = rafagaDe(siguiente.id);
+        }
+        for (int i = cantidadApartados - 1; i >= 0; i--) {    // Al reves: CFS los pone delante de sus iguales
+            cola.preverRafaga(apartados[i].proceso, rafagaPrevistaUs(apartados[i].id));
+            cola.reinsertar(apartados[i]);
+        }
+        if (enEspera != NULL) *enEspera = cantidadApartados;
+
+        int* orden = new int[cantidad + 1];
+        if (cantidad > 0) multinucleo.ejecutar(tareas, cantidad, orden);
+        for (int i = 0; i < cantidad; i++) {
+            TareaNucleo& t = tareas[orden[i]];
+            gestor.fijarEstado(t.proceso, ESTADO_TERMINADO);
+            Nodo* temp = new (poolNodos.reservar()) Nodo(t.proceso, t.id, t.prioridad);
+            temp->siguiente = ejecutados;
+            ejecutados = temp;
+        }
+        delete[] orden;
+        delete[] apartados;
+        delete[] tareas;
+        if (residencia != NULL) residencia->finDeTick();
+        return cantidad;
+    }
+
+    // Simula la cola de listos con eventos discretos sin modificarla:
+    // todos llegan en el instante 0 y sus rafagas salen del ID.
+    // Retorna false si la cola esta vacia.
+    bool simularCola(int cpus) {
+        drenarEnvios();
+        int cantidad = cola.tamanio();
+        if (cantidad == 0) return false;
+        EntradaCola* orden = new EntradaCola[cantidad];
+        ProcesoSimulado* procesos = new ProcesoSimulado[cantidad];
+        ResultadoSimulado* resultados = new ResultadoSimulado[cantidad];
+        cola.copiarOrdenado(orden);
+        for (int i = 0; i < cantidad; i++) {
+            unsigned int r = mezclarBits((unsigned int)orden[i].id);
+            procesos[i].id = orden[i].id;
+            procesos[i].prioridad = orden[i].prioridad;
+            procesos[i].rafagas = 1 + (int)(r % MAX_RAFAGAS_SIMULADAS);
+            procesos[i].semilla = mezclarBits(r);
+            procesos[i].llegada = 0;
+            procesos[i].rafagaFija = 0;
+        }
+        SimuladorEventos<ColaListos> simulador(cpus);
+        EstadisticasSimulacion e = simulador.simular(procesos, cantidad, resultados);
+        mostrarSimulacion(procesos, resultados, e, 100);
+        delete[] resultados;
+        delete[] procesos;
+        delete[] orden;
+        return true;
+    }
+
+    // Desencola (ejecuta) el proceso con mayor prioridad
+    void ejecutarProceso() {
+    int descartados = 0, enEspera = 0;
+    Proceso proc = ejecutarSiguiente(&descartados, &enEspera);
+    if (descartados > 0) {
+        cout << "Se descartaron " << descartados << " proceso(s) eliminados o no listos de la cola." << endl;
+    }
+    if (!proc.existe() && enEspera > 0) {
+        cout << enEspera << " proceso(s) esperan que su memoria vuelva del area de intercambio."
+             << " Intente de nuevo en un momento." << endl;
+        return;
+    }
+    if (!proc.existe()) {
+        cout << "No hay procesos en la cola." << endl;
+        return;
+    }
+
+    cout << "Ejecutando proceso: " << proc.nombre() << endl;
+    cout << "Proceso '" << proc.nombre() << "' ha terminado." << endl;
+}
+    // Muestra los procesos que ya fueron ejecutados
+    void mostrarEjecutados() {
+    if (ejecutados == NULL) {
+        cout << "\n Aun no hay procesos ejecutados.\n";
+        return;
+    }
+
+    cout << "\n======= HISTORIAL DE PROCESOS EJECUTADOS ======\n";
+    cout << "ID    Nombre                  Prioridad\n";
+    cout << "===============================================\n";
+
+    Nodo* temp = ejecutados;
+    while (temp != NULL) {
+        Proceso proc = gestor.resolver(temp->proceso);	// No existe si ya fue eliminado
+        const char* nombre = proc.existe() ? proc.nombre() : "(eliminado)";
+        cout << temp->id;
+
+        // Ajuste de espacios seg�n tama�o del ID
+        if (temp->id < 10) cout << "     ";
+        else if (temp->id < 100) cout << "    ";
+        else cout << "   ";
+
+        // Imprimir nombre y ajustar espacios
+        cout << nombre;			// Mostrar nombre del proceso
+        int len = strlen(nombre);
+        for (int i = len; i < 24; i++) cout << " ";		// Ajustar espacios
+
+        // Imprimir prioridad
+        cout << (proc.existe() ? proc.prioridad() : temp->prioridad) << endl;
+
+        temp = temp->siguiente;
+    }
+
+    cout << "===============================================\n";
+}
+
+// Permite eliminar procesos ejecutados, individualmente o todos
+void eliminarProcesosEjecutados() {
+    int opcion;
+
+    do {
+        cout << "\n===== ELIMINAR PROCESOS EJECUTADOS =====\n";
+        cout << "1. Eliminar por ID\n";
+        cout << "2. Eliminar todos los procesos ejecutados\n";
+        cout << "3. Volver al menu del planificador\n";
+        cout << "Seleccione una opcion: ";
+        cin >> opcion;
+
+        // Validaci�n  de entrada
+        if (cin.fail()) {
+            cin.clear();                // Limpiar error de entrada
+            cin.ignore(1000, '\n');     
+            cout << "\nIngrese solo numeros validos.\n";
+        } else {
+            // Seleccionar acci�n seg�n opci�n ingresada
+            switch (opcion) {
+
+                case 1: { // Eliminar proceso por ID
+                    if (ejecutados == NULL) {
+                        // Si esta vac�a
+                        cout << "\nNo hay procesos ejecutados.\n";
+                    } else {
+                        int id;
+                        cout << "Ingrese el ID del proceso a eliminar: ";
+                        cin >> id;
+
+                        if (cin.fail()) {
+                            cin.clear();
+                            cin.ignore(1000, '\n');
+                            cout << "\nIngrese un ID valido (solo numeros).\n";
+                        } else {
+                            Nodo* temp = ejecutados;
+                            Nodo* anterior = NULL;
+                            bool encontrado = false;
+
+                            // Buscar nodo con ID especificado
+                            while (temp != NULL) {
+                                if (temp->id == id) {
+                                    encontrado = true;
+                                    // Si es el primer nodo de la lista
+                                    if (anterior == NULL)
+                                        ejecutados = temp->siguiente;
+                                    else
+                                        anterior->siguiente = temp->siguiente;
+
+                                    poolNodos.liberar(temp); // Devolver el nodo al pool
+                                    cout << "\nProceso con ID " << id << " eliminado del historial.\n";
+                                    break; 
+                                }
+                                anterior = temp;
+                                temp = temp->siguiente;
+                            }
+
+                            // Si no se encontr� el ID
+                            if (!encontrado)
+                                cout << "\nNo se encontro ningun proceso con ese ID.\n";
+                        }
+                    }
+                    break; 
+                }
+
+                case 2: { // Eliminar todos los procesos ejecutados
+                    if (ejecutados == NULL) {
+                        cout << "\nNo hay procesos ejecutados.\n";
+                    } else {
+                        // Liberar todos los nodos del pool de una vez
+                        poolNodos.liberarTodo();
+                        ejecutados = NULL; // Lista queda vac�a
+                        cout << "\nTodos los procesos ejecutados han sido eliminados.\n";
+                    }
+                    break; 
+                }
+
+                case 3: // Salir del men�
+                    cout << "\nRegresando al menu del planificador...\n";
+                    break;
+
+                default: // Opci�n inv�lida
+                    cout << "\nOpcion no valida.\n";
+                    break;
+            }
+        }
+
+// Repetir mientras la opci�n no sea 3
+    } while (opcion != 3);
+}
+
+    // Muestra la cola actual
+    void mostrarCola() {
+    drenarEnvios();
+    if (cola.estaVacia()) {
+        cout << "\n*** La cola de procesos esta vacia ***\n";
+        return;
+    }
+
+    cout << "\n=============== COLA DE PROCESOS ===============\n";
+    cout << "ID    Nombre                  Prioridad    Estado\n";
+    cout << "=================================================\n";
+
+    // El monticulo no esta ordenado: se copia en orden de salida
+    int cantidad = cola.tamanio();
+    EntradaCola* orden = new EntradaCola[cantidad];
+    cola.copiarOrdenado(orden);
+
+    for (int k = 0; k < cantidad; k++) {
+        EntradaCola* temp = &orden[k];
+        Proceso proc = gestor.resolver(temp->proceso);	// No existe si ya fue eliminado
+        const char* nombre = proc.existe() ? proc.nombre() : "(eliminado)";
+        cout << temp->id;
+
+        // Espacios seg�n tama�o del ID
+        if (temp->id < 10) cout << "     ";
+        else if (temp->id < 100) cout << "    ";
+        else cout << "   ";
+
+        cout << nombre;
+        int len = strlen(nombre);
+
+        // Ajuste de espacios para nombre
+        for (int i = len; i < 24; i++) cout << " ";
+
+        cout << temp->prioridad;
+        if (temp->prioridad < 10) cout << "           ";
+        else if (temp->prioridad < 100) cout << "          ";
+        else cout << "         ";
+
+        cout << (proc.existe() ? proc.estado() : "-") << endl;
+    }
+
+    delete[] orden;
+    cout << "=================================================\n";
+}
+    // Pide la cantidad de nucleos y ejecuta toda la cola con robo de trabajo
+    void ejecutarEnVariosNucleos() {
+        drenarEnvios();
+        if (cola.estaVacia()) {
+            cout << "No hay procesos en la cola." << endl;
+            return;
+        }
+        int nucleos;
+        cout << "Cantidad de nucleos (1-" << PlanificadorMultinucleo::MAX_NUCLEOS << ", el equipo tiene "
+             << thread::hardware_concurrency() << "): ";
+        cin >> nucleos;
+        if (cin.fail() || nucleos < 1 || nucleos > PlanificadorMultinucleo::MAX_NUCLEOS) {
+            cin.clear();
+            cin.ignore(1000, '\n');
+            cout << "Cantidad de nucleos invalida.\n";
+            return;
+        }
+        cin.ignore(1000, '\n');
+
+        PlanificadorMultinucleo multinucleo(nucleos, QUANTUM_NUCLEO_NS);
+        int descartados = 0, enEspera = 0;
+        int ejecutadosAhora = ejecutarEnNucleos(multinucleo, &descartados, &enEspera);
+        if (descartados > 0) {
+            cout << "Se descartaron " << descartados << " proceso(s) eliminados o no listos de la cola." << endl;
+        }
+        if (enEspera > 0) {
+            cout << enEspera << " proceso(s) esperan que su memoria vuelva del area de intercambio"
+                 << " y siguen en la cola." << endl;
+        }
+        if (ejecutadosAhora > 0) multinucleo.mostrarEstadisticas();
+    }
+
+    // Men� del planificador
+    void menuPlanificador() {
+        int opcion;
+        string nombre;
+        int prioridad;
+
+        do {
+            cout << "\n======= PLANIFICADOR DE CPU =======\n";
+            cout << "1. Encolar proceso\n";
+            cout << "2. Ejecutar proceso (desencolar)\n";
+            cout << "3. Mostrar cola actual\n";
+            cout << "4. Mostrar procesos ejecutados\n";
+            cout << "5. Eliminar procesos ejecutados\n";
+            cout << "6. Ejecutar la cola en varios nucleos\n";
+            cout << "7. Simular la cola (eventos discretos)\n";
+            cout << "8. Volver al menu principal\n";
+            cout << "===================================\n";
+            cout << "Opcion: ";
+            cin >> opcion;
+            cin.ignore();
+
+            switch (opcion) {
+               case 1: {		// Encolar proceso seleccionado por el usuario
+    			if (gestor.estaVacia()) {
+        		cout << "\nNo hay procesos creados en el Gestor de Procesos.\n";	// Verificar si hay procesos en el gestor
+        		break;
+    				}
+
+    			int idSeleccionado;		// ID del proceso que desea encolar
+    			Proceso p;		// Proceso seleccionado, inicialmente inexistente
+    			gestor.mostrar();  		// Mostrar todos los procesos disponibles
+
+   				bool idValido = false;	
+    			while (!idValido) {		// Bucle para asegurar que se ingrese un ID v�lido
+        			cout << "\nIngrese el ID del proceso que desea encolar: ";
+        			cin >> idSeleccionado;
+
+        		if (cin.fail()) {		// Si la entrada no es un n�mero
+            		cin.clear();
+            		cin.ignore(1000, '\n');
+            		cout << "Ingrese un numero valido (solo digitos).\n";
+        		}
+        		else if (idSeleccionado <= 0) {  // Si el n�mero no es positivo
+            		cout << "El ID debe ser un numero positivo.\n";
+        		}
+        		else {
+            		p = gestor.buscar(idSeleccionado);		// Buscar proceso por ID
+            		if (!p.existe()) {
+                		cin.ignore(1000, '\n');
+                		cout << "No existe ningun proceso con ese ID.\n";
+            	}
+            	else {  // Si se encontr� el proceso
+                	cin.ignore(1000, '\n'); 
+                	idValido = true;       // ID v�lido, salir del bucle 
+            }
+        }
+    }   			
+    			if (p.existe()) {
+        			// Consulta O(1) en el indice de posiciones del monticulo
+        			HandleProceso h = gestor.buscarHandle(p.id());
+        			bool yaEncolado = cola.contiene(h);
+
+        		if (yaEncolado) {  // Si ya estaba en la cola
+            		cout << "El proceso ya fue encolado anteriormente.\n";
+        		}  
+        		else {   		// Si no estaba en la cola
+            		encolar(h);	 // Encolar el proceso en la cola de CPU (queda "listo")
+        	}
+    	}
+
+    			break;
+			}
+                case 2:		// Ejecutar proceso (desencolar)
+                    ejecutarProceso();
+                    break;
+                case 3:		// Mostrar la cola actual
+                    mostrarCola();
+                    break;
+                case 4:		// Mostrar los procesos ejecutados
+                    mostrarEjecutados();
+                    break;
+                case 5:		// Eliminar procesos ejecutados
+                    eliminarProcesosEjecutados();
+                	break;
+                case 6:		// Ejecutar toda la cola con un hilo por nucleo
+                    ejecutarEnVariosNucleos();
+                    break;
+                case 7:		// Simular la cola con tiempos de CPU y E/S
+                    if (!simularCola(1)) cout << "No hay procesos en la cola." << endl;
+                    break;
+                case 8:		// Volver al men� principal
+                cout << "Volviendo al menu principal...\n";
+                	break;
+                default:
+                    cout << "Opcion invalida.\n";
+            }
+        } while (opcion != 8);
+    }
+
+    // El pool libera el historial completo de una vez
+    ~PlanificadorCPUGenerico() {
+        gestor.quitarObservador(this);
+    }
+};
+
+typedef PlanificadorCPUGenerico<ColaEnvejecimiento> PlanificadorCPU;
+typedef PlanificadorCPUGenerico<MonticuloIndexado<4> > PlanificadorCPUEstricto;
+typedef PlanificadorCPUGenerico<ColaNiveles> PlanificadorCPUNiveles;
+typedef PlanificadorCPUGenerico<ColaCFS> PlanificadorCPUCFS;
+
+// ============================================
+// MEN� DEL GESTOR DE PROCESOS
+// ============================================
+void menuGestorProcesos(GestorProcesos& gestor) {
+    int opcion, id, prioridad;
+    char nombre[50], estado[20];
+    bool entradaValida;
     
-    // ============================================
-    // MENÚ PRINCIPAL DEL GESTOR DE MEMORIA
-    // Interfaz de usuario para interactuar con el sistema
-    // ============================================
-    void menuMemoria(GestorProcesos& gestor) {
-        int opcion;
+    do {
+        cout << "\n======= GESTOR DE PROCESOS =======\n";
+        cout << "1. Agregar proceso\n";
+        cout << "2. Mostrar lista de procesos\n";
+        cout << "3. Buscar proceso por ID\n";
+        cout << "4. Modificar prioridad\n";
+        cout << "5. Eliminar proceso\n";
+        cout << "6. Cambiar estado\n";
+        cout << "7. Volver al menu principal\n";
+        cout << "==================================\n";
+        cout << "Opcion: ";
+        cin >> opcion;
         
-        do {
-            cout << "\n======= GESTOR DE MEMORIA =======\n";
-            cout << "1. Asignar memoria a proceso (PUSH)\n";
-            cout << "2. Liberar ultimo bloque (POP)\n";
-            cout << "3. Ver estado de la memoria\n";
-            cout << "4. Volver al menu principal\n";
-            cout << "=================================\n";
-            cout << "Opcion: ";
-            cin >> opcion;
-            
-            // Validar entrada del usuario
-            if (cin.fail()) {
-                cin.clear();
-                cin.ignore(1000, '\n');
-                cout << "Error: Ingrese un numero valido.\n";
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(1000, '\n');
+            cout << "Error: Ingrese un numero valido.\n";
+            continue;
+        }
+        cin.ignore();
+
+        switch(opcion) {
+            case 1: // AGREGAR
+                cout << "\n--- AGREGAR NUEVO PROCESO ---\n";
+                cout << "Nombre del proceso: ";
+                cin.getline(nombre, 50);
+                while (strlen(nombre) == 0) {
+                    cout << "Error: El nombre no puede estar vacio.\n";
+                    cout << "Por favor, ingrese el nombre del proceso: ";
+                    cin.getline(nombre, 50);
+                }
+                
+                entradaValida = false;
+                while (!entradaValida) {
+                    cout << "Prioridad (1-10): ";
+                    cin >> prioridad;
+                    if (cin.fail()) {
+                        cin.clear();
+                        cin.ignore(1000, '\n');
+                        cout << "Error: Debe ingresar un numero.\n";
+                        cout << "Por favor, inserte una prioridad valida (1-10): ";
+                    } else if (prioridad < 1 || prioridad > 10) {
+                        cin.ignore(1000, '\n');
+                        cout << "Error: La prioridad debe estar entre 1 y 10.\n";
+                        cout << "Por favor, inserte una prioridad valida: ";
+                    } else {
+                        entradaValida = true;
+                        cin.ignore(1000, '\n');
+                    }
+                }
+                gestor.insertar(nombre, prioridad);
+                break;
+
+            case 2: // MOSTRAR
+                gestor.mostrar();
+                break;
+
+            case 3: // BUSCAR
+                if (gestor.estaVacia()) {
+                    cout << "Error: No hay procesos en el sistema.\n";
+                    break;
+                }
+                entradaValida = false;
+                while (!entradaValida) {
+                    cout << "ID del proceso a buscar: ";
+                    cin >> id;
+                    if (cin.fail()) {
+                        cin.clear();
+                        cin.ignore(1000, '\n');
+                        cout << "Error: El ID debe ser un numero.\n";
+                    } else {
+                        entradaValida = true;
+                        cin.ignore(1000, '\n');
+                    }
+                }
+                {
+                    Proceso encontrado = gestor.buscar(id);
+                    if (encontrado.existe()) {
+                        gestor.mostrarFicha(encontrado);
+                    } else {
+                        cout << "\n>>> Proceso no encontrado <<<\n";
+                    }
+                }
+                break;
+
+            case 4: // MODIFICAR PRIORIDAD
+                if (gestor.estaVacia()) {
+                    cout << "Error: No hay procesos en el sistema.\n";
+                    break;
+                }
+                entradaValida = false;
+                while (!entradaValida) {
+                    cout << "ID del proceso: ";
+                    cin >> id;
+                    if (cin.fail()) {
+                        cin.clear();
+                        cin.ignore(1000, '\n');
+                        cout << "Error: El ID debe ser un numero.\n";
+                    } else {
+                        entradaValida = true;
+                        cin.ignore(1000, '\n');
+                    }
+                }
+                if (!gestor.buscar(id).existe()) {
+                    cout << "Error: No se encontro el proceso con ID " << id << endl;
+                    break;
+                }
+                entradaValida = false;
+                while (!entradaValida) {
+                    cout << "Nueva prioridad (1-10): ";
+                    cin >> prioridad;
+                    if (cin.fail()) {
+                        cin.clear();
+                        cin.ignore(1000, '\n');
+                        cout << "Error: Debe ingresar un numero.\n";
+                    } else if (prioridad < 1 || prioridad > 10) {
+                        cin.ignore(1000, '\n');
+                        cout << "Error: La prioridad debe estar entre 1 y 10.\n";
+                    } else {
+                        entradaValida = true;
+                        cin.ignore(1000, '\n');
+                    }
+                }
+                gestor.modificarPrioridad(id, prioridad);
+                break;
+
+            case 5: // ELIMINAR
+                if (gestor.estaVacia()) {
+                    cout << "Error: No hay procesos para eliminar.\n";
+                    break;
+                }
+                entradaValida = false;
+                while (!entradaValida) {
+                    cout << "ID del proceso a eliminar: ";
+                    cin >> id;
+                    if (cin.fail()) {
+                        cin.clear();
+                        cin.ignore(1000, '\n');
+                        cout << "Error: El ID debe ser un numero.\n";
+                    } else {
+                        entradaValida = true;
+                        cin.ignore(1000, '\n');
+                    }
+                }
+                gestor.eliminar(id);
+                break;
+
+            case 6: // CAMBIAR ESTADO
+                if (gestor.estaVacia()) {
+                    cout << "Error: No hay procesos en el sistema.\n";
+                    break;
+                }
+                entradaValida = false;
+                while (!entradaValida) {
+                    cout << "ID del proceso: ";
+                    cin >> id;
+                    if (cin.fail()) {
+                        cin.clear();
+                        cin.ignore(1000, '\n');
+                        cout << "Error: El ID debe ser un numero.\n";
+                    } else {
+                        entradaValida = true;
+                        cin.ignore(1000, '\n');
+                    }
+                }
+                if (!gestor.buscar(id).existe()) {
+                    cout << "Error: No se encontro el proceso.\n";
+                    break;
+                }
+                entradaValida = false;
+                while (!entradaValida) {
+                    cout << "Nuevo estado (nuevo/listo/ejecutando/bloqueado/terminado): ";
+                    cin.getline(estado, 20);
+                    convertirMinusculas(estado);
+                    
+                    if (strlen(estado) == 0) {
+                        cout << "Error: El estado no puede estar vacio.\n";
+                    } else if (!esEstadoValido(estado)) {
+                        cout << "Error: Estado invalido.\n";
+                        cout << "Estados validos: nuevo, listo, ejecutando, bloqueado, terminado\n";
+                    } else {
+                        entradaValida = true;
+                    }
+                }
+                gestor.cambiarEstado(id, estado);
+                break;
+
+            case 7:
+                cout << "Volviendo al menu principal...\n";
+                break;
+
+            default:
+                cout << "Opcion invalida.\n";
+        }
+    } while(opcion != 7);
+}
+
+// ============================================
+// MODO POR LOTES
+// Ejecuta un guion de comandos (uno por linea) sin menus ni
+// confirmaciones. Se usa con: ./programa --lotes [archivo]
+// (sin archivo, o con "-", lee de la entrada estandar)
+//
+// Comandos (en espanol o su alias en ingles):
+//   crear|create <nombre> <prioridad>     eliminar|delete <id>
+//   prioridad|priority <id> <prioridad>   estado|state <id> <estado>
+//   asignar|alloc <id> <tamanio>          liberar|free <id>
+//   pop                                   encolar|enqueue <id>
+//   ejecutar|run [veces]                  procesos|ps
+//   memoria|mem                           cola|queue
+//   historial|history                     intercambio|swap
+//   compactar|compact [incremental [tamanio por tick]]
+//   nucleos|cores <nucleos> [quantum en us]
+//   simular|simulate [cpus]
+// liberar quita todos los bloques del proceso; pop solo el del tope.
+// El tamanio admite sufijo B, KB, MB o GB (sin sufijo: MB).
+// compactar sin argumentos junta la memoria libre de una vez; con
+// incremental avanza en cada ejecucion (por defecto 4 MB por tick).
+// nucleos vacia la cola con un hilo por nucleo y robo de trabajo
+// (quantum de 100 us por defecto) y muestra las estadisticas.
+// simular recorre la cola con eventos discretos sin modificarla.
+// Con --intercambio, ejecutar espera la carga de la memoria del
+// proceso solo si no queda ningun otro proceso listo para ejecutar.
+// Las lineas vacias y las que empiezan con '#' se ignoran.
+// ============================================
+
+// Lee lineas de un archivo por bloques grandes (sin una llamada por caracter)
+class LectorLineas {
+private:
+    static const size_t TAMANIO_BUFFER = 1 << 20;
+
+    FILE* archivo;
+    char* buffer;
+    size_t inicio;      // Primer caracter sin consumir
+    size_t fin;         // Fin de los datos validos
+    bool finArchivo;
+
+    // Mueve lo pendiente al principio y completa el buffer desde el archivo
+    void recargar() {
+        if (inicio > 0) {
+            memmove(buffer, buffer + inicio, fin - inicio);
+            fin -= inicio;
+            inicio = 0;
+        }
+        size_t leidos = fread(buffer + fin, 1, TAMANIO_BUFFER - fin, archivo);
+        if (leidos == 0) finArchivo = true;
+        fin += leidos;
+    }
+
+public:
+    LectorLineas(FILE* _archivo) {
+        archivo = _archivo;
+        buffer = new char[TAMANIO_BUFFER + 1];
+        inicio = 0;
+        fin = 0;
+        finArchivo = false;
+    }
+
+    // Retorna la siguiente linea terminada en '\0' (sin '\n' ni '\r'),
+    // o NULL al final. La linea es valida hasta la siguiente llamada.
+    char* siguienteLinea() {
+        while (true) {
+            char* salto = (char*)memchr(buffer + inicio, '\n', fin - inicio);
+            if (salto == NULL && !finArchivo && (inicio > 0 || fin < TAMANIO_BUFFER)) {
+                recargar();
                 continue;
             }
-            cin.ignore();
-            
-            switch(opcion) {
-                case 1: { // ASIGNAR MEMORIA (PUSH)
-                    // Verificar si hay procesos disponibles
-                    if (gestor.estaVacia()) {
-                        cout << "\n[ERROR] No hay procesos creados en el Gestor de Procesos.\n";
-                        cout << "Debe crear procesos primero antes de asignar memoria.\n";
-                        break;
-                    }
-                    
-                    // Mostrar procesos disponibles
-                    gestor.mostrar();
-                    
-                    int idSeleccionado;
-                    int tamanioMB;
-                    bool entradaValida = false;
-                    
-                    // Solicitar ID del proceso con validación
-                    while (!entradaValida) {
-                        cout << "\nIngrese el ID del proceso: ";
-                        cin >> idSeleccionado;
-                        
-                        if (cin.fail()) {
-                            cin.clear();
-                            cin.ignore(1000, '\n');
-                            cout << "Error: Debe ingresar un numero valido.\n";
-                        } else if (idSeleccionado <= 0) {
-                            cin.ignore(1000, '\n');
-                            cout << "Error: El ID debe ser un numero positivo.\n";
-                        } else {
-                            // Buscar el proceso por ID
-                            Proceso* p = gestor.buscar(idSeleccionado);
-                            if (p == NULL) {
-                                cin.ignore(1000, '\n');
-                                cout << "Error: No existe ningun proceso con ese ID.\n";
-                            } else {
-                                entradaValida = true;
-                                cin.ignore(1000, '\n');
-                                
-                                // Solicitar tamaño de memoria con validación
-                                bool tamanioValido = false;
-                                while (!tamanioValido) {
-                                    cout << "Ingrese el tamanio de memoria en MB (1-1024): ";
-                                    cin >> tamanioMB;
-                                    
-                                    if (cin.fail()) {
-                                        cin.clear();
-                                        cin.ignore(1000, '\n');
-                                        cout << "Error: Debe ingresar un numero valido.\n";
-                                    } else if (tamanioMB < 1 || tamanioMB > 1024) {
-                                        cin.ignore(1000, '\n');
-                                        cout << "Error: El tamanio debe estar entre 1 y 1024 MB.\n";
-                                    } else {
-                                        tamanioValido = true;
-                                        cin.ignore(1000, '\n');
-                                        
-                                        // Asignar memoria al proceso
-                                        asignarMemoria(p->id, p->nombre, tamanioMB);
-                                    }
-                                }
-                            }
-                        }
-                    }
+            if (salto == NULL && inicio == fin) return NULL;
+
+            // Sin salto: ultima linea del archivo o linea mas larga que el buffer
+            char* linea = buffer + inicio;
+            size_t largo = (salto != NULL) ? (size_t)(salto - linea) : fin - inicio;
+            inicio += (salto != NULL) ? largo + 1 : largo;
+            if (largo > 0 && linea[largo - 1] == '\r') largo--;
+            linea[largo] = '\0';
+            return linea;
+        }
+    }
+
+    ~LectorLineas() {
+        delete[] buffer;
+    }
+};
+
+// Divide la linea en palabras (modifica la linea); retorna cuantas encontro
+int separarPalabras(char* linea, char** palabras, int maximo) {
+    int cantidad = 0;
+    char* c = linea;
+    while (*c != '\0' && cantidad < maximo) {
+        while (*c == ' ' || *c == '\t') c++;
+        if (*c == '\0') break;
+        palabras[cantidad++] = c;
+        while (*c != '\0' && *c != ' ' && *c != '\t') c++;
+        if (*c != '\0') *c++ = '\0';
+    }
+    return cantidad;
+}
+
+// Convierte texto a entero; retorna false si no es un numero valido
+bool leerEntero(const char* texto, int& valor) {
+    if (texto == NULL || *texto == '\0') return false;
+    bool negativo = (*texto == '-');
+    if (negativo) texto++;
+    long long acumulado = 0;
+    for (; *texto != '\0'; texto++) {
+        if (*texto < '0' || *texto > '9') return false;
+        acumulado = acumulado * 10 + (*texto - '0');
+        if (acumulado > 2147483647LL) return false;
+    }
+    valor = (int)(negativo ? -acumulado : acumulado);
+    return true;
+}
+
+// Interpreta el guion completo; retorna la cantidad de errores
+template <class Planificador>
+long long ejecutarLotes(FILE* archivo, GestorProcesos& gestor, const char* archivoIntercambio = NULL,
+                       unsigned long long capacidadMemoria = 2048 * BYTES_MB) {
+    GestorMemoria memoria(gestor, capacidadMemoria);
+    Planificador planificador(gestor);
+    LectorLineas lector(archivo);
+    planificador.fijarResidencia(&memoria);     // Residencia y ticks de la compactacion
+    if (archivoIntercambio != NULL && !memoria.habilitarIntercambio(archivoIntercambio)) {
+        cerr << "[LOTE] No se pudo crear el area de intercambio " << archivoIntercambio << endl;
+        return 1;
+    }
+
+    const long long MAX_ERRORES_MOSTRADOS = 20;
+    long long numeroLinea = 0, comandos = 0, errores = 0;
+    char* palabras[4];
+    char* linea;
+
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    while ((linea = lector.siguienteLinea()) != NULL) {
+        numeroLinea++;
+        int n = separarPalabras(linea, palabras, 4);
+        if (n == 0 || palabras[0][0] == '#') continue;
+        comandos++;
+
+        const char* cmd = palabras[0];
+        const char* error = NULL;
+        int a = 0, b = 0;
+        unsigned long long bytes = 0;
+
+        if (strcmp(cmd, "crear") == 0 || strcmp(cmd, "create") == 0) {
+            if (n < 3 || !leerEntero(palabras[2], b)) error = "uso: crear <nombre> <prioridad>";
+            else if (b < 1 || b > 10) error = "la prioridad debe estar entre 1 y 10";
+            else gestor.crear(palabras[1], b);
+        } else if (strcmp(cmd, "eliminar") == 0 || strcmp(cmd, "delete") == 0) {
+            if (n < 2 || !leerEntero(palabras[1], a)) error = "uso: eliminar <id>";
+            else if (!gestor.quitar(a)) error = "proceso inexistente";
+        } else if (strcmp(cmd, "prioridad") == 0 || strcmp(cmd, "priority") == 0) {
+            if (n < 3 || !leerEntero(palabras[1], a) || !leerEntero(palabras[2], b))
+                error = "uso: prioridad <id> <prioridad>";
+            else if (b < 1 || b > 10) error = "la prioridad debe estar entre 1 y 10";
+            else if (!gestor.cambiarPrioridad(a, b)) error = "proceso inexistente";
+        } else if (strcmp(cmd, "estado") == 0 || strcmp(cmd, "state") == 0) {
+            if (n < 3 || !leerEntero(palabras[1], a)) error = "uso: estado <id> <estado>";
+            else if (!esEstadoValido(palabras[2])) error = "estado invalido";
+            else if (!gestor.buscar(a).existe()) error = "proceso inexistente";
+            else if (!gestor.fijarEstado(a, palabras[2])) error = "transicion de estado no permitida";
+        } else if (strcmp(cmd, "asignar") == 0 || strcmp(cmd, "alloc") == 0) {
+            if (n < 3 || !leerEntero(palabras[1], a) || !leerTamanio(palabras[2], bytes, BYTES_MB))
+                error = "uso: asignar <id> <tamanio>[B|KB|MB|GB]";
+            else if (bytes < 1 || bytes > memoria.tamanioMaximo()) error = "tamanio fuera de rango";
+            else if (!memoria.reservar(gestor.buscarHandle(a), bytes))
+                error = "proceso inexistente o memoria insuficiente";
+        } else if (strcmp(cmd, "liberar") == 0 || strcmp(cmd, "free") == 0) {
+            if (n < 2 || !leerEntero(palabras[1], a)) error = "uso: liberar <id>";
+            else if (memoria.quitarTodosDe(a) < 0) error = "el proceso no tiene memoria asignada";
+        } else if (strcmp(cmd, "pop") == 0) {
+            if (memoria.quitarTope() < 0) error = "no hay bloques de memoria asignados";
+        } else if (strcmp(cmd, "encolar") == 0 || strcmp(cmd, "enqueue") == 0) {
+            if (n < 2 || !leerEntero(palabras[1], a)) error = "uso: encolar <id>";
+            else if (!planificador.agregarACola(gestor.buscarHandle(a)))
+                error = "proceso inexistente, ya encolado o terminado";
+        } else if (strcmp(cmd, "ejecutar") == 0 || strcmp(cmd, "run") == 0) {
+            int veces = 1;
+            if (n >= 2 && !leerEntero(palabras[1], veces)) error = "uso: ejecutar [veces]";
+            for (int i = 0; error == NULL && i < veces; i++) {
+                int enEspera = 0;
+                Proceso p = planificador.ejecutarSiguiente(NULL, &enEspera);
+                while (!p.existe() && enEspera > 0 && memoria.cantidadCargasPendientes() > 0) {
+                    memoria.esperarIntercambio();
+                    p = planificador.ejecutarSiguiente(NULL, &enEspera);
+                }
+                if (!p.existe()) {
+                    error = (enEspera > 0) ? "la memoria del proceso no entra aunque se desaloje el resto"
+                                           : "no hay procesos en la cola";
+                }
+            }
+        } else if (strcmp(cmd, "procesos") == 0 || strcmp(cmd, "ps") == 0) {
+            gestor.mostrar();
+        } else if (strcmp(cmd, "memoria") == 0 || strcmp(cmd, "mem") == 0) {
+            memoria.mostrarEstadoMemoria();
+        } else if (strcmp(cmd, "cola") == 0 || strcmp(cmd, "queue") == 0) {
+            planificador.mostrarCola();
+        } else if (strcmp(cmd, "historial") == 0 || strcmp(cmd, "history") == 0) {
+            planificador.mostrarEjecutados();
+        } else if (strcmp(cmd, "intercambio") == 0 || strcmp(cmd, "swap") == 0) {
+            memoria.mostrarIntercambio();
+        } else if (strcmp(cmd, "compactar") == 0 || strcmp(cmd, "compact") == 0) {
+            if (n == 1) {
+                memoria.compactar();
+            } else if (strcmp(palabras[1], "incremental") != 0) {
+                error = "uso: compactar [incremental [tamanio por tick]]";
+            } else {
+                bytes = 4 * BYTES_MB;
+                if (n >= 3 && (!leerTamanio(palabras[2], bytes, BYTES_MB) || bytes == 0)) {
+                    error = "uso: compactar [incremental [tamanio por tick]]";
+                } else {
+                    memoria.iniciarCompactacionIncremental(bytes);
+                }
+            }
+        } else if (strcmp(cmd, "nucleos") == 0 || strcmp(cmd, "cores") == 0) {
+            b = 100;
+            if (n < 2 || !leerEntero(palabras[1], a) || (n >= 3 && !leerEntero(palabras[2], b)))
+                error = "uso: nucleos <nucleos> [quantum en us]";
+            else if (a < 1 || a > PlanificadorMultinucleo::MAX_NUCLEOS) error = "cantidad de nucleos fuera de rango";
+            else if (b < 1) error = "el quantum debe ser positivo";
+            else {
+                PlanificadorMultinucleo multinucleo(a, 1000LL * b);
+                if (planificador.ejecutarEnNucleos(multinucleo) == 0) error = "no hay procesos listos en la cola";
+                else multinucleo.mostrarEstadisticas();
+            }
+        } else if (strcmp(cmd, "simular") == 0 || strcmp(cmd, "simulate") == 0) {
+            a = 1;
+            if (n >= 2 && !leerEntero(palabras[1], a)) error = "uso: simular [cpus]";
+            else if (a < 1 || a > 1024) error = "cantidad de CPUs fuera de rango";
+            else if (!planificador.simularCola(a)) error = "no hay procesos en la cola";
+        } else {
+            error = "comando desconocido";
+        }
+
+        if (error != NULL) {
+            errores++;
+            if (errores <= MAX_ERRORES_MOSTRADOS) {
+                cerr << "[LOTE] Linea " << numeroLinea << " (" << cmd << "): " << error << endl;
+            }
+        }
+    }
+    chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+
+    double segundos = chrono::duration<double>(fin - inicio).count();
+    if (errores > MAX_ERRORES_MOSTRADOS) {
+        cerr << "[LOTE] ... " << (errores - MAX_ERRORES_MOSTRADOS) << " errores mas no mostrados\n";
+    }
+    cout << "\n[LOTE] Comandos: " << comandos << " | Errores: " << errores
+         << " | Tiempo: " << segundos << " s";
+    if (segundos > 0) cout << " | " << (long long)(comandos / segundos) << " comandos/s";
+    cout << endl;
+    return errores;
+}
+
+// ============================================
+// PRUEBAS DE RENDIMIENTO
+// Se ejecutan con: ./programa --benchmark
+// ============================================
+
+// Generador pseudoaleatorio xorshift (rapido y reproducible)
+unsigned int siguienteAleatorio(unsigned int& semilla) {
+    semilla ^= semilla << 13;
+    semilla ^= semilla >> 17;
+    semilla ^= semilla << 5;
+    return semilla;
+}
+
+// Mide el costo de GestorProcesos::buscar a medida que crece la tabla
+void benchmarkBusquedaProcesos() {
+    const int tamanios[] = {1000, 10000, 100000, 1000000, 2000000, 4000000};
+    const int cantidadTamanios = sizeof(tamanios) / sizeof(tamanios[0]);
+    const int busquedas = 2000000;
+
+    cout << "\n========== BENCHMARK: GestorProcesos::buscar ==========\n";
+    cout << "Procesos      Busquedas     ns/busqueda\n";
+    cout << "=======================================================\n";
+
+    for (int t = 0; t < cantidadTamanios; t++) {
+        int n = tamanios[t];
+        GestorProcesos gestor;
+        for (int i = 0; i < n; i++) {
+            gestor.crear("proceso", (i % 10) + 1);
+        }
+
+        unsigned int semilla = 2463534242u;
+        long long encontrados = 0;
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        for (int i = 0; i < busquedas; i++) {
+            int id = (int)(siguienteAleatorio(semilla) % (unsigned int)n) + 1;
+            if (gestor.buscar(id).existe()) encontrados++;
+        }
+        chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+
+        double ns = chrono::duration<double, nano>(fin - inicio).count() / busquedas;
+        char buffer[100];
+        sprintf(buffer, "%-14d%-14d%.2f", n, busquedas, ns);
+        cout << buffer << endl;
+
+        if (encontrados != busquedas) {
+            cout << "[ERROR] Se perdieron procesos en el indice.\n";
+        }
+    }
+    cout << "=======================================================\n";
+}
+
+// Crea y elimina procesos al azar verificando que los handles viejos
+// se detecten como obsoletos (sin punteros colgantes)
+void benchmarkRotacionHandles() {
+    const int vivos = 100000;
+    const int operaciones = 2000000;
+
+    GestorProcesos gestor;
+    HandleProceso* handles = new HandleProceso[vivos];
+    int* ids = new int[vivos];
+    for (int i = 0; i < vivos; i++) {
+        handles[i] = gestor.crear("proceso", (i % 10) + 1);
+        ids[i] = gestor.resolver(handles[i]).id();
+    }
+
+    unsigned int semilla = 88172645u;
+    long long obsoletosDetectados = 0;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (int i = 0; i < operaciones; i++) {
+        int k = (int)(siguienteAleatorio(semilla) % (unsigned int)vivos);
+        HandleProceso viejo = handles[k];
+        gestor.quitar(ids[k]);
+        handles[k] = gestor.crear("proceso", (i % 10) + 1);
+        ids[k] = gestor.resolver(handles[k]).id();
+        // La ranura se reutiliza, pero el handle viejo debe ser rechazado
+        if (!gestor.resolver(viejo).existe()) obsoletosDetectados++;
+    }
+    chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+
+    double ns = chrono::duration<double, nano>(fin - inicio).count() / operaciones;
+    cout << "\n========== BENCHMARK: rotacion de handles ==========\n";
+    cout << "Procesos vivos:        " << vivos << endl;
+    cout << "Eliminar + crear:      " << operaciones << endl;
+    cout << "ns por par de ops:     " << ns << endl;
+    cout << "Handles obsoletos detectados: " << obsoletosDetectados
+         << " de " << operaciones << endl;
+    cout << "====================================================\n";
+
+    delete[] handles;
+    delete[] ids;
+}
+
+// Registro de proceso tal como se guardaba antes de la tabla columnar
+// (arreglo de estructuras de 80 bytes; referencia para comparar)
+struct ProcesoRegistro {
+    int id;
+    char nombre[50];
+    int prioridad;
+    char estado[20];
+};
+
+// Recorre millones de procesos contando por estado y sumando prioridades:
+// registros completos frente a las columnas de TablaProcesos
+void benchmarkRecorridoColumnar() {
+    const int n = 2000000;
+    const int pasadas = 10;
+    char nombre[50];
+    // Recorrido legal desde "nuevo": cada proceso avanza i % 4 pasos
+    const unsigned char camino[] = {ESTADO_LISTO, ESTADO_EJECUTANDO, ESTADO_TERMINADO};
+
+    ProcesoRegistro* registros = new ProcesoRegistro[n];
+    GestorProcesos gestor;
+    for (int i = 0; i < n; i++) {
+        sprintf(nombre, "proceso%d", i % 1000);
+        int pasos = i % 4;
+        HandleProceso h = gestor.crear(nombre, (i % 10) + 1);
+        for (int p = 0; p < pasos; p++) gestor.fijarEstado(h, camino[p]);
+        registros[i].id = i + 1;
+        strcpy(registros[i].nombre, nombre);
+        registros[i].prioridad = (i % 10) + 1;
+        strcpy(registros[i].estado, gestor.resolver(h).estado());
+    }
+
+    // Arreglo de registros: cada estado se compara como texto
+    long long sumaRegistros = 0;
+    unsigned int porEstadoRegistros[CANTIDAD_ESTADOS] = {0};
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (int p = 0; p < pasadas; p++) {
+        for (int i = 0; i < n; i++) {
+            for (int e = 0; e < CANTIDAD_ESTADOS; e++) {
+                if (strcmp(registros[i].estado, NOMBRES_ESTADO[e]) == 0) {
+                    porEstadoRegistros[e]++;
                     break;
                 }
-                
-                case 2: // LIBERAR MEMORIA (POP)
-                    liberarMemoria();
-                    break;
-                
-                case 3: // VER ESTADO DE LA MEMORIA
-                    mostrarEstadoMemoria();
-                    break;
-                
-                case 4: // VOLVER AL MENÚ PRINCIPAL
-                    cout << "Volviendo al menu principal...\n";
-                    break;
-                
-                default:
-                    cout << "Opcion invalida.\n";
             }
-        } while(opcion != 4);
+            sumaRegistros += registros[i].prioridad;
+        }
     }
-    
-    // ============================================
-    // DESTRUCTOR DEL GESTOR DE MEMORIA
-    // Libera toda la memoria asignada al destruir el objeto
-    // ============================================
-    ~GestorMemoria() {
-        BloqueMemoria* actual = tope;
-        while (actual != NULL) {
-            BloqueMemoria* temp = actual;
-            actual = actual->siguiente;
-            delete temp;  // Liberar cada bloque de memoria
+    chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+    double nsRegistros = chrono::duration<double, nano>(fin - inicio).count() / ((double)n * pasadas);
+
+    // Columnas: un byte por estado y un int por prioridad, contiguos
+    long long sumaColumnas = 0;
+    unsigned int porEstadoColumnas[CANTIDAD_ESTADOS] = {0};
+    inicio = chrono::steady_clock::now();
+    for (int p = 0; p < pasadas; p++) {
+        unsigned int parcial[CANTIDAD_ESTADOS];
+        gestor.contarPorEstado(parcial);
+        for (int e = 0; e < CANTIDAD_ESTADOS; e++) porEstadoColumnas[e] += parcial[e];
+        const int* prioridades = gestor.tablaProcesos().columnaPrioridades();
+        for (int i = 0; i < n; i++) sumaColumnas += prioridades[i];
+    }
+    fin = chrono::steady_clock::now();
+    double nsColumnas = chrono::duration<double, nano>(fin - inicio).count() / ((double)n * pasadas);
+
+    const TablaNombres& nombres = gestor.tablaProcesos().nombresInternados();
+    cout << "\n========== BENCHMARK: recorrido de la tabla de procesos ==========\n";
+    cout << "Procesos:                 " << n << " (x" << pasadas << " pasadas)\n";
+    cout << "Registros (80 B/proceso): " << nsRegistros << " ns/proceso\n";
+    cout << "Columnas (17 B/proceso):  " << nsColumnas << " ns/proceso\n";
+    cout << "Nombres internados:       " << nombres.cantidadNombres() << " distintos, "
+         << nombres.bytesUsados() << " bytes\n";
+    bool coinciden = (sumaRegistros == sumaColumnas);
+    for (int e = 0; e < CANTIDAD_ESTADOS; e++) {
+        // Los contadores de la maquina de estados deben coincidir con el recorrido
+        if (porEstadoRegistros[e] != porEstadoColumnas[e] ||
+            porEstadoColumnas[e] != gestor.cantidadEnEstado((unsigned char)e) * pasadas) {
+            coinciden = false;
         }
     }
-};
-class PlanificadorCPU {
+    if (!coinciden) cout << "[ERROR] Los recorridos no coinciden.\n";
+    cout << "==================================================================\n";
+
+    delete[] registros;
+}
+
+// Cola de prioridad con lista enlazada, tal como la implementaba
+// PlanificadorCPU::encolar antes del monticulo (referencia para comparar)
+class ColaListaPrioridad {
 private:
-	// Estructura que representa un proceso 
     struct Nodo {
-        Proceso* proceso;	// Puntero al proceso que contiene el nodo
-		Nodo* siguiente;	// Puntero al siguiente nodo en la cola		
-	// Constructor del nodo
-        Nodo(Proceso* p) {
-            proceso = p;
-            siguiente = NULL;
-        }
+        int prioridad;
+        Nodo* siguiente;
     };
-
-    Nodo* frente = NULL;   // Primer nodo de la cola de procesos     
-    Nodo* fin = NULL;   
-	Nodo*ejecutados = NULL; // Lista de procesos que ya fueron ejecutados
- 
-    		
+    Nodo* frente;
+    Nodo* fin;
 
 public:
-	// Constructor del planificador
-    PlanificadorCPU() {
-        frente = NULL; 			// Inicializa la cola vac�a
+    ColaListaPrioridad() {
+        frente = NULL;
         fin = NULL;
-        ejecutados = NULL;		// Inicializa la lista de ejecutados vac�a
-        cout << "[INFO] Planificador de CPU inicializado correctamente\n";
     }
 
-    // Inserta un proceso en la cola seg�n su prioridad
-    void encolar(Proceso* proc) {
-    Nodo* nuevo = new Nodo(proc);		// Crear nuevo nodo para el proceso
+    // Recorrido lineal hasta la posicion (>= conserva FIFO)
+    void encolar(int prioridad) {
+        Nodo* nuevo = new Nodo;
+        nuevo->prioridad = prioridad;
+        if (frente == NULL || prioridad > frente->prioridad) {
+            nuevo->siguiente = frente;
+            frente = nuevo;
+            if (fin == NULL) fin = nuevo;
+        } else {
+            Nodo* temp = frente;
+            while (temp->siguiente != NULL && temp->siguiente->prioridad >= prioridad) {
+                temp = temp->siguiente;
+            }
+            nuevo->siguiente = temp->siguiente;
+            temp->siguiente = nuevo;
+            if (nuevo->siguiente == NULL) fin = nuevo;
+        }
+    }
+
+    // Agrega al final sin recorrer (solo para llenar la cola ya ordenada)
+    void agregarAlFinal(int prioridad) {
+        Nodo* nuevo = new Nodo;
+        nuevo->prioridad = prioridad;
+        nuevo->siguiente = NULL;
+        if (fin == NULL) frente = nuevo;
+        else fin->siguiente = nuevo;
+        fin = nuevo;
+    }
 
-    // Si la cola est� vac�a o tiene mayor prioridad
-    if (frente == NULL || proc->prioridad > frente->proceso->prioridad) {
-        nuevo->siguiente = frente;		// Nuevo nodo apunta al frente actual
-        frente = nuevo;					// Nuevo nodo se convierte en el frente
-    } else {	
-    	// Buscar la posici�n correcta seg�n prioridad
+    int desencolar() {
         Nodo* temp = frente;
-        while (temp->siguiente != NULL && temp->siguiente->proceso->prioridad >= proc->prioridad) {
-            temp = temp->siguiente;
+        int prioridad = temp->prioridad;
+        frente = frente->siguiente;
+        if (frente == NULL) fin = NULL;
+        delete temp;
+        return prioridad;
+    }
+
+    ~ColaListaPrioridad() {
+        while (frente != NULL) {
+            Nodo* temp = frente;
+            frente = frente->siguiente;
+            delete temp;
         }
-        nuevo->siguiente = temp->siguiente;	// Insertar nodo en la posici�n
-        temp->siguiente = nuevo;
     }
+};
 
-    cout << "Proceso '" << proc->nombre << "' agregado a la cola (Prioridad: "
-         << proc->prioridad << ")" << endl;
+// Nanosegundos por decision de planificacion (desencolar + encolar) sobre
+// una cola de listos mantenida con n procesos. Cada insercion lleva una
+// rafaga prevista al azar (la usan SJF y SRTF).
+template <class Cola>
+double nsPorDecision(int n, int decisiones) {
+    Cola cola;
+    unsigned int semilla = 2463534242u;
+    for (int i = 0; i < n; i++) {
+        HandleProceso h = {(unsigned int)i, 1};
+        cola.preverRafaga(h, 1 + siguienteAleatorio(semilla) % 16000);
+        cola.insertar(h, i + 1, (int)(siguienteAleatorio(semilla) % 10) + 1);
+    }
+    typename Cola::Entrada e = {};
+    int hechas = 0;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (; hechas < decisiones; hechas++) {
+        if (!cola.extraer(e)) break;
+        cola.preverRafaga(e.proceso, 1 + siguienteAleatorio(semilla) % 16000);
+        cola.insertar(e.proceso, e.id, (int)(siguienteAleatorio(semilla) % 10) + 1);
+    }
+    chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+    if (hechas == 0) return 0;      // Cola vacia: no hubo decisiones que medir
+    return chrono::duration<double, nano>(fin - inicio).count() / hechas;
 }
 
-    // Desencola (ejecuta) el proceso con mayor prioridad
-    void ejecutarProceso() {
-    if (frente == NULL) {
-        cout << "No hay procesos en la cola." << endl;
-        return;
-    }
+template <class Cola>
+void medirColaListos(int n, const char* nombre) {
+    const int decisiones = 4000000;
+    double ns = nsPorDecision<Cola>(n, decisiones);
+    char buffer[120];
+    sprintf(buffer, "%-13d%-18s%-14d%-14.2f%.2f", n, nombre, decisiones, ns, 1000.0 / ns);
+    cout << buffer << endl;
+}
 
-    Nodo* temp = frente;		// Tomar el nodo del frente
-    frente = frente->siguiente;
-	// Cambia el estado del proceso
-    strcpy(temp->proceso->estado, "ejecutando");
-    cout << "Ejecutando proceso: " << temp->proceso->nombre << endl;
+// Compara las colas de listos (monticulo, multinivel y CFS) contra la lista
+// enlazada original.
+// Cada decision = encolar un proceso + desencolar el de mayor prioridad,
+// con la cola mantenida en un tamanio fijo.
+void benchmarkColaListos() {
+    const int tamanios[] = {1000, 10000, 100000, 1000000};
+    const int cantidadTamanios = sizeof(tamanios) / sizeof(tamanios[0]);
 
-    strcpy(temp->proceso->estado, "terminado");
-    cout << "Proceso '" << temp->proceso->nombre << "' ha terminado." << endl;
+    cout << "\n========== BENCHMARK: cola de listos del planificador ==========\n";
+    cout << "En cola      Estructura        Decisiones    ns/decision   Mdec/s\n";
+    cout << "================================================================\n";
 
-    // Guardar en historial de ejecutados SIN eliminar
-    temp->siguiente = ejecutados;
-    ejecutados = temp;
-}
-    // Muestra los procesos que ya fueron ejecutados
-    void mostrarEjecutados() {
-    if (ejecutados == NULL) {
-        cout << "\n Aun no hay procesos ejecutados.\n";
-        return;
+    for (int t = 0; t < cantidadTamanios; t++) {
+        int n = tamanios[t];
+        char buffer[120];
+
+        medirColaListos<MonticuloIndexado<4> >(n, "monticulo-4");
+        medirColaListos<ColaEnvejecimiento>(n, "envejecimiento-4");
+        medirColaListos<ColaNiveles>(n, "niveles-bitmap");
+        medirColaListos<ColaCFS>(n, "arbol-cfs");
+
+        // --- Lista enlazada original (O(n) por encolar) ---
+        {
+            int decisiones = 200000000 / n;
+            if (decisiones > 1000000) decisiones = 1000000;
+            ColaListaPrioridad lista;
+            // Llenado directo en orden (evita O(n^2) solo para preparar la prueba)
+            for (int p = 10; p >= 1; p--) {
+                for (int i = 0; i < n / 10; i++) lista.agregarAlFinal(p);
+            }
+            unsigned int semilla = 2463534242u;
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            for (int i = 0; i < decisiones; i++) {
+                lista.desencolar();
+                lista.encolar((int)(siguienteAleatorio(semilla) % 10) + 1);
+            }
+            chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+            double ns = chrono::duration<double, nano>(fin - inicio).count() / decisiones;
+            sprintf(buffer, "%-13d%-18s%-14d%-14.2f%.2f", n, "lista-enlazada", decisiones, ns, 1000.0 / ns);
+            cout << buffer << endl;
+        }
     }
+    cout << "================================================================\n";
+}
 
-    cout << "\n======= HISTORIAL DE PROCESOS EJECUTADOS ======\n";
-    cout << "ID    Nombre                  Prioridad\n";
-    cout << "===============================================\n";
+// Evento de una traza de memoria: reservar un objeto o liberarlo
+struct EventoTraza {
+    bool reservar;
+    unsigned int tamanio;      // En unidades (solo al reservar)
+    unsigned int objeto;       // Indice del objeto dentro de la traza
+};
 
-    Nodo* temp = ejecutados;
-    while (temp != NULL) {
-        cout << temp->proceso->id;
+// Genera una traza reproducible que mantiene la memoria pedida cerca del
+// 80% de la capacidad. Tamaños: muchos chicos, algunos medianos y pocos
+// grandes; se libera un objeto vivo al azar. Retorna cuantos objetos crea.
+unsigned int generarTrazaMemoria(EventoTraza* traza, int eventos, unsigned int capacidad) {
+    unsigned int* vivos = new unsigned int[eventos];
+    unsigned int* tamanioDe = new unsigned int[eventos];
+    int cantidadVivos = 0;
+    unsigned int objetos = 0;
+    unsigned long long pedido = 0;
+    unsigned int semilla = 1013904223u;
 
-        // Ajuste de espacios seg�n tama�o del ID
-        if (temp->proceso->id < 10) cout << "     ";
-        else if (temp->proceso->id < 100) cout << "    ";
-        else cout << "   ";
+    for (int i = 0; i < eventos; i++) {
+        bool reservar = (cantidadVivos == 0) ||
+            (siguienteAleatorio(semilla) % 100 < (pedido < capacidad * 4ULL / 5 ? 60u : 40u));
+        if (reservar) {
+            unsigned int r = siguienteAleatorio(semilla) % 100;
+            unsigned int tamanio;
+            if (r < 60) tamanio = 1 + siguienteAleatorio(semilla) % 8;
+            else if (r < 90) tamanio = 8 + siguienteAleatorio(semilla) % 120;
+            else if (r < 99) tamanio = 128 + siguienteAleatorio(semilla) % 1920;
+            else tamanio = 2048 + siguienteAleatorio(semilla) % 14336;
+            traza[i].reservar = true;
+            traza[i].tamanio = tamanio;
+            traza[i].objeto = objetos;
+            tamanioDe[objetos] = tamanio;
+            vivos[cantidadVivos++] = objetos++;
+            pedido += tamanio;
+        } else {
+            int k = (int)(siguienteAleatorio(semilla) % (unsigned int)cantidadVivos);
+            traza[i].reservar = false;
+            traza[i].tamanio = 0;
+            traza[i].objeto = vivos[k];
+            pedido -= tamanioDe[vivos[k]];
+            vivos[k] = vivos[--cantidadVivos];
+        }
+    }
+    delete[] vivos;
+    delete[] tamanioDe;
+    return objetos;
+}
 
-        // Imprimir nombre y ajustar espacios
-        cout << temp->proceso->nombre;			// Mostrar nombre del proceso
-        int len = strlen(temp->proceso->nombre);
-        for (int i = len; i < 24; i++) cout << " ";		// Ajustar espacios
+// Reproduce la traza sobre un asignador y reporta latencia de reserva,
+// fallos y fragmentacion externa muestreada cada 256 eventos
+template <class Asignador>
+void reproducirTraza(const EventoTraza* traza, int eventos, unsigned int objetos,
+                     unsigned int capacidad, const char* nombre, double costoReloj) {
+    Asignador asignador(capacidad);
+    unsigned int* direccionDe = new unsigned int[objetos];
+    long long reservas = 0, fallos = 0;
+    double nsTotal = 0, nsMaximo = 0;
+    double sumaFragmentacion = 0, sumaOcupacion = 0;
+    int muestras = 0;
 
-        // Imprimir prioridad
-        cout << temp->proceso->prioridad << endl;
+    for (int i = 0; i < eventos; i++) {
+        const EventoTraza& e = traza[i];
+        if (e.reservar) {
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            unsigned int d = asignador.reservar(e.tamanio);
+            chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+            double ns = chrono::duration<double, nano>(fin - inicio).count() - costoReloj;
+            nsTotal += ns;
+            if (ns > nsMaximo) nsMaximo = ns;
+            reservas++;
+            if (d == Asignador::SIN_BLOQUE) fallos++;
+            direccionDe[e.objeto] = d;
+        } else if (direccionDe[e.objeto] != Asignador::SIN_BLOQUE) {
+            asignador.liberar(direccionDe[e.objeto]);
+        }
 
-        temp = temp->siguiente;
+        if ((i & 255) == 255) {
+            sumaFragmentacion += asignador.fragmentacionExterna();
+            sumaOcupacion += 1.0 - (double)asignador.libres() / capacidad;
+            muestras++;
+        }
     }
 
-    cout << "===============================================\n";
+    char buffer[120];
+    sprintf(buffer, "%-18s%-12.1f%-12.0f%-10.2f%-14.1f%.1f", nombre,
+            nsTotal / reservas, nsMaximo, 100.0 * fallos / reservas,
+            100.0 * sumaFragmentacion / muestras, 100.0 * sumaOcupacion / muestras);
+    cout << buffer << endl;
+    delete[] direccionDe;
 }
 
-// Permite eliminar procesos ejecutados, individualmente o todos
-void eliminarProcesosEjecutados() {
-    int opcion;
+// Compara las politicas de ubicacion (y el buddy) con la misma traza
+void benchmarkPoliticasMemoria() {
+    const unsigned int capacidad = 1u << 20;    // Unidades (p. ej. KB: 1 GB)
+    const int eventos = 400000;
 
-    do {
-        cout << "\n===== ELIMINAR PROCESOS EJECUTADOS =====\n";
-        cout << "1. Eliminar por ID\n";
-        cout << "2. Eliminar todos los procesos ejecutados\n";
-        cout << "3. Volver al menu del planificador\n";
-        cout << "Seleccione una opcion: ";
-        cin >> opcion;
+    EventoTraza* traza = new EventoTraza[eventos];
+    unsigned int objetos = generarTrazaMemoria(traza, eventos, capacidad);
 
-        // Validaci�n  de entrada
-        if (cin.fail()) {
-            cin.clear();                // Limpiar error de entrada
-            cin.ignore(1000, '\n');     
-            cout << "\nIngrese solo numeros validos.\n";
+    // Costo de dos lecturas del reloj, descontado de cada medicion
+    const int calibracion = 100000;
+    chrono::steady_clock::time_point a = chrono::steady_clock::now();
+    for (int i = 0; i < calibracion; i++) chrono::steady_clock::now();
+    chrono::steady_clock::time_point b = chrono::steady_clock::now();
+    double costoReloj = chrono::duration<double, nano>(b - a).count() / calibracion;
+
+    cout << "\n========== BENCHMARK: politicas de ubicacion de memoria ==========\n";
+    cout << "Capacidad: " << capacidad << " unidades | Eventos: " << eventos
+         << " | Objetos: " << objetos << "\n";
+    cout << "Politica          ns/reserva  max ns      Fallos %  Frag. ext. %  Ocupacion %\n";
+    cout << "==================================================================\n";
+    reproducirTraza<AsignadorListaLibre<AjustePrimero> >(traza, eventos, objetos, capacidad,
+                                                          AjustePrimero::nombre(), costoReloj);
+    reproducirTraza<AsignadorListaLibre<AjusteSiguiente> >(traza, eventos, objetos, capacidad,
+                                                            AjusteSiguiente::nombre(), costoReloj);
+    reproducirTraza<AsignadorListaLibre<AjusteMejor> >(traza, eventos, objetos, capacidad,
+                                                        AjusteMejor::nombre(), costoReloj);
+    reproducirTraza<AsignadorListaLibre<AjustePeor> >(traza, eventos, objetos, capacidad,
+                                                       AjustePeor::nombre(), costoReloj);
+    reproducirTraza<AsignadorListaLibre<AjusteSegregado> >(traza, eventos, objetos, capacidad,
+                                                            AjusteSegregado::nombre(), costoReloj);
+    reproducirTraza<AsignadorBuddy>(traza, eventos, objetos, capacidad, "buddy", costoReloj);
+    cout << "==================================================================\n";
+    cout << "(la ocupacion del buddy incluye el redondeo a potencia de 2)\n";
+
+    delete[] traza;
+}
+
+// Traza sintetica con localidad: los procesos se turnan en rafagas
+// (como con un quantum) y cada uno recorre su codigo en bucle, toca un
+// conjunto de trabajo que se desplaza de a poco y a veces salta a una
+// pagina cualquiera de su espacio
+void generarTrazaPaginas(ReferenciaPagina* traza, long long n, unsigned int procesos,
+                         unsigned int paginasPorProceso, unsigned int semilla) {
+    const unsigned int RAFAGA = 1000;
+    const unsigned int PAGINAS_CODIGO = 16;
+    const unsigned int CONJUNTO_TRABAJO = 64;
+
+    unsigned int* contadorBucle = new unsigned int[procesos];
+    unsigned int* baseTrabajo = new unsigned int[procesos];
+    for (unsigned int p = 0; p < procesos; p++) {
+        contadorBucle[p] = 0;
+        baseTrabajo[p] = PAGINAS_CODIGO;
+    }
+
+    unsigned int actual = 0;
+    for (long long t = 0; t < n; t++) {
+        if (t % RAFAGA == 0) actual = siguienteAleatorio(semilla) % procesos;
+        unsigned int r = siguienteAleatorio(semilla);
+        unsigned int tipo = r % 100;
+        unsigned int pagina;
+        if (tipo < 50) {
+            pagina = (contadorBucle[actual]++ >> 3) % PAGINAS_CODIGO;
+        } else if (tipo < 95) {
+            pagina = baseTrabajo[actual] + (r >> 8) % CONJUNTO_TRABAJO;
         } else {
-            // Seleccionar acci�n seg�n opci�n ingresada
-            switch (opcion) {
+            pagina = (r >> 8);
+        }
+        if ((r >> 24) == 0) baseTrabajo[actual] += 1 + (r >> 8) % 8;
+        traza[t].proceso = actual;
+        traza[t].pagina = pagina % paginasPorProceso;
+    }
+    delete[] contadorBucle;
+    delete[] baseTrabajo;
+}
 
-                case 1: { // Eliminar proceso por ID
-                    if (ejecutados == NULL) {
-                        // Si esta vac�a
-                        cout << "\nNo hay procesos ejecutados.\n";
-                    } else {
-                        int id;
-                        cout << "Ingrese el ID del proceso a eliminar: ";
-                        cin >> id;
+// Numera de forma densa los pares (proceso, pagina) de una traza: cada
+// proceso recibe sus paginas 0, 1, 2... en orden de primera aparicion.
+// Asi las tablas de paginas del simulador miden lo que la traza usa y
+// no la pagina mas alta, que puede ser cualquier entero. Direccionamiento
+// abierto con sondeo lineal sobre la clave (proceso << 32 | pagina) + 1.
+class NumeradorPaginas {
+private:
+    unsigned long long* claves;     // 0 = casilla vacia
+    unsigned int* numeros;
+    unsigned int capacidad;         // Siempre potencia de 2
+    unsigned int cantidad;
 
-                        if (cin.fail()) {
-                            cin.clear();
-                            cin.ignore(1000, '\n');
-                            cout << "\nIngrese un ID valido (solo numeros).\n";
-                        } else {
-                            Nodo* temp = ejecutados;
-                            Nodo* anterior = NULL;
-                            bool encontrado = false;
+    unsigned int posicionInicial(unsigned long long clave) const {
+        return (unsigned int)((clave * 0x9E3779B97F4A7C15ULL) >> 32) & (capacidad - 1);
+    }
 
-                            // Buscar nodo con ID especificado
-                            while (temp != NULL) {
-                                if (temp->proceso->id == id) {
-                                    encontrado = true;
-                                    // Si es el primer nodo de la lista
-                                    if (anterior == NULL)
-                                        ejecutados = temp->siguiente;
-                                    else
-                                        anterior->siguiente = temp->siguiente;
+    void colocar(unsigned long long clave, unsigned int numero) {
+        unsigned int i = posicionInicial(clave);
+        while (claves[i] != 0) i = (i + 1) & (capacidad - 1);
+        claves[i] = clave;
+        numeros[i] = numero;
+    }
 
-                                    delete temp; // Liberar memoria del nodo
-                                    cout << "\nProceso con ID " << id << " eliminado del historial.\n";
-                                    break; 
-                                }
-                                anterior = temp;
-                                temp = temp->siguiente;
-                            }
+    void crecer() {
+        unsigned long long* clavesAnteriores = claves;
+        unsigned int* numerosAnteriores = numeros;
+        unsigned int capacidadAnterior = capacidad;
+        capacidad *= 2;
+        claves = new unsigned long long[capacidad];
+        numeros = new unsigned int[capacidad];
+        memset(claves, 0, sizeof(unsigned long long) * capacidad);
+        for (unsigned int i = 0; i < capacidadAnterior; i++) {
+            if (clavesAnteriores[i] != 0) colocar(clavesAnteriores[i], numerosAnteriores[i]);
+        }
+        delete[] clavesAnteriores;
+        delete[] numerosAnteriores;
+    }
+
+public:
+    NumeradorPaginas() {
+        capacidad = 1024;
+        cantidad = 0;
+        claves = new unsigned long long[capacidad];
+        numeros = new unsigned int[capacidad];
+        memset(claves, 0, sizeof(unsigned long long) * capacidad);
+    }
 
-                            // Si no se encontr� el ID
-                            if (!encontrado)
-                                cout << "\nNo se encontro ningun proceso con ese ID.\n";
-                        }
-                    }
-                    break; 
-                }
+    // Numero denso de la pagina; si es nueva toma paginasDelProceso y lo avanza
+    unsigned int numerar(unsigned int proceso, unsigned int pagina, unsigned int& paginasDelProceso) {
+        unsigned long long clave = (((unsigned long long)proceso << 32) | pagina) + 1;
+        unsigned int i = posicionInicial(clave);
+        while (claves[i] != 0) {
+            if (claves[i] == clave) return numeros[i];
+            i = (i + 1) & (capacidad - 1);
+        }
+        claves[i] = clave;
+        numeros[i] = paginasDelProceso++;
+        if (++cantidad * 2 > capacidad) crecer();
+        return paginasDelProceso - 1;
+    }
 
-                case 2: { // Eliminar todos los procesos ejecutados
-                    if (ejecutados == NULL) {
-                        cout << "\nNo hay procesos ejecutados.\n";
-                    } else {
-                        Nodo* temp = ejecutados;
-                        // Recorrer la lista y liberar memoria de cada nodo
-                        while (temp != NULL) {
-                            Nodo* borrar = temp;
-                            temp = temp->siguiente;
-                            delete borrar;
-                        }
-                        ejecutados = NULL; // Lista queda vac�a
-                        cout << "\nTodos los procesos ejecutados han sido eliminados.\n";
-                    }
-                    break; 
-                }
+    // Pares (proceso, pagina) distintos vistos hasta ahora
+    unsigned int tamanio() const {
+        return cantidad;
+    }
 
-                case 3: // Salir del men�
-                    cout << "\nRegresando al menu del planificador...\n";
-                    break;
+    ~NumeradorPaginas() {
+        delete[] claves;
+        delete[] numeros;
+    }
+};
 
-                default: // Opci�n inv�lida
-                    cout << "\nOpcion no valida.\n";
-                    break;
-            }
+// Lee una traza de texto con una referencia "proceso pagina" por linea
+// (las lineas vacias y las que empiezan con '#' se ignoran). Las paginas
+// se renumeran de forma densa por proceso (ver NumeradorPaginas), lo que
+// no cambia los fallos de ninguna politica. Calcula la cantidad de
+// procesos y de paginas distintas de cada uno. Retorna la cantidad de
+// referencias o -1 si hay una linea invalida o demasiadas paginas.
+long long leerTrazaPaginas(FILE* archivo, ReferenciaPagina*& traza,
+                           unsigned int*& paginasPorProceso, unsigned int& procesos) {
+    const unsigned int MAXIMO_PROCESOS = 1u << 20;
+    const unsigned int MAXIMO_PAGINAS = 1u << 24;   // Paginas distintas en toda la traza
+    long long capacidad = 1 << 20, n = 0;
+    unsigned int capacidadProcesos = 16;
+    traza = new ReferenciaPagina[capacidad];
+    paginasPorProceso = new unsigned int[capacidadProcesos];
+    procesos = 0;
+
+    NumeradorPaginas numerador;
+    LectorLineas lector(archivo);
+    char* linea;
+    long long numeroLinea = 0;
+    while ((linea = lector.siguienteLinea()) != NULL) {
+        numeroLinea++;
+        char* palabras[3];
+        int cantidad = separarPalabras(linea, palabras, 3);
+        if (cantidad == 0 || palabras[0][0] == '#') continue;
+
+        int proceso, pagina;
+        if (cantidad != 2 || !leerEntero(palabras[0], proceso) || !leerEntero(palabras[1], pagina) ||
+            proceso < 0 || pagina < 0 || (unsigned int)proceso >= MAXIMO_PROCESOS) {
+            cout << "[TRAZA] Linea " << numeroLinea << " invalida (se espera: proceso pagina)\n";
+            delete[] traza;
+            delete[] paginasPorProceso;
+            traza = NULL;
+            paginasPorProceso = NULL;
+            return -1;
         }
 
-// Repetir mientras la opci�n no sea 3
-    } while (opcion != 3);
+        if (n == capacidad) {
+            ReferenciaPagina* nueva = new ReferenciaPagina[capacidad * 2];
+            memcpy(nueva, traza, sizeof(ReferenciaPagina) * capacidad);
+            delete[] traza;
+            traza = nueva;
+            capacidad *= 2;
+        }
+        if ((unsigned int)proceso >= capacidadProcesos) {
+            unsigned int nuevaCapacidad = capacidadProcesos;
+            while (nuevaCapacidad <= (unsigned int)proceso) nuevaCapacidad *= 2;
+            unsigned int* nuevas = new unsigned int[nuevaCapacidad];
+            memcpy(nuevas, paginasPorProceso, sizeof(unsigned int) * procesos);
+            delete[] paginasPorProceso;
+            paginasPorProceso = nuevas;
+            capacidadProcesos = nuevaCapacidad;
+        }
+        while (procesos <= (unsigned int)proceso) paginasPorProceso[procesos++] = 0;
+        traza[n].proceso = proceso;
+        traza[n].pagina = numerador.numerar(proceso, pagina, paginasPorProceso[proceso]);
+        n++;
+        if (numerador.tamanio() > MAXIMO_PAGINAS) {
+            cout << "[TRAZA] Linea " << numeroLinea << ": la traza usa mas de " << MAXIMO_PAGINAS
+                 << " paginas distintas\n";
+            delete[] traza;
+            delete[] paginasPorProceso;
+            traza = NULL;
+            paginasPorProceso = NULL;
+            return -1;
+        }
+    }
+    return n;
 }
 
-    // Muestra la cola actual
-    void mostrarCola() {
-    if (frente == NULL) {
-        cout << "\n*** La cola de procesos esta vacia ***\n";
-        return;
-    }
+// Simula una politica y escribe su fila (la preparacion de OPT se cuenta en el tiempo)
+template <class Reemplazo>
+void simularReemplazo(const ReferenciaPagina* traza, long long n, const unsigned int* paginasPorProceso,
+                      unsigned int procesos, unsigned int marcos, unsigned int entradasTLB) {
+    SimuladorPaginacion<Reemplazo> simulador(marcos, entradasTLB, paginasPorProceso, procesos);
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    simulador.preparar(traza, n);
+    simulador.ejecutar(traza, n);
+    chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+    double segundos = chrono::duration<double>(fin - inicio).count();
 
-    cout << "\n=============== COLA DE PROCESOS ===============\n";
-    cout << "ID    Nombre                  Prioridad    Estado\n";
-    cout << "=================================================\n";
+    char buffer[120];
+    sprintf(buffer, "%-10s%-14lld%-12.3f%-10.2f%.1f", simulador.nombre(), simulador.cantidadFallos(),
+            100.0 * simulador.tasaAciertos(), 100.0 * simulador.tasaAciertosTLB(),
+            n / segundos / 1e6);
+    cout << buffer << endl;
+}
 
-    Nodo* temp = frente;
-    while (temp != NULL) {
-        cout << temp->proceso->id;
+// Compara las politicas de reemplazo con la misma traza
+void compararReemplazos(const ReferenciaPagina* traza, long long n, const unsigned int* paginasPorProceso,
+                        unsigned int procesos, unsigned int marcos, unsigned int entradasTLB) {
+    unsigned int totalPaginas = 0;
+    for (unsigned int p = 0; p < procesos; p++) totalPaginas += paginasPorProceso[p];
 
-        // Espacios seg�n tama�o del ID
-        if (temp->proceso->id < 10) cout << "     ";
-        else if (temp->proceso->id < 100) cout << "    ";
-        else cout << "   ";
+    cout << "\n========== SIMULACION: reemplazo de paginas ==========\n";
+    cout << "Referencias: " << n << " | Procesos: " << procesos << " | Paginas: " << totalPaginas
+         << " | Marcos: " << marcos << " | TLB: " << entradasTLB << "\n";
+    cout << "Politica  Fallos        Aciertos %  TLB %     Mref/s\n";
+    cout << "======================================================\n";
+    simularReemplazo<ReemplazoFIFO>(traza, n, paginasPorProceso, procesos, marcos, entradasTLB);
+    simularReemplazo<ReemplazoLRU>(traza, n, paginasPorProceso, procesos, marcos, entradasTLB);
+    simularReemplazo<ReemplazoReloj>(traza, n, paginasPorProceso, procesos, marcos, entradasTLB);
+    simularReemplazo<ReemplazoOptimo>(traza, n, paginasPorProceso, procesos, marcos, entradasTLB);
+    cout << "======================================================\n";
+}
 
-        cout << temp->proceso->nombre;
-        int len = strlen(temp->proceso->nombre);
+// Traza sintetica de 8 procesos con distintas cantidades de marcos
+void benchmarkPaginacion() {
+    const long long referencias = 20000000;
+    const unsigned int procesos = 8;
+    const unsigned int paginas = 4096;
+    const unsigned int marcosProbados[] = {128, 512, 2048};
 
-        // Ajuste de espacios para nombre
-        for (int i = len; i < 24; i++) cout << " ";
+    ReferenciaPagina* traza = new ReferenciaPagina[referencias];
+    generarTrazaPaginas(traza, referencias, procesos, paginas, 2463534242u);
+    unsigned int paginasPorProceso[procesos];
+    for (unsigned int p = 0; p < procesos; p++) paginasPorProceso[p] = paginas;
 
-        cout << temp->proceso->prioridad;
-        if (temp->proceso->prioridad < 10) cout << "           ";
-        else if (temp->proceso->prioridad < 100) cout << "          ";
-        else cout << "         ";
+    for (int i = 0; i < 3; i++) {
+        compararReemplazos(traza, referencias, paginasPorProceso, procesos, marcosProbados[i], 64);
+    }
+    delete[] traza;
+}
 
-        cout << temp->proceso->estado << endl;
+// Tres veces mas memoria pedida que la disponible: un bucle tipo
+// planificador recorre los procesos, pregunta si estan cargados y
+// ejecuta un quantum de trabajo si lo estan (si no, el quantum queda
+// ocioso y el hilo duerme, como una CPU sin trabajo). Mide cuanto tarda la
+// consulta (no debe esperar al disco) y reporta ancho de banda y
+// latencia del area de intercambio.
+void benchmarkIntercambio() {
+    const int procesos = 48;
+    const int bloquesPorProceso = 2;
+    const unsigned long long tamanioBloque = 64 * BYTES_MB;     // 48 * 2 * 64 MB = 6 GB sobre 2 GB
+    const int vueltas = 50000;
+    const double quantumNs = 20000;     // Trabajo simulado por ejecucion
+    const char* ruta = "intercambio_benchmark.swp";
 
-        temp = temp->siguiente;
+    cout << "\n========== BENCHMARK: area de intercambio ==========\n";
+    GestorProcesos gestor;
+    GestorMemoria memoria(gestor);
+    if (!memoria.habilitarIntercambio(ruta)) {
+        cout << "[ERROR] No se pudo crear " << ruta << "\n";
+        return;
+    }
+    HandleProceso handles[procesos];
+    for (int i = 0; i < procesos; i++) {
+        gestor.crear("proceso", (i % 10) + 1);
+        handles[i] = gestor.buscarHandle(i + 1);
+        for (int b = 0; b < bloquesPorProceso; b++) memoria.reservar(handles[i], tamanioBloque);
     }
 
-    cout << "=================================================\n";
+    // Localidad: 95% de las vueltas van a un grupo de 8 procesos que rota
+    unsigned int semilla = 2463534242u;
+    long long ejecutables = 0;
+    double nsMaximo = 0, nsTotal = 0;
+    for (int v = 0; v < vueltas; v++) {
+        unsigned int r = siguienteAleatorio(semilla);
+        int k = (r % 100 < 95) ? (int)((v / 10000) * 8 + (r >> 8) % 8) % procesos
+                               : (int)((r >> 8) % procesos);
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        bool cargado = memoria.prepararEjecucion(handles[k]);
+        chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+        double ns = chrono::duration<double, nano>(fin - inicio).count();
+        nsTotal += ns;
+        if (ns > nsMaximo) nsMaximo = ns;
+        if (!cargado) {
+            this_thread::sleep_for(chrono::microseconds((long long)(quantumNs / 1000)));
+            continue;
+        }
+        ejecutables++;
+        while (chrono::duration<double, nano>(chrono::steady_clock::now() - fin).count() < quantumNs) {}
+    }
+    memoria.esperarIntercambio();
+
+    char linea[120];
+    sprintf(linea, "Vueltas: %d | con memoria cargada: %.1f%% | consulta: %.0f ns (max %.1f us)\n",
+            vueltas, 100.0 * ejecutables / vueltas, nsTotal / vueltas, nsMaximo / 1000.0);
+    cout << linea;
+    memoria.mostrarIntercambio();
 }
-    // Men� del planificador
-    void menuPlanificador(GestorProcesos& gestor) {
-        int opcion;
-        string nombre;
-        int prioridad;
 
-        do {
-            cout << "\n======= PLANIFICADOR DE CPU =======\n";
-            cout << "1. Encolar proceso\n";
-            cout << "2. Ejecutar proceso (desencolar)\n";
-            cout << "3. Mostrar cola actual\n";
-            cout << "4. Mostrar procesos ejecutados\n";
-            cout << "5. Eliminar procesos ejecutados\n";
-            cout << "6. Volver al menu principal\n";
-            cout << "===================================\n";
-            cout << "Opcion: ";
-            cin >> opcion;
-            cin.ignore();
+// Flujo de salida que descarta todo (mensajes de los modulos durante una medicion)
+class BufferNulo : public streambuf {
+protected:
+    int overflow(int c) {
+        return (c == EOF) ? 0 : c;
+    }
+    streamsize xsputn(const char*, streamsize n) {
+        return n;
+    }
+};
 
-            switch (opcion) {
-               case 1: {		// Encolar proceso seleccionado por el usuario
-    			if (gestor.estaVacia()) {
-        		cout << "\nNo hay procesos creados en el Gestor de Procesos.\n";	// Verificar si hay procesos en el gestor
-        		break;
-    				}
+// Llena la memoria con bloques de 4 KB a 4 MB (y algunos objetos
+// chicos) y libera dos de cada tres al azar: queda memoria libre
+// suficiente pero repartida en muchos bloques chicos
+void fragmentarMemoria(GestorMemoria& memoria, GestorProcesos& gestor, HandleProceso* handles,
+                       int procesos, unsigned int semilla) {
+    for (int i = 0; i < procesos; i++) handles[i] = gestor.crear("proceso", (i % 10) + 1);
+    int fallos = 0;
+    while (fallos < 64) {
+        unsigned int r = siguienteAleatorio(semilla);
+        HandleProceso h = handles[(r >> 8) % procesos];
+        unsigned long long tamanio = (r % 64 == 0) ? 64
+            : (GestorMemoria::TAMANIO_PAGINA << (r % 11)) - (r >> 20) % GestorMemoria::TAMANIO_PAGINA;
+        if (!memoria.reservar(h, tamanio)) fallos++;
+    }
+    for (int i = 0; i < procesos; i++) {
+        int id = gestor.resolver(handles[i]).id();
+        int bloques;
+        memoria.memoriaDeProceso(id, &bloques);
+        for (int b = 0; b < bloques * 2 / 3; b++) memoria.quitarPorID(id);
+    }
+}
 
-    			int idSeleccionado;		// ID del proceso que desea encolar
-    			Proceso* p = NULL;		// Puntero al proceso seleccionado, inicializado en NULL
-    			gestor.mostrar();  		// Mostrar todos los procesos disponibles
+// Compacta la misma memoria fragmentada de una vez y de a poco con
+// distintos presupuestos por tick; la pausa es el tick mas largo (la
+// copia de los bytes se hace de verdad sobre un buffer)
+void benchmarkCompactacion() {
+    const int procesos = 64;
+    const unsigned int semilla = 2463534242u;
+    const unsigned long long presupuestos[] = {0, 256 * BYTES_KB, 4 * BYTES_MB, 64 * BYTES_MB};
+    HandleProceso handles[procesos];
+    char texto[32];
 
-   				bool idValido = false;	
-    			while (!idValido) {		// Bucle para asegurar que se ingrese un ID v�lido
-        			cout << "\nIngrese el ID del proceso que desea encolar: ";
-        			cin >> idSeleccionado;
+    cout << "\n========== BENCHMARK: compactacion de memoria ==========\n";
+    streambuf* original = cout.rdbuf();
+    for (int i = 0; i < 4; i++) {
+        BufferNulo nulo;
+        cout.rdbuf(&nulo);
+        GestorProcesos gestor;
+        GestorMemoria memoria(gestor);
+        fragmentarMemoria(memoria, gestor, handles, procesos, semilla);
+        cout.rdbuf(original);
 
-        		if (cin.fail()) {		// Si la entrada no es un n�mero
-            		cin.clear();
-            		cin.ignore(1000, '\n');
-            		cout << "Ingrese un numero valido (solo digitos).\n";
-        		}
-        		else if (idSeleccionado <= 0) {  // Si el n�mero no es positivo
-            		cout << "El ID debe ser un numero positivo.\n";
-        		}
-        		else {
-            		p = gestor.buscar(idSeleccionado);		// Buscar proceso por ID
-            		if (p == NULL) {
-                		cin.ignore(1000, '\n');
-                		cout << "No existe ningun proceso con ese ID.\n";
-            	}
-            	else {  // Si se encontr� el proceso
-                	cin.ignore(1000, '\n'); 
-                	idValido = true;       // ID v�lido, salir del bucle 
-            }
+        if (i == 0) {
+            cout << "Memoria usada: " << formatearTamanio(memoria.capacidadTotal() - memoria.memoriaLibre(), texto);
+            cout << " | Mayor bloque libre: " << formatearTamanio(memoria.mayorBloqueLibre(), texto);
+            cout << " | Frag. externa: " << (int)(memoria.fragmentacionExterna() * 100 + 0.5) << "%";
+            cout << " | Bloques libres: " << memoria.cantidadBloquesLibres() << "\n";
+            cout << "Modo                 Ticks    Movido      Bloques  Pausa max ms  Total ms  Mayor libre  Frag. ext.  Libres\n";
+            cout << "=========================================================================================================\n";
+        }
+        if (presupuestos[i] == 0) {
+            memoria.compactar();
+        } else {
+            memoria.iniciarCompactacionIncremental(presupuestos[i]);
+            while (memoria.compactacionEnCurso()) memoria.finDeTick();
         }
-    }   			
-    			if (p != NULL) {
-        			Nodo* temp = frente;	// Nodo temporal para recorrer la cola
-        			bool yaEncolado = false;	// Detectar si ya est� encolado
-
-        		while (temp != NULL) {		// Recorrer la cola de procesos
-            		if (temp->proceso == p) {   	// Si se encuentra el proceso en la cola
-                		yaEncolado = true;		// Marcar que ya fue encolado
-                		break;
-            		}
-            		temp = temp->siguiente;	// Avanzar al siguiente nodo
-        		}
 
-        		if (yaEncolado) {  // Si ya estaba en la cola
-            		cout << "El proceso ya fue encolado anteriormente.\n";
-        		}  
-        		else {   		// Si no estaba en la cola
-            		encolar(p);	 // Encolar el proceso en la cola de CPU
-            		strcpy(p->estado, "listo");
-            		cout << "Proceso encolado correctamente.\n";
-        	}
-    	}
+        EstadisticasCompactacion e = memoria.estadisticasCompactacion();
+        char modo[32], movido[32], mayor[32], linea[200];
+        if (presupuestos[i] == 0) strcpy(modo, "total");
+        else sprintf(modo, "incremental %s", formatearTamanio(presupuestos[i], texto));
+        sprintf(linea, "%-20s %-8lld %-11s %-8lld %-13.3f %-9.1f %-12s %3d%%        %u\n", modo, e.pasos,
+                formatearTamanio(e.bytesMovidos, movido), e.bloquesMovidos, 1000.0 * e.pausaMaxima,
+                1000.0 * e.segundos, formatearTamanio(memoria.mayorBloqueLibre(), mayor),
+                (int)(memoria.fragmentacionExterna() * 100 + 0.5), memoria.cantidadBloquesLibres());
+        cout << linea;
+    }
+    cout << "=========================================================================================================\n";
+    cout << "(los objetos chicos viven en slabs que no se mueven)\n";
+}
 
-    			break;
-			}
-                case 2:		// Ejecutar proceso (desencolar)
-                    ejecutarProceso();
-                    break;
-                case 3:		// Mostrar la cola actual
-                    mostrarCola();
-                    break;
-                case 4:		// Mostrar los procesos ejecutados
-                    mostrarEjecutados();
-                    break;
-                case 5:		// Eliminar procesos ejecutados
-                    eliminarProcesosEjecutados();
-                	break;
-                case 6:		// Volver al men� principal
-                cout << "Volviendo al menu principal...\n";
-                	break;
-                default:
-                    cout << "Opcion invalida.\n";
-            }
-        } while (opcion != 6);
+// Los mismos procesos (de 1 a 16 quanta de 20 us) en 1 a 8 nucleos, con
+// y sin robo de trabajo, repartidos en ronda o todos en el nucleo 0.
+// El rendimiento solo escala hasta los nucleos reales del equipo.
+void benchmarkMultinucleo() {
+    const int procesos = 2000;
+    const long long quantumNs = 20000;
+    struct Corrida {
+        int nucleos;
+        bool repartir;
+        bool robo;
+    };
+    const Corrida corridas[] = {
+        {1, true, true}, {2, true, true}, {4, true, true}, {8, true, true},
+        {4, true, false}, {4, false, true}, {4, false, false}
+    };
+    const int cantidadCorridas = sizeof(corridas) / sizeof(corridas[0]);
+    TareaNucleo* tareas = new TareaNucleo[procesos];
+    int* orden = new int[procesos];
+    double rendimientoBase = 0;
+
+    cout << "\n========== BENCHMARK: planificador multinucleo ==========\n";
+    cout << "Procesos: " << procesos << " | Quantum: " << quantumNs / 1000 << " us"
+         << " | Nucleos del equipo: " << thread::hardware_concurrency() << "\n";
+    cout << "Nucleos  Reparto   Robo  Tiempo ms  Quanta/s    Acelera  Ocup. min  Ocup. max  Robos    Migr.\n";
+    cout << "==============================================================================================\n";
+    for (int c = 0; c < cantidadCorridas; c++) {
+        for (int i = 0; i < procesos; i++) {
+            tareas[i].id = i + 1;
+            tareas[i].prioridad = (i % 10) + 1;
+            tareas[i].quantaRestantes = PlanificadorCPU::rafagaDe(i + 1);
+        }
+        PlanificadorMultinucleo multinucleo(corridas[c].nucleos, quantumNs, corridas[c].robo);
+        multinucleo.ejecutar(tareas, procesos, orden, corridas[c].repartir);
+
+        double minimo = 1, maximo = 0;
+        for (int n = 0; n < multinucleo.cantidadNucleos(); n++) {
+            double o = multinucleo.ocupacion(n);
+            if (o < minimo) minimo = o;
+            if (o > maximo) maximo = o;
+        }
+        double rendimiento = multinucleo.totalQuanta() / multinucleo.segundosTotales();
+        if (c == 0) rendimientoBase = rendimiento;
+        long long quanta = multinucleo.totalQuanta();
+        char linea[160];
+        sprintf(linea, "%-8d %-9s %-5s %-10.1f %-11.0f %-8.2f %5.1f%%     %5.1f%%     %-8lld %.2f%%\n",
+                corridas[c].nucleos, corridas[c].repartir ? "ronda" : "nucleo 0", corridas[c].robo ? "si" : "no",
+                1000.0 * multinucleo.segundosTotales(), rendimiento, rendimiento / rendimientoBase,
+                100.0 * minimo, 100.0 * maximo, multinucleo.totalRobos(),
+                (quanta > 0) ? 100.0 * multinucleo.totalMigraciones() / quanta : 0.0);
+        cout << linea;
+    }
+    cout << "==============================================================================================\n";
+    if (thread::hardware_concurrency() < 8) {
+        cout << "(con mas nucleos simulados que los del equipo los hilos se reparten el tiempo:\n"
+             << " no hay aceleracion y la ocupacion incluye el tiempo en que el hilo fue desalojado)\n";
     }
+    delete[] orden;
+    delete[] tareas;
+}
+
+// Mezcla del benchmark concurrente: 90% buscar, 5% cambiar prioridad,
+// 3% cambiar estado y 2% quitar uno y crear otro. Los IDs se eligen en
+// [1, 2 * iniciales] (parte de las busquedas no encuentran nada).
+struct MezclaGestor {
+    int operaciones;
+    int idMaximo;
+    unsigned int semilla;
+    long long lecturas;
+    double segundos;
 };
 
-// ============================================
-// MEN� DEL GESTOR DE PROCESOS
-// ============================================
-void menuGestorProcesos(GestorProcesos& gestor) {
-    int opcion, id, prioridad;
-    char nombre[50], estado[20];
-    bool entradaValida;
-    
-    do {
-        cout << "\n======= GESTOR DE PROCESOS =======\n";
-        cout << "1. Agregar proceso\n";
-        cout << "2. Mostrar lista de procesos\n";
-        cout << "3. Buscar proceso por ID\n";
-        cout << "4. Modificar prioridad\n";
-        cout << "5. Eliminar proceso\n";
-        cout << "6. Cambiar estado\n";
-        cout << "7. Volver al menu principal\n";
-        cout << "==================================\n";
-        cout << "Opcion: ";
-        cin >> opcion;
-        
-        if (cin.fail()) {
-            cin.clear();
-            cin.ignore(1000, '\n');
-            cout << "Error: Ingrese un numero valido.\n";
-            continue;
+void operarConcurrente(GestorProcesosConcurrente* gestor, MezclaGestor* m, const atomic<bool>* largada) {
+    while (!largada->load(memory_order_acquire)) this_thread::yield();
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    DatosProceso datos;
+    long long encontrados = 0;
+    for (int i = 0; i < m->operaciones; i++) {
+        unsigned int r = siguienteAleatorio(m->semilla);
+        int id = 1 + (int)(siguienteAleatorio(m->semilla) % (unsigned int)m->idMaximo);
+        int tipo = (int)(r % 100);
+        if (tipo < 90) {
+            if (gestor->buscar(id, datos)) encontrados += datos.prioridad;
+            m->lecturas++;
+        } else if (tipo < 95) {
+            gestor->cambiarPrioridad(id, 1 + (int)(r >> 8) % 10);
+        } else if (tipo < 98) {
+            gestor->fijarEstado(id, (unsigned char)((r >> 8) % CANTIDAD_ESTADOS));
+        } else {
+            if (gestor->quitar(id)) gestor->crear("proceso", 1 + (int)(r >> 8) % 10);
         }
-        cin.ignore();
+    }
+    m->segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    if (encontrados == -1) cout << "";      // Que el compilador no descarte las lecturas
+}
 
-        switch(opcion) {
-            case 1: // AGREGAR
-                cout << "\n--- AGREGAR NUEVO PROCESO ---\n";
-                cout << "Nombre del proceso: ";
-                cin.getline(nombre, 50);
-                while (strlen(nombre) == 0) {
-                    cout << "Error: El nombre no puede estar vacio.\n";
-                    cout << "Por favor, ingrese el nombre del proceso: ";
-                    cin.getline(nombre, 50);
-                }
-                
-                entradaValida = false;
-                while (!entradaValida) {
-                    cout << "Prioridad (1-10): ";
-                    cin >> prioridad;
-                    if (cin.fail()) {
-                        cin.clear();
-                        cin.ignore(1000, '\n');
-                        cout << "Error: Debe ingresar un numero.\n";
-                        cout << "Por favor, inserte una prioridad valida (1-10): ";
-                    } else if (prioridad < 1 || prioridad > 10) {
-                        cin.ignore(1000, '\n');
-                        cout << "Error: La prioridad debe estar entre 1 y 10.\n";
-                        cout << "Por favor, inserte una prioridad valida: ";
-                    } else {
-                        entradaValida = true;
-                        cin.ignore(1000, '\n');
-                    }
-                }
-                gestor.insertar(nombre, prioridad);
-                break;
+void operarConCerrojo(GestorProcesos* gestor, mutex* cerrojo, MezclaGestor* m, const atomic<bool>* largada) {
+    while (!largada->load(memory_order_acquire)) this_thread::yield();
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    DatosProceso datos;
+    long long encontrados = 0;
+    for (int i = 0; i < m->operaciones; i++) {
+        unsigned int r = siguienteAleatorio(m->semilla);
+        int id = 1 + (int)(siguienteAleatorio(m->semilla) % (unsigned int)m->idMaximo);
+        int tipo = (int)(r % 100);
+        lock_guard<mutex> guardia(*cerrojo);
+        if (tipo < 90) {
+            // La vista solo vale con el cerrojo tomado: se copia
+            Proceso proc = gestor->buscar(id);
+            if (proc.existe()) {
+                datos.id = proc.id();
+                datos.prioridad = proc.prioridad();
+                datos.estado = proc.codigoEstado();
+                strcpy(datos.nombre, proc.nombre());
+                encontrados += datos.prioridad;
+            }
+            m->lecturas++;
+        } else if (tipo < 95) {
+            gestor->cambiarPrioridad(id, 1 + (int)(r >> 8) % 10);
+        } else if (tipo < 98) {
+            gestor->fijarEstado(gestor->buscarHandle(id), (unsigned char)((r >> 8) % CANTIDAD_ESTADOS));
+        } else {
+            if (gestor->quitar(id)) gestor->crear("proceso", 1 + (int)(r >> 8) % 10);
+        }
+    }
+    m->segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    if (encontrados == -1) cout << "";
+}
 
-            case 2: // MOSTRAR
-                gestor.mostrar();
-                break;
+// El gestor por fragmentos con lecturas sin cerrojos contra
+// GestorProcesos detras de un cerrojo global, con 1 a 16 hilos y la
+// misma mezcla (90% lecturas). Las operaciones totales son fijas.
+void benchmarkGestorConcurrente() {
+    const int iniciales = 100000;
+    const int operacionesTotales = 2000000;
+    const int hilosPorCorrida[] = {1, 2, 4, 8, 16};
+    const int corridas = sizeof(hilosPorCorrida) / sizeof(hilosPorCorrida[0]);
 
-            case 3: // BUSCAR
-                if (gestor.estaVacia()) {
-                    cout << "Error: No hay procesos en el sistema.\n";
-                    break;
-                }
-                entradaValida = false;
-                while (!entradaValida) {
-                    cout << "ID del proceso a buscar: ";
-                    cin >> id;
-                    if (cin.fail()) {
-                        cin.clear();
-                        cin.ignore(1000, '\n');
-                        cout << "Error: El ID debe ser un numero.\n";
-                    } else {
-                        entradaValida = true;
-                        cin.ignore(1000, '\n');
-                    }
-                }
-                {
-                    Proceso* encontrado = gestor.buscar(id);
-                    if (encontrado != NULL) {
-                        gestor.mostrarFicha(encontrado);
-                    } else {
-                        cout << "\n>>> Proceso no encontrado <<<\n";
-                    }
-                }
-                break;
+    cout << "\n========== BENCHMARK: gestor de procesos concurrente (90% lecturas) ==========\n";
+    cout << "Procesos iniciales: " << iniciales << " | operaciones por corrida: " << operacionesTotales
+         << " | nucleos del equipo: " << thread::hardware_concurrency() << "\n";
+    cout << "Hilos  Fragmentos Mops/s  Lecturas Mops/s  Cerrojo global Mops/s  Lecturas Mops/s  Relacion\n";
+    cout << "===========================================================================================\n";
+    for (int c = 0; c < corridas; c++) {
+        int hilos = hilosPorCorrida[c];
+        double mops[2], lecturasMops[2];
+        for (int modo = 0; modo < 2; modo++) {
+            GestorProcesosConcurrente concurrente;
+            GestorProcesos secuencial;
+            mutex cerrojo;
+            for (int i = 0; i < iniciales; i++) {
+                if (modo == 0) concurrente.crear("proceso", 1 + i % 10);
+                else secuencial.crear("proceso", 1 + i % 10);
+            }
+            MezclaGestor* mezclas = new MezclaGestor[hilos];
+            thread* trabajadores = new thread[hilos];
+            atomic<bool> largada(false);
+            for (int k = 0; k < hilos; k++) {
+                mezclas[k].operaciones = operacionesTotales / hilos;
+                mezclas[k].idMaximo = 2 * iniciales;
+                mezclas[k].semilla = 2463534242u + 7919u * k;
+                mezclas[k].lecturas = 0;
+                mezclas[k].segundos = 0;
+                if (modo == 0) trabajadores[k] = thread(operarConcurrente, &concurrente, &mezclas[k], &largada);
+                else trabajadores[k] = thread(operarConCerrojo, &secuencial, &cerrojo, &mezclas[k], &largada);
+            }
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            largada.store(true, memory_order_release);
+            long long lecturas = 0;
+            for (int k = 0; k < hilos; k++) {
+                trabajadores[k].join();
+                lecturas += mezclas[k].lecturas;
+            }
+            double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+            mops[modo] = (double)(operacionesTotales / hilos) * hilos / segundos / 1e6;
+            lecturasMops[modo] = lecturas / segundos / 1e6;
+            delete[] trabajadores;
+            delete[] mezclas;
+        }
+        char linea[160];
+        sprintf(linea, "%-6d %-18.2f %-16.2f %-22.2f %-16.2f %.2fx\n", hilos, mops[0], lecturasMops[0], mops[1],
+                lecturasMops[1], mops[0] / mops[1]);
+        cout << linea;
+    }
+    cout << "===========================================================================================\n";
+    if (thread::hardware_concurrency() < 8) {
+        cout << "(con menos nucleos que hilos no hay aceleracion: los hilos se reparten el tiempo)\n";
+    }
+}
 
-            case 4: // MODIFICAR PRIORIDAD
-                if (gestor.estaVacia()) {
-                    cout << "Error: No hay procesos en el sistema.\n";
-                    break;
-                }
-                entradaValida = false;
-                while (!entradaValida) {
-                    cout << "ID del proceso: ";
-                    cin >> id;
-                    if (cin.fail()) {
-                        cin.clear();
-                        cin.ignore(1000, '\n');
-                        cout << "Error: El ID debe ser un numero.\n";
-                    } else {
-                        entradaValida = true;
-                        cin.ignore(1000, '\n');
-                    }
-                }
-                if (gestor.buscar(id) == NULL) {
-                    cout << "Error: No se encontro el proceso con ID " << id << endl;
-                    break;
-                }
-                entradaValida = false;
-                while (!entradaValida) {
-                    cout << "Nueva prioridad (1-10): ";
-                    cin >> prioridad;
-                    if (cin.fail()) {
-                        cin.clear();
-                        cin.ignore(1000, '\n');
-                        cout << "Error: Debe ingresar un numero.\n";
-                    } else if (prioridad < 1 || prioridad > 10) {
-                        cin.ignore(1000, '\n');
-                        cout << "Error: La prioridad debe estar entre 1 y 10.\n";
-                    } else {
-                        entradaValida = true;
-                        cin.ignore(1000, '\n');
-                    }
-                }
-                gestor.modificarPrioridad(id, prioridad);
-                break;
+// Productor del benchmark de envios: manda handles[desde], handles[desde
+// + paso], ... en cuanto se da la largada y anota cuanto tardo
+void producirEnvios(PlanificadorCPU* planificador, const HandleProceso* handles, int desde, int paso, int total,
+                    const atomic<bool>* largada, double* segundos) {
+    while (!largada->load(memory_order_acquire)) this_thread::yield();
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (int i = desde; i < total; i += paso) planificador->enviar(handles[i]);
+    *segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
 
-            case 5: // ELIMINAR
-                if (gestor.estaVacia()) {
-                    cout << "Error: No hay procesos para eliminar.\n";
-                    break;
-                }
-                entradaValida = false;
-                while (!entradaValida) {
-                    cout << "ID del proceso a eliminar: ";
-                    cin >> id;
-                    if (cin.fail()) {
-                        cin.clear();
-                        cin.ignore(1000, '\n');
-                        cout << "Error: El ID debe ser un numero.\n";
-                    } else {
-                        entradaValida = true;
-                        cin.ignore(1000, '\n');
-                    }
-                }
-                gestor.eliminar(id);
-                break;
+// La misma entrega con un cerrojo global, para comparar
+struct EnviosConCerrojo {
+    mutex cerrojo;
+    HandleProceso* datos;
+    int cantidad;
+};
 
-            case 6: // CAMBIAR ESTADO
-                if (gestor.estaVacia()) {
-                    cout << "Error: No hay procesos en el sistema.\n";
-                    break;
-                }
-                entradaValida = false;
-                while (!entradaValida) {
-                    cout << "ID del proceso: ";
-                    cin >> id;
-                    if (cin.fail()) {
-                        cin.clear();
-                        cin.ignore(1000, '\n');
-                        cout << "Error: El ID debe ser un numero.\n";
-                    } else {
-                        entradaValida = true;
-                        cin.ignore(1000, '\n');
-                    }
-                }
-                if (gestor.buscar(id) == NULL) {
-                    cout << "Error: No se encontro el proceso.\n";
-                    break;
+void producirConCerrojo(EnviosConCerrojo* envios, const HandleProceso* handles, int desde, int paso, int total,
+                        const atomic<bool>* largada, double* segundos) {
+    while (!largada->load(memory_order_acquire)) this_thread::yield();
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (int i = desde; i < total; i += paso) {
+        lock_guard<mutex> guardia(envios->cerrojo);
+        envios->datos[envios->cantidad++] = handles[i];
+    }
+    *segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+// Entrega de la cola de envios (y de una cola con cerrojo) con 1 a 64
+// hilos productores. Menv/s corre desde la largada hasta que el hilo del
+// planificador encolo todos los procesos en su cola de listos; ns/envio
+// es el tiempo de los productores (el camino de envio) por proceso.
+void benchmarkEnvios() {
+    const int procesos = 1 << 18;
+    const int productores[] = {1, 2, 4, 8, 16, 32, 64};
+    const int corridas = sizeof(productores) / sizeof(productores[0]);
+
+    cout << "\n========== BENCHMARK: envios concurrentes al planificador ==========\n";
+    cout << "Procesos por corrida: " << procesos << " | nucleos del equipo: " << thread::hardware_concurrency() << "\n";
+    cout << "             Sin cerrojo                                         Con cerrojo\n";
+    cout << "Productores  Menv/s   ns/envio  Lotes    Envios/lote  Cortes     Menv/s   ns/envio\n";
+    cout << "=================================================================================\n";
+    BufferNulo nulo;
+    streambuf* original = cout.rdbuf();
+    for (int c = 0; c < corridas; c++) {
+        int p = productores[c];
+        double segundos[2], nsPorEnvio[2];
+        long long lotes = 0, cortes = 0;
+        cout.rdbuf(&nulo);                      // Sin mensajes del gestor y del planificador
+        for (int modo = 0; modo < 2; modo++) {
+            GestorProcesos gestor;
+            PlanificadorCPU planificador(gestor);
+            HandleProceso* handles = new HandleProceso[procesos];
+            unsigned int maximaRanura = 0;
+            unsigned int semilla = 2463534242u;
+            for (int i = 0; i < procesos; i++) {
+                handles[i] = gestor.crear("proceso", (int)(siguienteAleatorio(semilla) % 10) + 1);
+                if (handles[i].indice > maximaRanura) maximaRanura = handles[i].indice;
+            }
+            planificador.habilitarEnvios(maximaRanura + 1);
+            EnviosConCerrojo conCerrojo;
+            conCerrojo.datos = new HandleProceso[procesos];
+            conCerrojo.cantidad = 0;
+
+            atomic<bool> largada(false);
+            thread* hilos = new thread[p];
+            double* segundosProductor = new double[p];
+            for (int k = 0; k < p; k++) {
+                if (modo == 0) {
+                    hilos[k] = thread(producirEnvios, &planificador, handles, k, p, procesos, &largada,
+                                      &segundosProductor[k]);
+                } else {
+                    hilos[k] = thread(producirConCerrojo, &conCerrojo, handles, k, p, procesos, &largada,
+                                      &segundosProductor[k]);
                 }
-                entradaValida = false;
-                while (!entradaValida) {
-                    cout << "Nuevo estado (listo/ejecutando/terminado): ";
-                    cin.getline(estado, 20);
-                    convertirMinusculas(estado);
-                    
-                    if (strlen(estado) == 0) {
-                        cout << "Error: El estado no puede estar vacio.\n";
-                    } else if (!esEstadoValido(estado)) {
-                        cout << "Error: Estado invalido.\n";
-                        cout << "Estados validos: listo, ejecutando, terminado\n";
-                    } else {
-                        entradaValida = true;
+            }
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            largada.store(true, memory_order_release);
+            int encolados = 0, leidos = 0;
+            while (encolados < procesos) {
+                int n = 0;
+                if (modo == 0) {
+                    n = planificador.drenarEnvios();
+                } else {
+                    // El consumidor tambien toma el cerrojo para ver lo nuevo
+                    int hasta;
+                    {
+                        lock_guard<mutex> guardia(conCerrojo.cerrojo);
+                        hasta = conCerrojo.cantidad;
                     }
+                    for (; leidos < hasta; leidos++, n++) planificador.agregarACola(conCerrojo.datos[leidos]);
                 }
-                gestor.cambiarEstado(id, estado);
-                break;
+                encolados += n;
+                if (n == 0) this_thread::yield();
+            }
+            segundos[modo] = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+            nsPorEnvio[modo] = 0;
+            for (int k = 0; k < p; k++) {
+                hilos[k].join();
+                nsPorEnvio[modo] += 1e9 * segundosProductor[k] / procesos;
+            }
+            if (modo == 0) {
+                lotes = planificador.colaEnvios().cantidadLotes();
+                cortes = planificador.colaEnvios().cantidadCortes();
+            }
+            delete[] segundosProductor;
+            delete[] hilos;
+            delete[] conCerrojo.datos;
+            delete[] handles;
+        }
+        cout.rdbuf(original);
 
-            case 7:
-                cout << "Volviendo al menu principal...\n";
-                break;
+        char linea[160];
+        sprintf(linea, "%-12d %-8.2f %-9.1f %-8lld %-12.1f %-10lld %-8.2f %.1f\n", p, procesos / segundos[0] / 1e6,
+                nsPorEnvio[0], lotes, (lotes > 0) ? (double)procesos / lotes : 0.0, cortes,
+                procesos / segundos[1] / 1e6, nsPorEnvio[1]);
+        cout << linea;
+    }
+    cout << "=================================================================================\n";
+    cout << "(Menv/s incluye encolar en la cola de listos; el envio sin cerrojo es un exchange\n"
+         << " y un store por proceso, sin reservar memoria)\n";
+    if (thread::hardware_concurrency() < 8) {
+        cout << "(con menos nucleos que productores los hilos se turnan y el cerrojo casi no se disputa)\n";
+    }
+}
 
-            default:
-                cout << "Opcion invalida.\n";
+// Decisiones hasta que sale un proceso de prioridad 1 encolado detras de
+// n procesos de prioridad 10 que vuelven a la cola apenas se ejecutan
+// (carga sostenida de alta prioridad). -1 si no salio en el limite.
+template <class Cola>
+long long esperaBajoCargaAlta(int n, long long limite) {
+    Cola cola;
+    for (int i = 0; i < n; i++) {
+        HandleProceso h = {(unsigned int)i, 1};
+        cola.insertar(h, i + 1, 10);
+    }
+    HandleProceso bajo = {(unsigned int)n, 1};
+    cola.insertar(bajo, n + 1, 1);
+    typename Cola::Entrada e;
+    for (long long d = 1; d <= limite; d++) {
+        if (!cola.extraer(e)) break;
+        if (e.proceso == bajo) return d;
+        cola.insertar(e.proceso, e.id, e.prioridad);
+    }
+    return -1;
+}
+
+// Inanicion con prioridad estricta y con envejecimiento: cuanto espera
+// el de prioridad 1 y cuanto cuesta cada decision con n en cola
+void benchmarkEnvejecimiento() {
+    const int tamanios[] = {1000, 100000, 1000000};
+    const int cantidadTamanios = sizeof(tamanios) / sizeof(tamanios[0]);
+
+    cout << "\n========== BENCHMARK: inanicion y envejecimiento ==========\n";
+    cout << "Prioridad 1 detras de n procesos de prioridad 10 que vuelven a la cola"
+         << " (un nivel cada " << LLEGADAS_POR_NIVEL << " llegadas)\n";
+    cout << "En cola      Cola                          Espera prio 1 (decisiones)  ns/decision\n";
+    cout << "=================================================================================\n";
+    for (int t = 0; t < cantidadTamanios; t++) {
+        int n = tamanios[t];
+        long long limite = 10LL * n + 100000;
+        long long esperas[2] = {esperaBajoCargaAlta<MonticuloIndexado<4> >(n, limite),
+                                esperaBajoCargaAlta<ColaEnvejecimiento>(n, limite)};
+        double ns[2] = {nsPorDecision<MonticuloIndexado<4> >(n, 2000000),
+                        nsPorDecision<ColaEnvejecimiento>(n, 2000000)};
+        const char* nombres[2] = {MonticuloIndexado<4>::nombre(), ColaEnvejecimiento::nombre()};
+        for (int i = 0; i < 2; i++) {
+            char espera[40];
+            if (esperas[i] < 0) sprintf(espera, "nunca (> %lld)", limite);
+            else sprintf(espera, "%lld", esperas[i]);
+            char linea[160];
+            sprintf(linea, "%-12d %-29s %-27s %.2f\n", n, nombres[i], espera, ns[i]);
+            cout << linea;
         }
-    } while(opcion != 7);
+    }
+    cout << "=================================================================================\n";
+}
+
+// Un millon de procesos por el simulador de eventos con cada cola de listos
+void benchmarkSimulacion() {
+    const int procesos = 1000000;
+    ProcesoSimulado* carga = new ProcesoSimulado[procesos];
+    ResultadoSimulado* resultados = new ResultadoSimulado[procesos];
+    generarCargaSimulada(carga, procesos, 1, 0.9, 2463534242u);
+
+    cout << "\n========== BENCHMARK: simulacion por eventos discretos ==========\n";
+    cout << "Procesos: " << procesos << " | CPUs: 1 | Carga: 90%\n";
+    cout << "Cola de listos               Eventos     Segundos  M eventos/s  Espera media us  Respuesta media us\n";
+    cout << "=====================================================================================================\n";
+    EquidadSimulacion equidad[3];
+    const char* nombres[3] = {MonticuloIndexado<4>::nombre(), ColaNiveles::nombre(), ColaCFS::nombre()};
+    for (int i = 0; i < 3; i++) {
+        EstadisticasSimulacion e;
+        const char* nombre = nombres[i];
+        if (i == 0) {
+            SimuladorEventos<MonticuloIndexado<4> > simulador(1);
+            e = simulador.simular(carga, procesos, resultados);
+            equidad[i] = medirEquidad<MonticuloIndexado<4> >(1000000);
+        } else if (i == 1) {
+            SimuladorEventos<ColaNiveles> simulador(1);
+            e = simulador.simular(carga, procesos, resultados);
+            equidad[i] = medirEquidad<ColaNiveles>(1000000);
+        } else {
+            SimuladorEventos<ColaCFS> simulador(1);
+            e = simulador.simular(carga, procesos, resultados);
+            equidad[i] = medirEquidad<ColaCFS>(1000000);
+        }
+        char linea[160];
+        sprintf(linea, "%-28s %-11lld %-9.3f %-12.2f %-16.0f %.0f\n", nombre, e.eventos, e.segundos,
+                e.eventos / e.segundos / 1e6, e.esperaMedia, e.respuestaMedia);
+        cout << linea;
+    }
+    cout << "=====================================================================================================\n";
+
+    // Reparto de la CPU entre 10 procesos de CPU durante 1 s simulado
+    cout << "\nPrio  Peso   Parte justa  Monticulo  Multinivel  CFS\n";
+    cout << "====================================================\n";
+    char linea[160];
+    for (int p = 0; p < 10; p++) {
+        sprintf(linea, "%-5d %-6d %5.1f%%       %5.1f%%     %5.1f%%      %5.1f%%\n", p + 1, pesoDePrioridad(p + 1),
+                100.0 * equidad[0].justa[p], 100.0 * equidad[0].parte[p], 100.0 * equidad[1].parte[p],
+                100.0 * equidad[2].parte[p]);
+        cout << linea;
+    }
+    cout << "====================================================\n";
+    for (int i = 0; i < 3; i++) {
+        sprintf(linea, "%-28s desviacion media %6.1f%% | maxima %6.1f%% | Jain %.3f\n", nombres[i],
+                100.0 * equidad[i].desviacionMedia, 100.0 * equidad[i].desviacionMaxima, equidad[i].indiceJain);
+        cout << linea;
+    }
+    delete[] resultados;
+    delete[] carga;
+}
+
+// --simulacion [procesos] [cpus]: carga sintetica al 90% de las CPUs
+template <class ColaListos>
+int ejecutarSimulacion(int procesos, int cpus, long long quantumUs) {
+    ProcesoSimulado* carga = new ProcesoSimulado[procesos];
+    ResultadoSimulado* resultados = new ResultadoSimulado[procesos];
+    generarCargaSimulada(carga, procesos, cpus, 0.9, 2463534242u);
+    SimuladorEventos<ColaListos> simulador(cpus, quantumUs);
+    EstadisticasSimulacion e = simulador.simular(carga, procesos, resultados);
+    cout << "\n========== SIMULACION POR EVENTOS DISCRETOS (" << ColaListos::nombre() << ") ==========";
+    mostrarSimulacion(carga, resultados, e, 10);
+    mostrarEquidad(medirEquidad<ColaListos>(1000000, quantumUs));
+    delete[] resultados;
+    delete[] carga;
+    return 0;
+}
+
+// Una fila de la comparacion de politicas: la misma carga simulada, el
+// costo aislado de una decision con 1000 procesos en cola y el reparto
+// de la CPU entre 10 procesos de CPU
+template <class ColaListos>
+void filaPolitica(const ProcesoSimulado* carga, int procesos, ResultadoSimulado* resultados, int cpus,
+                  long long quantumUs) {
+    SimuladorEventos<ColaListos> simulador(cpus, quantumUs);
+    EstadisticasSimulacion e = simulador.simular(carga, procesos, resultados);
+    double ns = nsPorDecision<ColaListos>(1000, 1000000);
+    EquidadSimulacion q = medirEquidad<ColaListos>(1000000, quantumUs);
+    char linea[200];
+    sprintf(linea, "%-28s %-10.1f %-11.0f %-11.0f %-11.0f %-10lld %-10lld %-9.1f %.3f\n", ColaListos::nombre(),
+            e.rendimiento, e.esperaMedia, e.retornoMedio, e.respuestaMedia, e.desalojos, e.decisiones, ns,
+            q.indiceJain);
+    cout << linea;
+}
+
+// --comparar-politicas [procesos] [cpus]: todas las politicas sobre la
+// misma carga (90% de las CPUs). Cada politica es una cola de listos
+// distinta, elegida en tiempo de compilacion: el simulador se instancia
+// una vez por politica y no hay llamadas virtuales por decision.
+void compararPoliticas(int procesos, int cpus, long long quantumUs) {
+    ProcesoSimulado* carga = new ProcesoSimulado[procesos];
+    ResultadoSimulado* resultados = new ResultadoSimulado[procesos];
+    generarCargaSimulada(carga, procesos, cpus, 0.9, 2463534242u);
+
+    cout << "\n========== COMPARACION DE POLITICAS DE PLANIFICACION ==========\n";
+    cout << "Procesos: " << procesos << " | CPUs: " << cpus << " | Carga: 90% | Quantum: " << quantumUs << " us\n";
+    cout << "Politica                     Proc/s     Espera us   Retorno us  Respuesta   Desalojos  Decisiones ns/dec    Jain\n";
+    cout << "=================================================================================================================\n";
+    filaPolitica<ColaFCFS>(carga, procesos, resultados, cpus, quantumUs);
+    filaPolitica<ColaSJF>(carga, procesos, resultados, cpus, quantumUs);
+    filaPolitica<ColaSRTF>(carga, procesos, resultados, cpus, quantumUs);
+    filaPolitica<ColaRoundRobin>(carga, procesos, resultados, cpus, quantumUs);
+    filaPolitica<MonticuloIndexado<4> >(carga, procesos, resultados, cpus, quantumUs);
+    filaPolitica<ColaEnvejecimiento>(carga, procesos, resultados, cpus, quantumUs);
+    filaPolitica<ColaNiveles>(carga, procesos, resultados, cpus, quantumUs);
+    filaPolitica<ColaCFS>(carga, procesos, resultados, cpus, quantumUs);
+    filaPolitica<ColaLoteria>(carga, procesos, resultados, cpus, quantumUs);
+    cout << "=================================================================================================================\n";
+    cout << "(ns/dec: desencolar + encolar con 1000 procesos en cola; Jain: reparto entre 10 procesos\n"
+         << " de CPU respecto del peso de su prioridad, 1 = proporcional)\n";
+    delete[] resultados;
+    delete[] carga;
+}
+
+// --paginacion [marcos] [archivo]: sin archivo se usa una traza sintetica
+int ejecutarPaginacion(unsigned int marcos, const char* archivoTraza) {
+    const unsigned int ENTRADAS_TLB = 64;
+    ReferenciaPagina* traza;
+    unsigned int* paginasPorProceso;
+    unsigned int procesos;
+    long long n;
+
+    if (archivoTraza == NULL) {
+        n = 50000000;
+        procesos = 8;
+        traza = new ReferenciaPagina[n];
+        generarTrazaPaginas(traza, n, procesos, 4096, 2463534242u);
+        paginasPorProceso = new unsigned int[procesos];
+        for (unsigned int p = 0; p < procesos; p++) paginasPorProceso[p] = 4096;
+    } else {
+        FILE* archivo = (strcmp(archivoTraza, "-") == 0) ? stdin : fopen(archivoTraza, "rb");
+        if (archivo == NULL) {
+            cout << "Error: No se pudo abrir el archivo " << archivoTraza << endl;
+            return 1;
+        }
+        n = leerTrazaPaginas(archivo, traza, paginasPorProceso, procesos);
+        if (archivo != stdin) fclose(archivo);
+        if (n < 0) return 1;
+        if (n == 0) {
+            cout << "La traza no tiene referencias.\n";
+            delete[] traza;
+            delete[] paginasPorProceso;
+            return 1;
+        }
+    }
+
+    compararReemplazos(traza, n, paginasPorProceso, procesos, marcos, ENTRADAS_TLB);
+    delete[] traza;
+    delete[] paginasPorProceso;
+    return 0;
 }
 
 // ============================================
-// MAIN
+// MICROBENCHMARKS (SALIDA CSV)
+// Se ejecutan con: ./programa --microbenchmarks [n maximo]
+// Cada fila mide una operacion con la estructura precargada con n
+// elementos. Se usan los nucleos sin mensajes de cada operacion
+// (crear = insertar, quitar = eliminar, reservar = asignarMemoria,
+// quitarTodosDe = liberarPorID, quitarTope = liberarMemoria,
+// agregarACola = encolar, ejecutarSiguiente = ejecutarProceso);
+// mostrar se mide completo, escribiendo a un flujo descartado.
 // ============================================
-int main() {
+
+// Cuenta las reservas de memoria dinamica hechas por el hilo actual
+thread_local unsigned long long reservasDinamicas = 0;
+
+void* operator new(size_t tamanio) {
+    reservasDinamicas++;
+    void* p = malloc(tamanio == 0 ? 1 : tamanio);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}
+
+// La variante sin excepciones (habilitarIntercambio) debe pasar por el
+// mismo malloc, porque el delete reemplazado libera con free
+void* operator new(size_t tamanio, const nothrow_t&) noexcept {
+    reservasDinamicas++;
+    return malloc(tamanio == 0 ? 1 : tamanio);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, const nothrow_t&) noexcept {
+    free(p);
+}
+
+// Toma tiempo y reservas de una medicion y escribe la fila CSV.
+// Recuerda la ultima medicion de cada operacion para calcular el
+// exponente de escalamiento: log(ns2/ns1) / log(n2/n1)
+// (~0 = costo constante, ~1 = lineal en n).
+class MedidorCSV {
+private:
+    static const int MAX_OPERACIONES = 32;
+
+    ostream& salida;
+    chrono::steady_clock::time_point inicio;
+    unsigned long long reservasInicio;
+
+    const char* modulos[MAX_OPERACIONES];
+    const char* nombres[MAX_OPERACIONES];
+    long long nAnterior[MAX_OPERACIONES];
+    double nsAnterior[MAX_OPERACIONES];
+    int cantidadOperaciones;
+
+public:
+    MedidorCSV(ostream& _salida) : salida(_salida) {
+        cantidadOperaciones = 0;
+        reservasInicio = 0;
+        salida << "modulo,operacion,n,ops,ns_por_op,reservas_por_op,exponente_escalamiento\n";
+    }
+
+    void iniciar() {
+        reservasInicio = reservasDinamicas;
+        inicio = chrono::steady_clock::now();
+    }
+
+    void terminar(const char* modulo, const char* operacion, long long n, long long ops) {
+        chrono::steady_clock::time_point fin = chrono::steady_clock::now();
+        unsigned long long reservas = reservasDinamicas - reservasInicio;
+        if (ops <= 0) ops = 1;
+        double ns = chrono::duration<double, nano>(fin - inicio).count() / ops;
+
+        int k = 0;
+        while (k < cantidadOperaciones &&
+               (strcmp(modulos[k], modulo) != 0 || strcmp(nombres[k], operacion) != 0)) k++;
+        char exponente[32] = "";
+        if (k == cantidadOperaciones && k < MAX_OPERACIONES) {
+            modulos[k] = modulo;
+            nombres[k] = operacion;
+            cantidadOperaciones++;
+        } else if (k < cantidadOperaciones && nAnterior[k] < n && nsAnterior[k] > 0 && ns > 0) {
+            sprintf(exponente, "%.3f", log(ns / nsAnterior[k]) / log((double)n / nAnterior[k]));
+        }
+        if (k < MAX_OPERACIONES) {
+            nAnterior[k] = n;
+            nsAnterior[k] = ns;
+        }
+
+        char fila[200];
+        sprintf(fila, "%s,%s,%lld,%lld,%.2f,%.3f,%s", modulo, operacion, n, ops, ns,
+                (double)reservas / ops, exponente);
+        salida << fila << "\n" << flush;
+    }
+};
+
+// Cantidad de repeticiones: muchas para operaciones baratas y
+// pocas (acotadas por un presupuesto) para las que recorren n elementos
+long long repeticionesPara(long long n, bool lineal) {
+    const long long MAX_REPETICIONES = 1000000;
+    if (!lineal) return MAX_REPETICIONES;
+    long long r = 50000000LL / (n > 0 ? n : 1);
+    if (r < 1) r = 1;
+    return (r > MAX_REPETICIONES) ? MAX_REPETICIONES : r;
+}
+
+void microbenchmarkProcesos(MedidorCSV& medidor, long long n) {
+    GestorProcesos gestor;
+    for (long long i = 0; i < n; i++) gestor.crear("proceso", (int)(i % 10) + 1);
+    unsigned int semilla = 2463534242u;
+
+    // buscar: IDs al azar entre los existentes
+    long long ops = repeticionesPara(n, false);
+    long long encontrados = 0;
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) {
+        int id = (int)(siguienteAleatorio(semilla) % (unsigned int)n) + 1;
+        if (gestor.buscar(id).existe()) encontrados++;
+    }
+    medidor.terminar("procesos", "buscar", n, ops);
+    if (encontrados != ops) cerr << "[ERROR] buscar perdio procesos\n";
+
+    // mostrar: ordena y formatea los n procesos
+    ops = repeticionesPara(n * 20, true);
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) gestor.mostrar();
+    medidor.terminar("procesos", "mostrar", n, ops);
+
+    // contar_por_estado: recorre solo la columna de estados
+    ops = repeticionesPara(n, true);
+    unsigned int porEstado[CANTIDAD_ESTADOS];
+    unsigned long long contados = 0;
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) {
+        gestor.contarPorEstado(porEstado);
+        contados += porEstado[ESTADO_NUEVO];
+    }
+    medidor.terminar("procesos", "contar_por_estado", n, ops);
+    if (contados != (unsigned long long)(n * ops)) cerr << "[ERROR] contar_por_estado no coincide\n";
+
+    // eliminar: quita procesos al azar (a lo sumo la mitad)
+    ops = n / 2;
+    if (ops > 1000000) ops = 1000000;
+    if (ops < 1) ops = 1;
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) {
+        gestor.quitar((int)(siguienteAleatorio(semilla) % (unsigned int)n) + 1);
+    }
+    medidor.terminar("procesos", "eliminar", n, ops);
+
+    // insertar: agrega mas procesos sobre la tabla ya cargada
+    ops = repeticionesPara(n, false);
+    if (ops > n) ops = (n < 1000) ? 1000 : n;
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) gestor.crear("proceso", (int)(i % 10) + 1);
+    medidor.terminar("procesos", "insertar", n, ops);
+}
+
+void microbenchmarkMemoria(MedidorCSV& medidor, long long n) {
+    const unsigned long long OBJETO = 64;   // Pedido chico: lo sirve un slab
+    GestorProcesos gestor;
+    GestorMemoria memoria(gestor);
+    HandleProceso* handles = new HandleProceso[n + 1];
+    for (long long i = 0; i < n; i++) {
+        handles[i] = gestor.crear("proceso", 5);
+        memoria.reservar(handles[i], OBJETO);
+    }
+    handles[n] = gestor.crear("extra", 5);
+    unsigned int semilla = 2463534242u;
+
+    // asignarMemoria + liberarMemoria: push y pop sobre una pila con n bloques
+    long long ops = repeticionesPara(n, false);
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) {
+        memoria.reservar(handles[n], GestorMemoria::TAMANIO_PAGINA);
+        memoria.quitarTope();
+    }
+    medidor.terminar("memoria", "asignar+liberarTope", n, ops);
+
+    // Lo mismo con un objeto chico (slab, sin pasar por el buddy)
+    ops = repeticionesPara(n, false);
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) {
+        memoria.reservar(handles[n], OBJETO);
+        memoria.quitarTope();
+    }
+    medidor.terminar("memoria", "asignarPequenio+liberarTope", n, ops);
+
+    // liberarPorID: libera los bloques de un proceso (indice por ID) y lo vuelve a asignar
+    ops = repeticionesPara(n, false);
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) {
+        long long k = siguienteAleatorio(semilla) % (unsigned int)n;
+        memoria.quitarTodosDe(gestor.resolver(handles[k]).id());
+        memoria.reservar(handles[k], OBJETO);
+    }
+    medidor.terminar("memoria", "liberarPorID+asignar", n, ops);
+
+    // memoriaDeProceso: total de un proceso sin recorrer la pila
+    ops = repeticionesPara(n, false);
+    unsigned long long totalConsultado = 0;
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) {
+        long long k = siguienteAleatorio(semilla) % (unsigned int)n;
+        totalConsultado += memoria.memoriaDeProceso(gestor.resolver(handles[k]).id());
+    }
+    medidor.terminar("memoria", "memoriaDeProceso", n, ops);
+    if (totalConsultado != ops * OBJETO) cerr << "[ERROR] memoriaDeProceso no coincide\n";
+
+    // liberarMemoria: vacia la pila completa
+    medidor.iniciar();
+    for (long long i = 0; i < n; i++) memoria.quitarTope();
+    medidor.terminar("memoria", "liberarTope", n, n);
+
+    delete[] handles;
+}
+
+template <class Planificador>
+void microbenchmarkPlanificador(MedidorCSV& medidor, long long n, const char* modulo) {
     GestorProcesos gestor;
-    GestorMemoria memoria;
-    PlanificadorCPU planificador;
+    Planificador planificador(gestor);
+    long long ops = repeticionesPara(n, false);
+    if (ops > n) ops = (n < 1000) ? 1000 : n;
+
+    HandleProceso* handles = new HandleProceso[n + ops];
+    unsigned int semilla = 2463534242u;
+    for (long long i = 0; i < n + ops; i++) {
+        handles[i] = gestor.crear("proceso", (int)(siguienteAleatorio(semilla) % 10) + 1);
+    }
+    for (long long i = 0; i < n; i++) planificador.agregarACola(handles[i]);
+
+    // encolar: agrega ops procesos sobre una cola con n
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) planificador.agregarACola(handles[n + i]);
+    medidor.terminar(modulo, "encolar", n, ops);
+
+    // ejecutarProceso: desencola ops procesos
+    medidor.iniciar();
+    for (long long i = 0; i < ops; i++) planificador.ejecutarSiguiente();
+    medidor.terminar(modulo, "ejecutar", n, ops);
+
+    delete[] handles;
+}
+
+// Recorre los tamanios 10, 100, ..., nMaximo y escribe CSV en cout
+void ejecutarMicrobenchmarks(long long nMaximo) {
+    ostream csv(cout.rdbuf());
+    BufferNulo nulo;
+    streambuf* original = cout.rdbuf(&nulo);    // Silenciar mensajes de los modulos
+
+    MedidorCSV medidor(csv);
+    for (long long n = 10; n <= nMaximo; n *= 10) {
+        microbenchmarkProcesos(medidor, n);
+        microbenchmarkPlanificador<PlanificadorCPUEstricto>(medidor, n, "planificador-monticulo");
+        microbenchmarkPlanificador<PlanificadorCPU>(medidor, n, "planificador-envejecimiento");
+        microbenchmarkPlanificador<PlanificadorCPUNiveles>(medidor, n, "planificador-niveles");
+        microbenchmarkPlanificador<PlanificadorCPUCFS>(medidor, n, "planificador-cfs");
+        // Con objetos de 64 B entran 32M bloques en 2 GB; se corta antes
+        // por el tiempo de armar la pila
+        if (n <= 1000000) microbenchmarkMemoria(medidor, n);
+    }
+
+    cout.rdbuf(original);
+}
+
+// ============================================
+// MENÚ PRINCIPAL
+// El tipo de planificador define la estructura de su cola de listos
+// ============================================
+template <class Planificador>
+void menuPrincipal(GestorProcesos& gestor, const char* archivoIntercambio, unsigned long long capacidadMemoria) {
+    GestorMemoria memoria(gestor, capacidadMemoria);
+    Planificador planificador(gestor);
     int opcion;
 
+    planificador.fijarResidencia(&memoria);     // Residencia y ticks de la compactacion
+    if (archivoIntercambio != NULL) {
+        if (memoria.habilitarIntercambio(archivoIntercambio)) {
+            cout << "[INFO] Area de intercambio en " << archivoIntercambio << "\n";
+        } else {
+            cout << "[ERROR] No se pudo crear el area de intercambio " << archivoIntercambio << "\n";
+        }
+    }
+
     do {
         cout << "\n========================================\n";
         cout << "   SISTEMA DE GESTION DE PROCESOS\n";
@@ -1271,10 +9555,10 @@ int main() {
                 menuGestorProcesos(gestor);
                 break;
             case 2:
-                memoria.menuMemoria(gestor);
+                memoria.menuMemoria();
                 break;
             case 3:
-                planificador.menuPlanificador(gestor);
+                planificador.menuPlanificador();
                 break;
             case 4:
                 cout << "\nGracias por usar el sistema!\n";
@@ -1283,7 +9567,226 @@ int main() {
                 cout << "Opcion invalida.\n";
         }
     } while(opcion != 4);
+}
+
+// ============================================
+// MAIN
+// La politica de planificacion es la cola de listos del planificador y
+// del simulador; se elige una vez y el resto se instancia para ella
+// ============================================
+enum PoliticaPlanificacion {
+    POLITICA_ENVEJECIMIENTO,
+    POLITICA_PRIORIDAD,
+    POLITICA_NIVELES,
+    POLITICA_CFS,
+    POLITICA_FCFS,
+    POLITICA_SJF,
+    POLITICA_SRTF,
+    POLITICA_RR,
+    POLITICA_LOTERIA
+};
+
+bool leerPolitica(const char* texto, PoliticaPlanificacion& politica) {
+    static const struct {
+        const char* nombre;
+        PoliticaPlanificacion politica;
+    } politicas[] = {
+        {"envejecimiento", POLITICA_ENVEJECIMIENTO},
+        {"prioridad", POLITICA_PRIORIDAD}, {"niveles", POLITICA_NIVELES}, {"cfs", POLITICA_CFS},
+        {"fcfs", POLITICA_FCFS},           {"sjf", POLITICA_SJF},         {"srtf", POLITICA_SRTF},
+        {"rr", POLITICA_RR},               {"loteria", POLITICA_LOTERIA},
+    };
+    for (size_t i = 0; i < sizeof(politicas) / sizeof(politicas[0]); i++) {
+        if (strcmp(texto, politicas[i].nombre) == 0) {
+            politica = politicas[i].politica;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct OpcionesEjecucion {
+    ModoIDs modoIDs;
+    int procesosSimulados;              // 0 = sin --simulacion
+    int cpusSimuladas;
+    long long quantumUs;
+    bool modoLotes;
+    const char* archivoLotes;           // NULL = entrada estandar
+    const char* archivoIntercambio;     // NULL = sin area de intercambio
+    unsigned long long capacidadMemoria;
+};
+
+template <class ColaListos>
+int ejecutarConPolitica(const OpcionesEjecucion& o) {
+    typedef PlanificadorCPUGenerico<ColaListos> Planificador;
+    if (o.procesosSimulados > 0) return ejecutarSimulacion<ColaListos>(o.procesosSimulados, o.cpusSimuladas, o.quantumUs);
+
+    GestorProcesos gestor(o.modoIDs);
+    if (o.modoLotes) {
+        FILE* archivo = stdin;
+        if (o.archivoLotes != NULL) {
+            archivo = fopen(o.archivoLotes, "rb");
+            if (archivo == NULL) {
+                cout << "Error: No se pudo abrir el archivo " << o.archivoLotes << endl;
+                return 1;
+            }
+        }
+        long long errores = ejecutarLotes<Planificador>(archivo, gestor, o.archivoIntercambio, o.capacidadMemoria);
+        if (archivo != stdin) fclose(archivo);
+        return (errores == 0) ? 0 : 2;
+    }
 
+    menuPrincipal<Planificador>(gestor, o.archivoIntercambio, o.capacidadMemoria);
     return 0;
 }
 
+int main(int argc, char* argv[]) {
+    OpcionesEjecucion o;
+    o.modoIDs = IDS_MONOTONOS;
+    o.procesosSimulados = 0;
+    o.cpusSimuladas = 1;
+    o.quantumUs = QUANTUM_SIMULADO_US;
+    o.modoLotes = false;
+    o.archivoLotes = NULL;
+    o.archivoIntercambio = NULL;
+    o.capacidadMemoria = 2048 * BYTES_MB;
+    PoliticaPlanificacion politica = POLITICA_ENVEJECIMIENTO;
+    bool politicaElegida = false;
+    int procesosComparados = 0;         // 0 = sin --comparar-politicas
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--benchmark") == 0) {
+            benchmarkBusquedaProcesos();
+            benchmarkRotacionHandles();
+            benchmarkRecorridoColumnar();
+            benchmarkColaListos();
+            benchmarkEnvejecimiento();
+            benchmarkPoliticasMemoria();
+            benchmarkPaginacion();
+            benchmarkIntercambio();
+            benchmarkCompactacion();
+            benchmarkMultinucleo();
+            benchmarkEnvios();
+            benchmarkGestorConcurrente();
+            benchmarkSimulacion();
+            compararPoliticas(100000, 1, QUANTUM_SIMULADO_US);
+            return 0;
+        } else if (strcmp(argv[i], "--microbenchmarks") == 0) {
+            long long nMaximo = 10000000;
+            int valor;
+            if (i + 1 < argc && leerEntero(argv[i + 1], valor) && valor >= 10) nMaximo = valor;
+            ejecutarMicrobenchmarks(nMaximo);
+            return 0;
+        } else if (strcmp(argv[i], "--paginacion") == 0) {
+            int marcos = 256;
+            if (i + 1 < argc && leerEntero(argv[i + 1], marcos)) i++;
+            if (marcos < 1) {
+                cout << "Error: La cantidad de marcos debe ser positiva.\n";
+                return 1;
+            }
+            return ejecutarPaginacion((unsigned int)marcos, (i + 1 < argc) ? argv[i + 1] : NULL);
+        } else if (strcmp(argv[i], "--simulacion") == 0) {
+            // Se ejecuta al final, con la cola de listos elegida
+            o.procesosSimulados = 1000000;
+            if (i + 1 < argc && leerEntero(argv[i + 1], o.procesosSimulados)) i++;
+            if (i + 1 < argc && leerEntero(argv[i + 1], o.cpusSimuladas)) i++;
+            if (o.procesosSimulados < 1 || o.cpusSimuladas < 1 || o.cpusSimuladas > 1024) {
+                cout << "Error: --simulacion necesita procesos y CPUs positivos (hasta 1024 CPUs).\n";
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--ids-reciclados") == 0) {
+            o.modoIDs = IDS_RECICLADOS;     // Reutilizar IDs de procesos eliminados
+        } else if (strcmp(argv[i], "--politica") == 0 || strcmp(argv[i], "--cola-niveles") == 0
+                   || strcmp(argv[i], "--cfs") == 0) {
+            // --cola-niveles y --cfs son atajos de --politica niveles|cfs
+            PoliticaPlanificacion elegida = POLITICA_ENVEJECIMIENTO;
+            if (strcmp(argv[i], "--cola-niveles") == 0) {
+                elegida = POLITICA_NIVELES;
+            } else if (strcmp(argv[i], "--cfs") == 0) {
+                elegida = POLITICA_CFS;
+            } else if (i + 1 >= argc || !leerPolitica(argv[++i], elegida)) {
+                cout << "Error: --politica necesita envejecimiento, prioridad, fcfs, sjf, srtf, rr, loteria, niveles o cfs.\n";
+                return 1;
+            }
+            if (politicaElegida && elegida != politica) {
+                cout << "Error: Solo se puede elegir una politica de planificacion.\n";
+                return 1;
+            }
+            politica = elegida;
+            politicaElegida = true;
+        } else if (strcmp(argv[i], "--quantum") == 0) {
+            int quantum;
+            if (i + 1 >= argc || !leerEntero(argv[i + 1], quantum) || quantum < 1) {
+                cout << "Error: --quantum necesita los microsegundos (positivo).\n";
+                return 1;
+            }
+            o.quantumUs = quantum;
+            i++;
+        } else if (strcmp(argv[i], "--comparar-politicas") == 0) {
+            // Tambien al final, con el quantum elegido
+            procesosComparados = 100000;
+            int cpus = 1;
+            if (i + 1 < argc && leerEntero(argv[i + 1], procesosComparados)) i++;
+            if (i + 1 < argc && leerEntero(argv[i + 1], cpus)) i++;
+            if (procesosComparados < 1 || cpus < 1 || cpus > 1024) {
+                cout << "Error: --comparar-politicas necesita procesos y CPUs positivos (hasta 1024 CPUs).\n";
+                return 1;
+            }
+            o.cpusSimuladas = cpus;
+        } else if (strcmp(argv[i], "--intercambio") == 0) {
+            if (i + 1 >= argc) {
+                cout << "Error: --intercambio necesita la ruta del archivo.\n";
+                return 1;
+            }
+            o.archivoIntercambio = argv[++i];   // Swap en archivo para la memoria
+        } else if (strcmp(argv[i], "--memoria") == 0) {
+            // Capacidad de la memoria simulada (sin sufijo: MB)
+            if (i + 1 >= argc || !leerTamanio(argv[i + 1], o.capacidadMemoria, BYTES_MB)
+                || o.capacidadMemoria < AsignadorSlab<GestorMemoria>::TAMANIO_SLAB
+                || o.capacidadMemoria > 64 * BYTES_GB) {
+                cout << "Error: --memoria necesita un tamanio entre 64 KB y 64 GB (p. ej. 4G, 512MB).\n";
+                return 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--lotes") == 0) {
+            o.modoLotes = true;             // Guion de comandos sin menus
+            if (i + 1 < argc && argv[i + 1][0] != '-') o.archivoLotes = argv[++i];
+            else if (i + 1 < argc && strcmp(argv[i + 1], "-") == 0) i++;
+        } else {
+            cout << "Opcion desconocida: " << argv[i] << endl;
+            cout << "Uso: " << argv[0] << " [--ids-reciclados] [--politica envejecimiento|prioridad|fcfs|sjf|srtf|rr|loteria|niveles|cfs]"
+                 << " [--cola-niveles | --cfs] [--quantum us] [--intercambio archivo] [--memoria tamanio]"
+                 << " [--lotes [archivo]] [--benchmark] [--microbenchmarks [n]]"
+                 << " [--paginacion [marcos] [traza]] [--simulacion [procesos] [cpus]]"
+                 << " [--comparar-politicas [procesos] [cpus]]\n";
+            return 1;
+        }
+    }
+
+    if (procesosComparados > 0) {
+        compararPoliticas(procesosComparados, o.cpusSimuladas, o.quantumUs);
+        return 0;
+    }
+
+    switch (politica) {
+        case POLITICA_PRIORIDAD:
+            return ejecutarConPolitica<MonticuloIndexado<4> >(o);
+        case POLITICA_NIVELES:
+            return ejecutarConPolitica<ColaNiveles>(o);
+        case POLITICA_CFS:
+            return ejecutarConPolitica<ColaCFS>(o);
+        case POLITICA_FCFS:
+            return ejecutarConPolitica<ColaFCFS>(o);
+        case POLITICA_SJF:
+            return ejecutarConPolitica<ColaSJF>(o);
+        case POLITICA_SRTF:
+            return ejecutarConPolitica<ColaSRTF>(o);
+        case POLITICA_RR:
+            return ejecutarConPolitica<ColaRoundRobin>(o);
+        case POLITICA_LOTERIA:
+            return ejecutarConPolitica<ColaLoteria>(o);
+        default:
+            return ejecutarConPolitica<ColaEnvejecimiento>(o);
+    }
+}
+